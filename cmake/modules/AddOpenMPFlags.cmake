@@ -0,0 +1,23 @@
+#
+# Module providing convenience methods for compile binaries with OpenMP support.
+#
+# Provides the following functions:
+#
+# add_dune_openmp_flags(target1 target2 ...)
+#
+# adds OpenMP flags to the targets for compilation and linking
+#
+function(add_dune_openmp_flags)
+  if(OPENMP_FOUND)
+    foreach(_target ${ARGN})
+      get_target_property(_props ${_target} COMPILE_FLAGS)
+      string(REPLACE "_props-NOTFOUND" "" _props "${_props}")
+      set_target_properties(${_target} PROPERTIES COMPILE_FLAGS
+        "${_props} ${OpenMP_CXX_FLAGS}")
+      get_target_property(_props ${_target} LINK_FLAGS)
+      string(REPLACE "_props-NOTFOUND" "" _props "${_props}")
+      set_target_properties(${_target} PROPERTIES LINK_FLAGS
+        "${_props} ${OpenMP_CXX_FLAGS}")
+    endforeach()
+  endif(OPENMP_FOUND)
+endfunction(add_dune_openmp_flags)
@@ -7,3 +7,10 @@ find_package(SuperLU)
 include(AddSuperLUFlags)
 find_package(UMFPack)
 include(AddUMFPackFlags)
+find_package(OpenMP)
+include(AddOpenMPFlags)
+# thread the kernels of all targets, otherwise only the OpenMP tests use it
+option(DUNE_ISTL_USE_OPENMP "Compile all targets with OpenMP support" OFF)
+if(DUNE_ISTL_USE_OPENMP AND OPENMP_FOUND)
+  set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} ${OpenMP_CXX_FLAGS}")
+endif()
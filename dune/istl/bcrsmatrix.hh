@@ -1588,6 +1588,35 @@ namespace Dune {
       }
     }
 
+    /*! \brief \f$ y_k = A x_k \f$ for several vectors at once.
+
+       Each matrix block is loaded once and applied to all vectors, so
+       the matrix is read only once per call instead of once per vector.
+     */
+    template<class X, class Y>
+    void mvMultiple (const std::vector<const X*>& x, const std::vector<Y*>& y) const
+    {
+      typedef typename std::vector<const X*>::size_type index_type;
+      const index_type k = x.size();
+#ifdef DUNE_ISTL_WITH_CHECKING
+      if (ready != built)
+        DUNE_THROW(BCRSMatrixError,"You can only call arithmetic operations on fully built BCRSMatrix instances");
+      if (y.size()!=k) DUNE_THROW(BCRSMatrixError,"number of vectors does not match");
+      for (index_type l=0; l<k; ++l)
+        if (x[l]->N()!=M() || y[l]->N()!=N()) DUNE_THROW(BCRSMatrixError,"index out of range");
+#endif
+      ConstRowIterator endi=end();
+      for (ConstRowIterator i=begin(); i!=endi; ++i)
+      {
+        for (index_type l=0; l<k; ++l)
+          (*y[l])[i.index()]=0;
+        ConstColIterator endj = (*i).end();
+        for (ConstColIterator j=(*i).begin(); j!=endj; ++j)
+          for (index_type l=0; l<k; ++l)
+            (*j).umv((*x[l])[j.index()],(*y[l])[i.index()]);
+      }
+    }
+
     //! y += A x
     template<class X, class Y>
     void umv (const X& x, Y& y) const
@@ -2179,6 +2208,44 @@ namespace Dune {
   };
 
 
+  /**
+     \brief Copy a matrix into a matrix with a different field type.
+
+     This is useful for mixed precision computations, e.g. to set up a
+     preconditioner in single precision for a matrix assembled in double
+     precision. The blocks have to be dense blocks like FieldMatrix.
+
+     \param B The destination matrix, it has to be default constructed.
+     \param A The matrix to copy.
+   */
+  template<class B1, class A1, class B2, class A2>
+  void convertMatrix (BCRSMatrix<B1,A1>& B, const BCRSMatrix<B2,A2>& A)
+  {
+    typedef typename BCRSMatrix<B1,A1>::CreateIterator CreateIterator;
+    typedef typename BCRSMatrix<B1,A1>::ColIterator ColIterator;
+    typedef typename BCRSMatrix<B2,A2>::ConstColIterator ConstColIterator;
+    typedef typename B1::field_type field_type;
+
+    B.setBuildMode(BCRSMatrix<B1,A1>::row_wise);
+    B.setSize(A.N(),A.M(),A.nonzeroes());
+    for (CreateIterator ci=B.createbegin(); ci!=B.createend(); ++ci)
+    {
+      ConstColIterator endj=A[ci.index()].end();
+      for (ConstColIterator j=A[ci.index()].begin(); j!=endj; ++j)
+        ci.insert(j.index());
+    }
+
+    for (typename BCRSMatrix<B2,A2>::size_type i=0; i<A.N(); ++i)
+    {
+      ConstColIterator aj=A[i].begin();
+      ColIterator endj=B[i].end();
+      for (ColIterator bj=B[i].begin(); bj!=endj; ++bj, ++aj)
+        for (int r=0; r<B1::rows; ++r)
+          for (int c=0; c<B1::cols; ++c)
+            (*bj)[r][c] = static_cast<field_type>((*aj)[r][c]);
+    }
+  }
+
   /** @} end documentation */
 
 } // end namespace
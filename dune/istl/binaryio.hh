@@ -0,0 +1,1159 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+#ifndef DUNE_ISTL_BINARYIO_HH
+#define DUNE_ISTL_BINARYIO_HH
+
+#include <complex>
+#include <cstring>
+#include <fstream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+#include "bcrsmatrix.hh"
+#include "bvector.hh"
+#include "owneroverlapcopy.hh"
+
+#if HAVE_MPI
+#include <algorithm>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <mpi.h>
+#endif
+
+namespace Dune
+{
+
+  /**
+   * @addtogroup ISTL_IO
+   * @{
+   */
+
+  /** @file
+   * @brief Reading and writing BCRSMatrix and BlockVector in a native
+   * binary format.
+   *
+   * A file consists of a header of 64 bytes (see BinaryHeader) followed
+   * by the data sections. For a matrix these are
+   *
+   * - the row pointers: BinaryHeader::rows+1 unsigned 64 bit integers,
+   *   the blocks of row i are the blocks rowPointers[i] to
+   *   rowPointers[i+1]-1,
+   * - the column indices of the blocks: BinaryHeader::nonzeroes
+   *   unsigned 64 bit integers, sorted within each row,
+   * - the values starting at byte BinaryHeader::valueOffset, which is a
+   *   multiple of 64: the entries of each block in row major order, the
+   *   blocks in the order of the column indices.
+   *
+   * For a vector only the values of the blocks follow the header, for
+   * a list of indices the indices as unsigned 64 bit integers.
+   * All data is stored in the byte order of the writing machine, a
+   * file written on a machine with a different byte order is rejected.
+   *
+   * Files are written in one sequential pass and read via mmap, such
+   * that MappedBinaryMatrix and MappedBinaryVector provide access to
+   * the values without copying them.
+   */
+
+  //! Error thrown if a file is not in the binary format.
+  class BinaryFormatError : public Dune::Exception
+  {};
+
+  /**
+   * @brief The header of the binary matrix and vector files.
+   */
+  struct BinaryHeader
+  {
+    enum {
+      //! Marker to detect files written with a different byte order.
+      byteOrderMark = 0x01020304,
+      //! The version of the format.
+      currentVersion = 1
+    };
+
+    //! The kind of data stored in the file.
+    enum Kind { matrix=0, vector=1, indices=2 };
+
+    //! The characters "DUNEISTL".
+    char magic[8];
+    //! byteOrderMark as written by the producer.
+    uint32_t byteOrder;
+    //! The version of the format.
+    uint32_t version;
+    //! The Kind of the data.
+    uint32_t kind;
+    //! The type of the entries, see BinaryFieldCode.
+    uint32_t field;
+    //! The number of rows of a block.
+    uint32_t blockRows;
+    //! The number of columns of a block (1 for vectors).
+    uint32_t blockCols;
+    //! The number of block rows.
+    uint64_t rows;
+    //! The number of block columns (1 for vectors).
+    uint64_t cols;
+    //! The number of stored blocks.
+    uint64_t nonzeroes;
+    //! The byte offset of the values in the file.
+    uint64_t valueOffset;
+  };
+
+  static_assert(sizeof(BinaryHeader)==64, "The binary header has to have 64 bytes");
+
+  /**
+   * @brief The code of a field type in the binary format.
+   *
+   * Only the specializations for the floating point types and their
+   * complex counterparts are defined.
+   */
+  template<typename T>
+  struct BinaryFieldCode;
+
+  template<>
+  struct BinaryFieldCode<float>
+  {
+    enum { value = 1 };
+  };
+
+  template<>
+  struct BinaryFieldCode<double>
+  {
+    enum { value = 2 };
+  };
+
+  template<>
+  struct BinaryFieldCode<long double>
+  {
+    enum { value = 3 };
+  };
+
+  template<>
+  struct BinaryFieldCode<std::complex<float> >
+  {
+    enum { value = 4 };
+  };
+
+  template<>
+  struct BinaryFieldCode<std::complex<double> >
+  {
+    enum { value = 5 };
+  };
+
+  template<>
+  struct BinaryFieldCode<std::complex<long double> >
+  {
+    enum { value = 6 };
+  };
+
+  template<>
+  struct BinaryFieldCode<uint64_t>
+  {
+    enum { value = 7 };
+  };
+
+  //! Helpers for storing and loading data in the binary format.
+  namespace BinaryIODetail
+  {
+    //! Create the header for the given data.
+    template<typename T>
+    inline BinaryHeader makeBinaryHeader(BinaryHeader::Kind kind, int brows, int bcols,
+                                  std::size_t rows, std::size_t cols, std::size_t nonzeroes)
+    {
+      BinaryHeader header;
+      std::memcpy(header.magic, "DUNEISTL", 8);
+      header.byteOrder = BinaryHeader::byteOrderMark;
+      header.version = BinaryHeader::currentVersion;
+      header.kind = kind;
+      header.field = BinaryFieldCode<T>::value;
+      header.blockRows = brows;
+      header.blockCols = bcols;
+      header.rows = rows;
+      header.cols = cols;
+      header.nonzeroes = nonzeroes;
+      header.valueOffset = sizeof(BinaryHeader);
+      if(kind==BinaryHeader::matrix) {
+        // row pointers and column indices, the values start at a cache line
+        header.valueOffset += sizeof(uint64_t)*(rows+1+nonzeroes);
+        header.valueOffset = (header.valueOffset+63)/64*64;
+      }
+      return header;
+    }
+
+    //! Write n zero bytes.
+    inline void writeBinaryPadding(std::ostream& ostr, std::size_t n)
+    {
+      const char zeros[64] = {};
+      for(; n>64; n-=64)
+        ostr.write(zeros, 64);
+      ostr.write(zeros, n);
+    }
+  } // end namespace BinaryIODetail
+
+  /**
+   * @brief A read only memory mapping of a binary matrix or vector file.
+   *
+   * The header is checked when the file is opened.
+   */
+  class BinaryFileMapping
+  {
+  public:
+    /**
+     * @brief Map a file into memory.
+     * @param filename The name of the file.
+     */
+    explicit BinaryFileMapping(const std::string& filename)
+      : data_(0), size_(0), fd_(-1)
+    {
+      fd_ = open(filename.c_str(), O_RDONLY);
+      if(fd_<0)
+        DUNE_THROW(IOError, "Could not open file " << filename);
+      struct stat st;
+      if(fstat(fd_, &st)!=0) {
+        close(fd_);
+        DUNE_THROW(IOError, "Could not stat file " << filename);
+      }
+      size_ = st.st_size;
+      if(size_<sizeof(BinaryHeader)) {
+        close(fd_);
+        DUNE_THROW(BinaryFormatError, filename << " is too short for a binary matrix or vector");
+      }
+      void* data = mmap(0, size_, PROT_READ, MAP_SHARED, fd_, 0);
+      if(data==MAP_FAILED) {
+        close(fd_);
+        DUNE_THROW(IOError, "Could not map file " << filename);
+      }
+      data_ = static_cast<const char*>(data);
+
+      const BinaryHeader& h = header();
+      const char* error = 0;
+      if(std::memcmp(h.magic, "DUNEISTL", 8)!=0)
+        error = "is not a binary matrix or vector";
+      else if(h.byteOrder!=BinaryHeader::byteOrderMark)
+        error = "was written with a different byte order";
+      else if(h.version!=BinaryHeader::currentVersion)
+        error = "was written with an unsupported version of the format";
+      else if(h.valueOffset>size_)
+        error = "is truncated";
+      if(error) {
+        release();
+        DUNE_THROW(BinaryFormatError, filename << " " << error);
+      }
+    }
+
+    ~BinaryFileMapping()
+    {
+      release();
+    }
+
+    //! The header of the file.
+    const BinaryHeader& header() const
+    {
+      return *reinterpret_cast<const BinaryHeader*>(data_);
+    }
+
+    //! The content of the file.
+    const char* data() const
+    {
+      return data_;
+    }
+
+    //! The size of the file in bytes.
+    std::size_t size() const
+    {
+      return size_;
+    }
+
+    /**
+     * @brief Check that the file contains the expected kind of data
+     * with the given field type and block size and that the sizes in
+     * the header fit into the file.
+     */
+    template<typename T>
+    void check(BinaryHeader::Kind kind, int brows, int bcols) const
+    {
+      const BinaryHeader& h = header();
+      if(h.kind!=static_cast<uint32_t>(kind))
+        DUNE_THROW(BinaryFormatError, "File contains a "
+                   << (h.kind==BinaryHeader::matrix ? "matrix" : "vector"));
+      if(h.field!=static_cast<uint32_t>(BinaryFieldCode<T>::value))
+        DUNE_THROW(BinaryFormatError, "Field type of the file does not match");
+      if(h.blockRows!=static_cast<uint32_t>(brows) || h.blockCols!=static_cast<uint32_t>(bcols))
+        DUNE_THROW(BinaryFormatError, "Block size of the file is "
+                   << h.blockRows << "x" << h.blockCols << " instead of "
+                   << brows << "x" << bcols);
+      if(h.valueOffset<sizeof(BinaryHeader))
+        DUNE_THROW(BinaryFormatError, "File has an invalid value offset");
+      if(kind==BinaryHeader::matrix) {
+        // the row pointers and column indices lie between header and values
+        const uint64_t indices = (h.valueOffset-sizeof(BinaryHeader))/sizeof(uint64_t);
+        if(h.rows>=indices || h.nonzeroes>indices-h.rows-1)
+          DUNE_THROW(BinaryFormatError, "File has too few row pointers and column indices");
+      }
+      else if(h.rows!=h.nonzeroes)
+        DUNE_THROW(BinaryFormatError, "File has inconsistent sizes");
+      // the constructor ensured valueOffset<=size_, divide to avoid overflows
+      const uint64_t blockBytes = static_cast<uint64_t>(brows)*bcols*sizeof(T);
+      if(h.nonzeroes>(size_-h.valueOffset)/blockBytes)
+        DUNE_THROW(BinaryFormatError, "File is truncated");
+    }
+
+  private:
+    // not copyable
+    BinaryFileMapping(const BinaryFileMapping&);
+    BinaryFileMapping& operator=(const BinaryFileMapping&);
+
+    void release()
+    {
+      if(data_)
+        munmap(const_cast<char*>(data_), size_);
+      if(fd_>=0)
+        close(fd_);
+      data_ = 0;
+      fd_ = -1;
+    }
+
+    const char* data_;
+    std::size_t size_;
+    int fd_;
+  };
+
+  /**
+   * @brief Zero-copy access to a matrix stored in the binary format.
+   *
+   * @tparam Matrix The type of the matrix the file was written from,
+   * i.e. BCRSMatrix<FieldMatrix<T,n,m> >.
+   */
+  template<class Matrix>
+  class MappedBinaryMatrix
+  {
+  public:
+    //! The type of the matrix the file corresponds to.
+    typedef Matrix matrix_type;
+    //! The type of the blocks.
+    typedef typename Matrix::block_type block_type;
+    //! The field type of the matrix.
+    typedef typename block_type::field_type field_type;
+
+    enum {
+      //! The number of rows of a block.
+      blockrows = block_type::rows,
+      //! The number of columns of a block.
+      blockcols = block_type::cols
+    };
+
+    /**
+     * @brief Map a matrix file.
+     * @param filename The name of the file.
+     */
+    explicit MappedBinaryMatrix(const std::string& filename)
+      : file_(filename)
+    {
+      file_.check<field_type>(BinaryHeader::matrix, blockrows, blockcols);
+      const uint64_t* indices = reinterpret_cast<const uint64_t*>(file_.data()+sizeof(BinaryHeader));
+      rowPointers_ = indices;
+      columnIndices_ = indices+N()+1;
+      values_ = reinterpret_cast<const field_type*>(file_.data()+file_.header().valueOffset);
+      if(rowPointers_[0]!=0 || rowPointers_[N()]!=nonzeroes())
+        DUNE_THROW(BinaryFormatError, filename << " has inconsistent row pointers");
+      for(std::size_t i=0; i<N(); ++i)
+        if(rowPointers_[i+1]<rowPointers_[i])
+          DUNE_THROW(BinaryFormatError, filename << " has decreasing row pointers");
+      for(std::size_t k=0; k<nonzeroes(); ++k)
+        if(columnIndices_[k]>=M())
+          DUNE_THROW(BinaryFormatError, filename << " has a column index out of range");
+    }
+
+    //! The number of block rows.
+    std::size_t N() const
+    {
+      return file_.header().rows;
+    }
+
+    //! The number of block columns.
+    std::size_t M() const
+    {
+      return file_.header().cols;
+    }
+
+    //! The number of stored blocks.
+    std::size_t nonzeroes() const
+    {
+      return file_.header().nonzeroes;
+    }
+
+    //! The row pointers (N()+1 entries).
+    const uint64_t* rowPointers() const
+    {
+      return rowPointers_;
+    }
+
+    //! The column indices of the blocks.
+    const uint64_t* columnIndices() const
+    {
+      return columnIndices_;
+    }
+
+    //! The entries of the blocks, each block in row major order.
+    const field_type* values() const
+    {
+      return values_;
+    }
+
+    //! \f$ y = y + A x \f$ computed directly on the mapped data.
+    template<class X, class Y>
+    void umv(const X& x, Y& y) const
+    {
+      const std::size_t rows = N();
+      for(std::size_t i=0; i<rows; ++i)
+        for(uint64_t k=rowPointers_[i]; k<rowPointers_[i+1]; ++k) {
+          const field_type* a = values_+k*blockrows*blockcols;
+          const typename X::block_type& xj = x[columnIndices_[k]];
+          for(int r=0; r<blockrows; ++r)
+            for(int c=0; c<blockcols; ++c)
+              y[i][r] += a[r*blockcols+c]*xj[c];
+        }
+    }
+
+  private:
+    BinaryFileMapping file_;
+    const uint64_t* rowPointers_;
+    const uint64_t* columnIndices_;
+    const field_type* values_;
+  };
+
+  /**
+   * @brief Zero-copy access to a vector stored in the binary format.
+   *
+   * @tparam V The type of the vector the file was written from,
+   * i.e. BlockVector<FieldVector<T,n> >.
+   */
+  template<class V>
+  class MappedBinaryVector
+  {
+  public:
+    //! The type of the vector the file corresponds to.
+    typedef V vector_type;
+    //! The type of the blocks.
+    typedef typename V::block_type block_type;
+    //! The field type of the vector.
+    typedef typename V::field_type field_type;
+
+    enum {
+      //! The size of a block.
+      blocksize = block_type::dimension
+    };
+
+    /**
+     * @brief Map a vector file.
+     * @param filename The name of the file.
+     */
+    explicit MappedBinaryVector(const std::string& filename)
+      : file_(filename)
+    {
+      file_.check<field_type>(BinaryHeader::vector, blocksize, 1);
+      values_ = reinterpret_cast<const field_type*>(file_.data()+file_.header().valueOffset);
+    }
+
+    //! The number of blocks.
+    std::size_t N() const
+    {
+      return file_.header().rows;
+    }
+
+    //! The entries of the vector.
+    const field_type* values() const
+    {
+      return values_;
+    }
+
+  private:
+    BinaryFileMapping file_;
+    const field_type* values_;
+  };
+
+  /**
+   * @brief Write a matrix in the binary format to a stream.
+   *
+   * The matrix is traversed once per section, only the row pointers
+   * and a single row are buffered.
+   * @param matrix The matrix to write.
+   * @param ostr The stream to write to, it should be opened in binary mode.
+   */
+  template<typename T, typename A, int brows, int bcols>
+  void writeBinary(const BCRSMatrix<FieldMatrix<T,brows,bcols>,A>& matrix,
+                   std::ostream& ostr)
+  {
+    typedef BCRSMatrix<FieldMatrix<T,brows,bcols>,A> Matrix;
+    typedef typename Matrix::ConstRowIterator RowIterator;
+    typedef typename Matrix::ConstColIterator ColIterator;
+
+    BinaryHeader header = BinaryIODetail::makeBinaryHeader<T>(BinaryHeader::matrix, brows, bcols,
+                                                              matrix.N(), matrix.M(), matrix.nonzeroes());
+    ostr.write(reinterpret_cast<const char*>(&header), sizeof(BinaryHeader));
+
+    std::vector<uint64_t> indices;
+    uint64_t offset = 0;
+    indices.reserve(matrix.N()+1);
+    indices.push_back(offset);
+    for(RowIterator row=matrix.begin(); row!=matrix.end(); ++row) {
+      offset += row->getsize();
+      indices.push_back(offset);
+    }
+    ostr.write(reinterpret_cast<const char*>(&indices[0]), indices.size()*sizeof(uint64_t));
+
+    for(RowIterator row=matrix.begin(); row!=matrix.end(); ++row) {
+      indices.clear();
+      for(ColIterator col=row->begin(); col!=row->end(); ++col)
+        indices.push_back(col.index());
+      if(!indices.empty())
+        ostr.write(reinterpret_cast<const char*>(&indices[0]), indices.size()*sizeof(uint64_t));
+    }
+
+    BinaryIODetail::writeBinaryPadding(ostr, header.valueOffset-sizeof(BinaryHeader)
+                                       -sizeof(uint64_t)*(matrix.N()+1+matrix.nonzeroes()));
+
+    std::vector<T> values;
+    for(RowIterator row=matrix.begin(); row!=matrix.end(); ++row) {
+      values.clear();
+      for(ColIterator col=row->begin(); col!=row->end(); ++col)
+        for(int r=0; r<brows; ++r)
+          for(int c=0; c<bcols; ++c)
+            values.push_back((*col)[r][c]);
+      if(!values.empty())
+        ostr.write(reinterpret_cast<const char*>(&values[0]), values.size()*sizeof(T));
+    }
+    if(!ostr)
+      DUNE_THROW(IOError, "Writing the binary matrix failed");
+  }
+
+  /**
+   * @brief Write a vector in the binary format to a stream.
+   * @param vector The vector to write.
+   * @param ostr The stream to write to, it should be opened in binary mode.
+   */
+  template<typename T, typename A, int entries>
+  void writeBinary(const BlockVector<FieldVector<T,entries>,A>& vector,
+                   std::ostream& ostr)
+  {
+    BinaryHeader header = BinaryIODetail::makeBinaryHeader<T>(BinaryHeader::vector, entries, 1,
+                                                              vector.N(), 1, vector.N());
+    ostr.write(reinterpret_cast<const char*>(&header), sizeof(BinaryHeader));
+
+    std::vector<T> values;
+    values.reserve(vector.dim());
+    for(std::size_t i=0; i<vector.N(); ++i)
+      for(int k=0; k<entries; ++k)
+        values.push_back(vector[i][k]);
+    if(!values.empty())
+      ostr.write(reinterpret_cast<const char*>(&values[0]), values.size()*sizeof(T));
+    if(!ostr)
+      DUNE_THROW(IOError, "Writing the binary vector failed");
+  }
+
+  /**
+   * @brief Write a list of indices in the binary format to a stream.
+   * @param indices The indices to write.
+   * @param ostr The stream to write to, it should be opened in binary mode.
+   */
+  inline void writeBinary(const std::vector<uint64_t>& indices, std::ostream& ostr)
+  {
+    BinaryHeader header = BinaryIODetail::makeBinaryHeader<uint64_t>(BinaryHeader::indices, 1, 1,
+                                                                     indices.size(), 1, indices.size());
+    ostr.write(reinterpret_cast<const char*>(&header), sizeof(BinaryHeader));
+    if(!indices.empty())
+      ostr.write(reinterpret_cast<const char*>(&indices[0]), indices.size()*sizeof(uint64_t));
+    if(!ostr)
+      DUNE_THROW(IOError, "Writing the binary indices failed");
+  }
+
+  /**
+   * @brief Zero-copy access to a list of indices stored in the binary format.
+   */
+  class MappedBinaryIndices
+  {
+  public:
+    /**
+     * @brief Map an index file.
+     * @param filename The name of the file.
+     */
+    explicit MappedBinaryIndices(const std::string& filename)
+      : file_(filename)
+    {
+      file_.check<uint64_t>(BinaryHeader::indices, 1, 1);
+      values_ = reinterpret_cast<const uint64_t*>(file_.data()+file_.header().valueOffset);
+    }
+
+    //! The number of indices.
+    std::size_t N() const
+    {
+      return file_.header().rows;
+    }
+
+    //! The indices.
+    const uint64_t* values() const
+    {
+      return values_;
+    }
+
+  private:
+    BinaryFileMapping file_;
+    const uint64_t* values_;
+  };
+
+  /**
+   * @brief Store a matrix or vector in the binary format.
+   * @param matrix The matrix/vector to store.
+   * @param filename The name of the file.
+   */
+  template<typename M>
+  void storeBinary(const M& matrix, const std::string& filename)
+  {
+    std::ofstream file(filename.c_str(), std::ios::out | std::ios::binary);
+    if(!file)
+      DUNE_THROW(IOError, "Could not open file " << filename);
+    writeBinary(matrix, file);
+    file.close();
+  }
+
+  /**
+   * @brief Load a matrix stored in the binary format.
+   * @param matrix The matrix to store the data in, it has to be default
+   * constructed.
+   * @param filename The name of the file.
+   */
+  template<typename T, typename A, int brows, int bcols>
+  void loadBinary(BCRSMatrix<FieldMatrix<T,brows,bcols>,A>& matrix,
+                  const std::string& filename)
+  {
+    typedef BCRSMatrix<FieldMatrix<T,brows,bcols>,A> Matrix;
+    MappedBinaryMatrix<Matrix> mapped(filename);
+    const uint64_t* rowPointers = mapped.rowPointers();
+    const uint64_t* columns = mapped.columnIndices();
+    const T* values = mapped.values();
+
+    matrix.setBuildMode(Matrix::row_wise);
+    matrix.setSize(mapped.N(), mapped.M(), mapped.nonzeroes());
+    std::size_t i=0;
+    for(typename Matrix::CreateIterator ci=matrix.createbegin(); ci!=matrix.createend(); ++ci, ++i)
+      for(uint64_t k=rowPointers[i]; k<rowPointers[i+1]; ++k)
+        ci.insert(columns[k]);
+
+    i=0;
+    for(typename Matrix::RowIterator row=matrix.begin(); row!=matrix.end(); ++row, ++i) {
+      const T* a = values+rowPointers[i]*brows*bcols;
+      for(typename Matrix::ColIterator col=row->begin(); col!=row->end(); ++col)
+        for(int r=0; r<brows; ++r)
+          for(int c=0; c<bcols; ++c)
+            (*col)[r][c] = *a++;
+    }
+  }
+
+  /**
+   * @brief Load a vector stored in the binary format.
+   * @param vector The vector to store the data in.
+   * @param filename The name of the file.
+   */
+  template<typename T, typename A, int entries>
+  void loadBinary(BlockVector<FieldVector<T,entries>,A>& vector,
+                  const std::string& filename)
+  {
+    MappedBinaryVector<BlockVector<FieldVector<T,entries>,A> > mapped(filename);
+    const T* values = mapped.values();
+    vector.resize(mapped.N());
+    for(std::size_t i=0; i<vector.N(); ++i)
+      for(int k=0; k<entries; ++k)
+        vector[i][k] = *values++;
+  }
+
+#if HAVE_MPI
+  //! Helpers for storing and loading distributed data in the binary format.
+  namespace BinaryIODetail
+  {
+    /**
+     * @brief Get the global index of every local index and the local
+     * indices owned by this process in ascending order.
+     */
+    template<typename G, typename L>
+    void binaryOwnedIndices(const OwnerOverlapCopyCommunication<G,L>& comm, std::size_t size,
+                            std::vector<uint64_t>& globalIds, std::vector<std::size_t>& owned)
+    {
+      typedef typename OwnerOverlapCopyCommunication<G,L>::ParallelIndexSet IndexSet;
+      typedef typename IndexSet::const_iterator Iterator;
+      std::vector<char> known(size, false), owner(size, false);
+      globalIds.assign(size, 0);
+      for(Iterator iter=comm.indexSet().begin(); iter!=comm.indexSet().end(); ++iter) {
+        std::size_t local=iter->local();
+        globalIds[local]=iter->global();
+        known[local]=true;
+        owner[local]=iter->local().attribute()==OwnerOverlapCopyAttributeSet::owner;
+      }
+      owned.clear();
+      for(std::size_t i=0; i<size; ++i) {
+        if(!known[i])
+          DUNE_THROW(ISTLError, "Local index "<<i<<" has no global index");
+        if(owner[i])
+          owned.push_back(i);
+      }
+    }
+
+    //! Write the owned rows of a matrix with global column indices.
+    template<typename T, typename A, int brows, int bcols>
+    void writeBinarySlab(const BCRSMatrix<FieldMatrix<T,brows,bcols>,A>& matrix,
+                         const std::vector<uint64_t>& globalIds,
+                         const std::vector<std::size_t>& rows,
+                         uint64_t globalSize, std::ostream& ostr)
+    {
+      typedef BCRSMatrix<FieldMatrix<T,brows,bcols>,A> Matrix;
+      typedef typename Matrix::ConstColIterator ColIterator;
+      typedef std::pair<uint64_t,const FieldMatrix<T,brows,bcols>*> Entry;
+
+      std::vector<uint64_t> indices;
+      uint64_t offset = 0;
+      indices.reserve(rows.size()+1);
+      indices.push_back(offset);
+      for(std::size_t i=0; i<rows.size(); ++i) {
+        offset += matrix[rows[i]].getsize();
+        indices.push_back(offset);
+      }
+      BinaryHeader header = makeBinaryHeader<T>(BinaryHeader::matrix, brows, bcols,
+                                                rows.size(), globalSize, offset);
+      ostr.write(reinterpret_cast<const char*>(&header), sizeof(BinaryHeader));
+      ostr.write(reinterpret_cast<const char*>(&indices[0]), indices.size()*sizeof(uint64_t));
+
+      // the blocks of a row sorted by their global column index
+      std::vector<Entry> entries;
+      for(std::size_t i=0; i<rows.size(); ++i) {
+        entries.clear();
+        for(ColIterator col=matrix[rows[i]].begin(); col!=matrix[rows[i]].end(); ++col)
+          entries.push_back(Entry(globalIds[col.index()], &(*col)));
+        std::sort(entries.begin(), entries.end());
+        indices.clear();
+        for(std::size_t k=0; k<entries.size(); ++k)
+          indices.push_back(entries[k].first);
+        if(!indices.empty())
+          ostr.write(reinterpret_cast<const char*>(&indices[0]), indices.size()*sizeof(uint64_t));
+      }
+
+      writeBinaryPadding(ostr, header.valueOffset-sizeof(BinaryHeader)
+                         -sizeof(uint64_t)*(rows.size()+1+offset));
+
+      std::vector<T> values;
+      for(std::size_t i=0; i<rows.size(); ++i) {
+        entries.clear();
+        for(ColIterator col=matrix[rows[i]].begin(); col!=matrix[rows[i]].end(); ++col)
+          entries.push_back(Entry(globalIds[col.index()], &(*col)));
+        std::sort(entries.begin(), entries.end());
+        values.clear();
+        for(std::size_t k=0; k<entries.size(); ++k)
+          for(int r=0; r<brows; ++r)
+            for(int c=0; c<bcols; ++c)
+              values.push_back((*entries[k].second)[r][c]);
+        if(!values.empty())
+          ostr.write(reinterpret_cast<const char*>(&values[0]), values.size()*sizeof(T));
+      }
+      if(!ostr)
+        DUNE_THROW(IOError, "Writing the binary matrix failed");
+    }
+
+    //! Write the owned entries of a vector.
+    template<typename T, typename A, int entries>
+    void writeBinarySlab(const BlockVector<FieldVector<T,entries>,A>& vector,
+                         const std::vector<uint64_t>& globalIds,
+                         const std::vector<std::size_t>& rows,
+                         uint64_t globalSize, std::ostream& ostr)
+    {
+      DUNE_UNUSED_PARAMETER(globalIds);
+      DUNE_UNUSED_PARAMETER(globalSize);
+      BinaryHeader header = makeBinaryHeader<T>(BinaryHeader::vector, entries, 1,
+                                                rows.size(), 1, rows.size());
+      ostr.write(reinterpret_cast<const char*>(&header), sizeof(BinaryHeader));
+      std::vector<T> values;
+      values.reserve(rows.size()*entries);
+      for(std::size_t i=0; i<rows.size(); ++i)
+        for(int k=0; k<entries; ++k)
+          values.push_back(vector[rows[i]][k]);
+      if(!values.empty())
+        ostr.write(reinterpret_cast<const char*>(&values[0]), values.size()*sizeof(T));
+      if(!ostr)
+        DUNE_THROW(IOError, "Writing the binary vector failed");
+    }
+
+    //! The part of a slab read by this process.
+    struct BinarySlabRange
+    {
+      //! The number of the slab.
+      int slab;
+      //! The first row of the slab to read.
+      std::size_t first;
+      //! The row after the last row to read.
+      std::size_t last;
+    };
+
+    /**
+     * @brief Compute the parts of the slabs of a dataset read by this process.
+     *
+     * The rows of all slabs are concatenated and split into contiguous
+     * ranges of the same size, one per process.
+     */
+    inline void binarySlabRanges(const std::string& filename, int rank, int procs,
+                                 std::vector<BinarySlabRange>& ranges)
+    {
+      MappedBinaryIndices counts(filename+".slabs");
+      uint64_t total = 0;
+      for(std::size_t s=0; s<counts.N(); ++s)
+        total += counts.values()[s];
+      const uint64_t begin = total*rank/procs, end = total*(rank+1)/procs;
+      ranges.clear();
+      uint64_t offset = 0;
+      for(std::size_t s=0; s<counts.N(); offset+=counts.values()[s], ++s) {
+        const uint64_t first = std::max(begin, offset);
+        const uint64_t last = std::min(end, offset+counts.values()[s]);
+        if(first<last) {
+          BinarySlabRange range = {static_cast<int>(s), first-offset, last-offset};
+          ranges.push_back(range);
+        }
+      }
+    }
+
+    //! The name of a file of a slab.
+    inline std::string binarySlabName(const std::string& filename, int slab, const char* suffix)
+    {
+      std::ostringstream name;
+      name<<filename<<"_"<<slab<<suffix;
+      return name.str();
+    }
+
+    /**
+     * @brief Find the owners of global indices.
+     *
+     * Uses a directory distributed over the processes by the global
+     * index modulo the number of processes.
+     * @param owned The global indices owned by this process.
+     * @param wanted The global indices to find the owners of.
+     * @param owners The owners of the wanted indices.
+     */
+    inline void binaryFindOwners(const std::vector<uint64_t>& owned, const std::vector<uint64_t>& wanted,
+                                 std::vector<int>& owners, MPI_Comm comm)
+    {
+      int procs;
+      MPI_Comm_size(comm, &procs);
+      std::vector<int> sendCounts(procs), recvCounts(procs), sendOffsets(procs+1), recvOffsets(procs+1);
+
+      // register the owned indices in the directory
+      for(std::size_t i=0; i<owned.size(); ++i)
+        ++sendCounts[owned[i]%procs];
+      MPI_Alltoall(&sendCounts[0], 1, MPI_INT, &recvCounts[0], 1, MPI_INT, comm);
+      sendOffsets[0] = recvOffsets[0] = 0;
+      for(int p=0; p<procs; ++p) {
+        sendOffsets[p+1] = sendOffsets[p]+sendCounts[p];
+        recvOffsets[p+1] = recvOffsets[p]+recvCounts[p];
+      }
+      std::vector<uint64_t> sendBuffer(sendOffsets[procs]+1), recvBuffer(recvOffsets[procs]+1);
+      std::vector<int> position(sendOffsets.begin(), sendOffsets.end()-1);
+      for(std::size_t i=0; i<owned.size(); ++i)
+        sendBuffer[position[owned[i]%procs]++] = owned[i];
+      MPI_Alltoallv(&sendBuffer[0], &sendCounts[0], &sendOffsets[0], MPI_UINT64_T,
+                    &recvBuffer[0], &recvCounts[0], &recvOffsets[0], MPI_UINT64_T, comm);
+      std::vector<std::pair<uint64_t,int> > directory;
+      directory.reserve(recvOffsets[procs]);
+      for(int p=0; p<procs; ++p)
+        for(int k=recvOffsets[p]; k<recvOffsets[p+1]; ++k)
+          directory.push_back(std::make_pair(recvBuffer[k], p));
+      std::sort(directory.begin(), directory.end());
+
+      // ask the directory for the owners of the wanted indices
+      std::fill(sendCounts.begin(), sendCounts.end(), 0);
+      for(std::size_t i=0; i<wanted.size(); ++i)
+        ++sendCounts[wanted[i]%procs];
+      MPI_Alltoall(&sendCounts[0], 1, MPI_INT, &recvCounts[0], 1, MPI_INT, comm);
+      for(int p=0; p<procs; ++p) {
+        sendOffsets[p+1] = sendOffsets[p]+sendCounts[p];
+        recvOffsets[p+1] = recvOffsets[p]+recvCounts[p];
+      }
+      sendBuffer.resize(sendOffsets[procs]+1);
+      recvBuffer.resize(recvOffsets[procs]+1);
+      std::vector<std::size_t> order(wanted.size());
+      position.assign(sendOffsets.begin(), sendOffsets.end()-1);
+      for(std::size_t i=0; i<wanted.size(); ++i) {
+        order[i] = position[wanted[i]%procs]++;
+        sendBuffer[order[i]] = wanted[i];
+      }
+      MPI_Alltoallv(&sendBuffer[0], &sendCounts[0], &sendOffsets[0], MPI_UINT64_T,
+                    &recvBuffer[0], &recvCounts[0], &recvOffsets[0], MPI_UINT64_T, comm);
+
+      std::vector<int> answers(recvOffsets[procs]+1), replies(sendOffsets[procs]+1);
+      for(int k=0; k<recvOffsets[procs]; ++k) {
+        std::vector<std::pair<uint64_t,int> >::const_iterator entry
+          = std::lower_bound(directory.begin(), directory.end(), std::make_pair(recvBuffer[k], -1));
+        answers[k] = (entry!=directory.end() && entry->first==recvBuffer[k]) ? entry->second : -1;
+      }
+      MPI_Alltoallv(&answers[0], &recvCounts[0], &recvOffsets[0], MPI_INT,
+                    &replies[0], &sendCounts[0], &sendOffsets[0], MPI_INT, comm);
+
+      owners.resize(wanted.size());
+      for(std::size_t i=0; i<wanted.size(); ++i) {
+        owners[i] = replies[order[i]];
+        if(owners[i]<0)
+          DUNE_THROW(ISTLError, "Global index "<<wanted[i]<<" is not owned by any process");
+      }
+    }
+
+    //! Compare the global indices of a map from global to local indices.
+    struct BinaryIdLess
+    {
+      bool operator()(const std::pair<uint64_t,std::size_t>& a,
+                      const std::pair<uint64_t,std::size_t>& b) const
+      {
+        return a.first<b.first;
+      }
+    };
+
+    //! The local index of a global index, the owned indices come first, then the halo.
+    inline std::size_t binaryLocalIndex(uint64_t id, const std::vector<std::pair<uint64_t,std::size_t> >& owned,
+                                        const std::vector<uint64_t>& halo)
+    {
+      std::vector<std::pair<uint64_t,std::size_t> >::const_iterator entry
+        = std::lower_bound(owned.begin(), owned.end(), std::make_pair(id, std::size_t(0)), BinaryIdLess());
+      if(entry!=owned.end() && entry->first==id)
+        return entry->second;
+      return owned.size()+(std::lower_bound(halo.begin(), halo.end(), id)-halo.begin());
+    }
+
+    /**
+     * @brief Read this process' part of a distributed matrix.
+     *
+     * The rows read are owned by this process. All other global indices
+     * referenced by them are added as copy indices with a unit row.
+     */
+    template<typename T, typename A, int brows, int bcols, typename G, typename L>
+    void readBinarySlabs(BCRSMatrix<FieldMatrix<T,brows,bcols>,A>& matrix,
+                         const std::string& filename,
+                         OwnerOverlapCopyCommunication<G,L>& comm)
+    {
+      typedef BCRSMatrix<FieldMatrix<T,brows,bcols>,A> Matrix;
+      typedef typename OwnerOverlapCopyCommunication<G,L>::ParallelIndexSet IndexSet;
+      typedef typename IndexSet::LocalIndex LocalIndex;
+      typedef std::vector<std::pair<uint64_t,std::size_t> > IdMap;
+
+      MPI_Comm mpiComm = comm.communicator();
+      IndexSet& pis = comm.indexSet();
+      if(pis.size()!=0)
+        DUNE_THROW(InvalidIndexSetState, "Index set is not empty!");
+
+      std::vector<BinarySlabRange> ranges;
+      binarySlabRanges(filename, comm.communicator().rank(), comm.communicator().size(), ranges);
+
+      std::vector<std::shared_ptr<MappedBinaryMatrix<Matrix> > > slabs;
+      std::vector<uint64_t> ownedIds;
+      for(std::size_t r=0; r<ranges.size(); ++r) {
+        slabs.push_back(std::make_shared<MappedBinaryMatrix<Matrix> >(binarySlabName(filename, ranges[r].slab, ".bin")));
+        MappedBinaryIndices ids(binarySlabName(filename, ranges[r].slab, ".map"));
+        if(ids.N()!=slabs.back()->N() || ranges[r].last>ids.N())
+          DUNE_THROW(BinaryFormatError, "Slab "<<ranges[r].slab<<" does not match its index map");
+        ownedIds.insert(ownedIds.end(), ids.values()+ranges[r].first, ids.values()+ranges[r].last);
+      }
+      const std::size_t owned = ownedIds.size();
+
+      // the global indices of the columns not owned by this process
+      IdMap ownedMap(owned);
+      for(std::size_t i=0; i<owned; ++i)
+        ownedMap[i] = std::make_pair(ownedIds[i], i);
+      std::sort(ownedMap.begin(), ownedMap.end());
+      std::vector<uint64_t> halo;
+      std::size_t nnz=0;
+      for(std::size_t r=0; r<ranges.size(); ++r) {
+        const uint64_t* rowPointers = slabs[r]->rowPointers();
+        const uint64_t* columns = slabs[r]->columnIndices();
+        for(uint64_t k=rowPointers[ranges[r].first]; k<rowPointers[ranges[r].last]; ++k, ++nnz)
+          if(!std::binary_search(ownedMap.begin(), ownedMap.end(), std::make_pair(columns[k], std::size_t(0)),
+                                 BinaryIdLess()))
+            halo.push_back(columns[k]);
+      }
+      std::sort(halo.begin(), halo.end());
+      halo.erase(std::unique(halo.begin(), halo.end()), halo.end());
+
+      // the neighbours are the owners of the halo and the processes
+      // having our indices in their halo
+      std::vector<int> owners;
+      binaryFindOwners(ownedIds, halo, owners, mpiComm);
+      const int procs = comm.communicator().size();
+      std::vector<int> sendFlags(procs, 0), recvFlags(procs, 0);
+      for(std::size_t i=0; i<owners.size(); ++i)
+        sendFlags[owners[i]] = 1;
+      MPI_Alltoall(&sendFlags[0], 1, MPI_INT, &recvFlags[0], 1, MPI_INT, mpiComm);
+      std::set<int> neighbours;
+      for(int p=0; p<procs; ++p)
+        if(sendFlags[p] || recvFlags[p])
+          neighbours.insert(p);
+
+      // local numbering: the owned rows in the order read, then the halo
+      matrix.setBuildMode(Matrix::row_wise);
+      matrix.setSize(owned+halo.size(), owned+halo.size(), nnz+halo.size());
+      typename Matrix::CreateIterator ci=matrix.createbegin();
+      for(std::size_t r=0; r<ranges.size(); ++r) {
+        const uint64_t* rowPointers = slabs[r]->rowPointers();
+        const uint64_t* columns = slabs[r]->columnIndices();
+        for(std::size_t i=ranges[r].first; i<ranges[r].last; ++i, ++ci)
+          for(uint64_t k=rowPointers[i]; k<rowPointers[i+1]; ++k)
+            ci.insert(binaryLocalIndex(columns[k], ownedMap, halo));
+      }
+      for(; ci!=matrix.createend(); ++ci)
+        ci.insert(ci.index());
+
+      std::size_t row=0;
+      for(std::size_t r=0; r<ranges.size(); ++r) {
+        const uint64_t* rowPointers = slabs[r]->rowPointers();
+        const uint64_t* columns = slabs[r]->columnIndices();
+        for(std::size_t i=ranges[r].first; i<ranges[r].last; ++i, ++row)
+          for(uint64_t k=rowPointers[i]; k<rowPointers[i+1]; ++k) {
+            const T* a = slabs[r]->values()+k*brows*bcols;
+            FieldMatrix<T,brows,bcols>& block = matrix[row][binaryLocalIndex(columns[k], ownedMap, halo)];
+            for(int s=0; s<brows; ++s)
+              for(int t=0; t<bcols; ++t)
+                block[s][t] = a[s*bcols+t];
+          }
+      }
+      // the copy rows are dirichlet rows
+      for(; row<matrix.N(); ++row) {
+        matrix[row][row] = 0;
+        for(int s=0; s<brows && s<bcols; ++s)
+          matrix[row][row][s][s] = 1;
+      }
+
+      pis.beginResize();
+      for(std::size_t i=0; i<owned; ++i)
+        pis.add(G(ownedIds[i]), LocalIndex(i, OwnerOverlapCopyAttributeSet::owner, true));
+      for(std::size_t i=0; i<halo.size(); ++i)
+        pis.add(G(halo[i]), LocalIndex(owned+i, OwnerOverlapCopyAttributeSet::copy, true));
+      pis.endResize();
+
+      comm.remoteIndices().setNeighbours(neighbours);
+      comm.remoteIndices().template rebuild<false>();
+    }
+
+    /**
+     * @brief Read this process' part of a distributed vector.
+     *
+     * The distribution has to be set up by loading the matrix stored
+     * together with the vector.
+     */
+    template<typename T, typename A, int entries, typename G, typename L>
+    void readBinarySlabs(BlockVector<FieldVector<T,entries>,A>& vector,
+                         const std::string& filename,
+                         OwnerOverlapCopyCommunication<G,L>& comm)
+    {
+      typedef BlockVector<FieldVector<T,entries>,A> Vector;
+      typedef typename OwnerOverlapCopyCommunication<G,L>::ParallelIndexSet IndexSet;
+      typedef typename IndexSet::const_iterator Iterator;
+
+      std::vector<BinarySlabRange> ranges;
+      binarySlabRanges(filename, comm.communicator().rank(), comm.communicator().size(), ranges);
+
+      const IndexSet& pis = comm.indexSet();
+      std::vector<uint64_t> globalIds(pis.size());
+      for(Iterator iter=pis.begin(); iter!=pis.end(); ++iter)
+        globalIds[iter->local()] = iter->global();
+
+      vector.resize(pis.size());
+      vector = 0;
+      std::size_t row=0;
+      for(std::size_t r=0; r<ranges.size(); ++r) {
+        MappedBinaryVector<Vector> slab(binarySlabName(filename, ranges[r].slab, ".bin"));
+        MappedBinaryIndices ids(binarySlabName(filename, ranges[r].slab, ".map"));
+        if(ids.N()!=slab.N() || ranges[r].last>ids.N())
+          DUNE_THROW(BinaryFormatError, "Slab "<<ranges[r].slab<<" does not match its index map");
+        for(std::size_t i=ranges[r].first; i<ranges[r].last; ++i, ++row) {
+          if(row>=globalIds.size() || globalIds[row]!=ids.values()[i])
+            DUNE_THROW(ISTLError, "The vector "<<filename<<" was not stored with the matrix "
+                       "the index set was loaded from");
+          for(int k=0; k<entries; ++k)
+            vector[row][k] = slab.values()[i*entries+k];
+        }
+      }
+      comm.copyOwnerToAll(vector, vector);
+    }
+  } // end namespace BinaryIODetail
+
+  /**
+   * @brief Store a distributed matrix/vector in the binary format.
+   *
+   * Every process writes the rows it owns with global column indices
+   * to the slab filename_rank.bin and the global indices of the rows to
+   * filename_rank.map. Process 0 writes the number of rows of all slabs
+   * to filename.slabs. The global indices have to be nonnegative integers.
+   *
+   * @param matrix The matrix/vector to store.
+   * @param filename The name of the dataset.
+   * @param comm The information about the data distribution.
+   */
+  template<typename M, typename G, typename L>
+  void storeBinary(const M& matrix, const std::string& filename,
+                   const OwnerOverlapCopyCommunication<G,L>& comm)
+  {
+    const int rank = comm.communicator().rank();
+    std::vector<uint64_t> globalIds;
+    std::vector<std::size_t> owned;
+    BinaryIODetail::binaryOwnedIndices(comm, matrix.N(), globalIds, owned);
+    uint64_t globalSize = globalIds.empty() ? 0 : *std::max_element(globalIds.begin(), globalIds.end())+1;
+    globalSize = comm.communicator().max(globalSize);
+
+    std::ofstream file(BinaryIODetail::binarySlabName(filename, rank, ".bin").c_str(), std::ios::out | std::ios::binary);
+    if(!file)
+      DUNE_THROW(IOError, "Could not open file " << BinaryIODetail::binarySlabName(filename, rank, ".bin"));
+    BinaryIODetail::writeBinarySlab(matrix, globalIds, owned, globalSize, file);
+    file.close();
+
+    std::vector<uint64_t> ids(owned.size());
+    for(std::size_t i=0; i<owned.size(); ++i)
+      ids[i] = globalIds[owned[i]];
+    file.open(BinaryIODetail::binarySlabName(filename, rank, ".map").c_str(), std::ios::out | std::ios::binary);
+    writeBinary(ids, file);
+    file.close();
+
+    uint64_t rows = owned.size();
+    std::vector<uint64_t> counts(comm.communicator().size());
+    MPI_Gather(&rows, 1, MPI_UINT64_T, &counts[0], 1, MPI_UINT64_T, 0, comm.communicator());
+    if(rank==0) {
+      file.open((filename+".slabs").c_str(), std::ios::out | std::ios::binary);
+      writeBinary(counts, file);
+      file.close();
+    }
+    comm.communicator().barrier();
+  }
+
+  /**
+   * @brief Load a distributed matrix/vector stored with storeBinary.
+   *
+   * The dataset may have been written by any number of processes. The
+   * rows of all slabs are split into contiguous ranges of equal size,
+   * one per process, which are read via mmap. For a matrix the index set
+   * of comm (which has to be empty) is set up with the rows read as
+   * owner indices and the other referenced indices as copy indices
+   * with unit rows, and the remote indices are rebuilt. A vector has to
+   * be loaded after the matrix stored with it.
+   *
+   * @param matrix Where to store the matrix/vector.
+   * @param filename The name of the dataset.
+   * @param comm The information about the data distribution.
+   */
+  template<typename M, typename G, typename L>
+  void loadBinary(M& matrix, const std::string& filename,
+                  OwnerOverlapCopyCommunication<G,L>& comm)
+  {
+    BinaryIODetail::readBinarySlabs(matrix, filename, comm);
+  }
+#endif
+
+  /** @} */
+}
+#endif
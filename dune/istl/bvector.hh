@@ -7,7 +7,9 @@
 #include <cmath>
 #include <complex>
 #include <memory>
+#include <algorithm>
 #include <limits>
+#include <vector>
 
 #include <dune/common/promotiontraits.hh>
 #include <dune/common/dotproduct.hh>
@@ -563,6 +565,193 @@ namespace Dune {
     return s;
   }
 
+  /**
+     \brief Compute several dot products \f$ x_k^H y_k \f$.
+
+     Generic version for arbitrary vector types, which computes the
+     products one after the other.
+   */
+  template<class X, class K>
+  void fusedDots (const std::vector<const X*>& x, const std::vector<const X*>& y,
+                  std::vector<K>& result)
+  {
+    result.resize(x.size());
+    for (typename std::vector<const X*>::size_type k=0; k<x.size(); ++k)
+      result[k] = x[k]->dot(*y[k]);
+  }
+
+  /**
+     \brief Compute several dot products \f$ x_k^H y_k \f$ of block vectors
+     in a single sweep over the vectors.
+   */
+  template<class B, class A, class K>
+  void fusedDots (const std::vector<const BlockVector<B,A>*>& x,
+                  const std::vector<const BlockVector<B,A>*>& y,
+                  std::vector<K>& result)
+  {
+    typedef typename BlockVector<B,A>::size_type size_type;
+    typedef typename std::vector<const BlockVector<B,A>*>::size_type index_type;
+
+    result.assign(x.size(),K(0));
+    if (x.empty())
+      return;
+    // process the vectors in chunks small enough to stay in the cache
+    const size_type n = x[0]->N();
+    const size_type chunk = 256;
+    for (size_type begin=0; begin<n; begin+=chunk)
+    {
+      const size_type end = std::min(begin+chunk,n);
+      for (index_type k=0; k<x.size(); ++k)
+      {
+        const BlockVector<B,A>& xk = *x[k];
+        const BlockVector<B,A>& yk = *y[k];
+        for (size_type i=begin; i<end; ++i)
+          result[k] += xk[i].dot(yk[i]);
+      }
+    }
+  }
+
+  /**
+     \brief Compute \f$ y = y + \sum_k a_k x_k \f$.
+
+     Generic version for arbitrary vector types, which does one axpy
+     per vector.
+   */
+  template<class Y, class K, class X>
+  void fusedAxpy (Y& y, const std::vector<K>& a, const std::vector<const X*>& x)
+  {
+    for (typename std::vector<const X*>::size_type k=0; k<x.size(); ++k)
+      y.axpy(a[k],*x[k]);
+  }
+
+  /**
+     \brief Compute \f$ y = y + \sum_k a_k x_k \f$ for block vectors
+     in a single sweep over the vectors.
+   */
+  template<class B, class A, class K>
+  void fusedAxpy (BlockVector<B,A>& y, const std::vector<K>& a,
+                  const std::vector<const BlockVector<B,A>*>& x)
+  {
+    typedef typename BlockVector<B,A>::size_type size_type;
+    typedef typename std::vector<const BlockVector<B,A>*>::size_type index_type;
+
+    // process the vectors in chunks small enough to stay in the cache
+    const size_type n = y.N();
+    const size_type chunk = 256;
+    for (size_type begin=0; begin<n; begin+=chunk)
+    {
+      const size_type end = std::min(begin+chunk,n);
+      for (index_type k=0; k<x.size(); ++k)
+      {
+        const BlockVector<B,A>& xk = *x[k];
+        for (size_type i=begin; i<end; ++i)
+          y[i].axpy(a[k],xk[i]);
+      }
+    }
+  }
+
+  /**
+     \brief Compute \f$ y = b y + \sum_k a_k x_k \f$.
+
+     Generic version for arbitrary vector types, which scales y and then
+     does one axpy per vector.
+   */
+  template<class Y, class K, class X>
+  void fusedAxpby (Y& y, const K& b, const std::vector<K>& a, const std::vector<const X*>& x)
+  {
+    y *= b;
+    fusedAxpy(y,a,x);
+  }
+
+  /**
+     \brief Compute \f$ y = b y + \sum_k a_k x_k \f$ for block vectors
+     in a single sweep over the vectors.
+   */
+  template<class B, class A, class K>
+  void fusedAxpby (BlockVector<B,A>& y, const K& b, const std::vector<K>& a,
+                   const std::vector<const BlockVector<B,A>*>& x)
+  {
+    typedef typename BlockVector<B,A>::size_type size_type;
+    typedef typename std::vector<const BlockVector<B,A>*>::size_type index_type;
+
+    // process the vectors in chunks small enough to stay in the cache
+    const size_type n = y.N();
+    const size_type chunk = 256;
+    for (size_type begin=0; begin<n; begin+=chunk)
+    {
+      const size_type end = std::min(begin+chunk,n);
+      for (size_type i=begin; i<end; ++i)
+        y[i] *= b;
+      for (index_type k=0; k<x.size(); ++k)
+      {
+        const BlockVector<B,A>& xk = *x[k];
+        for (size_type i=begin; i<end; ++i)
+          y[i].axpy(a[k],xk[i]);
+      }
+    }
+  }
+
+  /**
+     \brief Compute \f$ y = y + a x \f$ and return \f$ \|y\|^2 \f$.
+
+     Generic version for arbitrary vector types, which does the update
+     and the norm one after the other.
+   */
+  template<class Y, class K>
+  typename FieldTraits<typename Y::field_type>::real_type
+  fusedAxpyNorm2 (Y& y, const K& a, const Y& x)
+  {
+    y.axpy(a,x);
+    return y.two_norm2();
+  }
+
+  /**
+     \brief Compute \f$ y = y + a x \f$ and return \f$ \|y\|^2 \f$
+     for block vectors in a single sweep over the vectors.
+   */
+  template<class B, class A, class K>
+  typename FieldTraits<typename BlockVector<B,A>::field_type>::real_type
+  fusedAxpyNorm2 (BlockVector<B,A>& y, const K& a, const BlockVector<B,A>& x)
+  {
+    typedef typename BlockVector<B,A>::size_type size_type;
+
+    typename FieldTraits<typename BlockVector<B,A>::field_type>::real_type sum=0;
+    for (size_type i=0; i<y.N(); ++i)
+    {
+      y[i].axpy(a,x[i]);
+      sum += y[i].two_norm2();
+    }
+    return sum;
+  }
+
+  /**
+     \brief Copy a vector into a vector with a different field type.
+
+     Generic version for the innermost blocks, which copies the entries
+     one by one.
+   */
+  template<class Y, class X>
+  void convertVector (Y& y, const X& x)
+  {
+    typedef typename Y::field_type field_type;
+    for (typename X::size_type i=0; i<x.size(); ++i)
+      y[i] = static_cast<field_type>(x[i]);
+  }
+
+  /**
+     \brief Copy a block vector into a block vector with a different
+     field type, e.g. double into float for mixed precision computations.
+
+     The destination is resized to the size of the source.
+   */
+  template<class B1, class A1, class B2, class A2>
+  void convertVector (BlockVector<B1,A1>& y, const BlockVector<B2,A2>& x)
+  {
+    y.resize(x.N(),false);
+    for (typename BlockVector<B2,A2>::size_type i=0; i<x.N(); ++i)
+      convertVector(y[i],x[i]);
+  }
+
   /** BlockVectorWindow adds window manipulation functions
           to the block_vector_unmanaged template.
 
@@ -249,6 +249,136 @@ namespace Dune {
   }
 
 
+  //! compute C -= A^T B for two blocks of an incomplete Cholesky decomposition
+  template<class K, int n>
+  void bic0_mmtm (const FieldMatrix<K,n,n>& A, const FieldMatrix<K,n,n>& B,
+                  FieldMatrix<K,n,n>& C)
+  {
+    for (int r=0; r<n; ++r)
+      for (int c=0; c<n; ++c)
+        for (int k=0; k<n; ++k)
+          C[r][c] -= A[k][r]*B[k][c];
+  }
+
+  /*! Incomplete Cholesky decomposition IC(0)
+          Computes the block incomplete Cholesky decomposition
+      \f$ A \approx U^T D^{-1} U \f$ of a real symmetric matrix A on the
+      sparsity pattern of A, where D is the block diagonal of U.
+      Only the upper triangle of A is read and only the upper triangle
+      U is stored. The diagonal blocks of U are overwritten by the inverse
+      of D. The matrix U should be an empty matrix in row_wise creation mode.
+   */
+  template<class M>
+  void bic0_decomposition (const M& A, M& U)
+  {
+    // iterator types
+    typedef typename M::RowIterator rowiterator;
+    typedef typename M::ColIterator coliterator;
+    typedef typename M::ConstRowIterator crowiterator;
+    typedef typename M::ConstColIterator ccoliterator;
+    typedef typename M::CreateIterator createiterator;
+    typedef typename M::block_type block;
+
+    // the pattern of U is the upper triangle of A
+    crowiterator endi=A.end();
+    createiterator ci=U.createbegin();
+    for (crowiterator i=A.begin(); i!=endi; ++i, ++ci)
+      for (ccoliterator j=(*i).begin(); j!=(*i).end(); ++j)
+        if (j.index()>=i.index())
+          ci.insert(j.index());
+
+    // copy entries of A
+    for (rowiterator i=U.begin(); i!=U.end(); ++i)
+    {
+      if ((*i).begin()==(*i).end() || (*i).begin().index()!=i.index())
+        DUNE_THROW(ISTLError,"diagonal entry missing");
+      ccoliterator Aij = A[i.index()].find(i.index());
+      coliterator endUij = (*i).end();
+      for (coliterator Uij=(*i).begin(); Uij!=endUij; ++Uij, ++Aij)
+        *Uij = *Aij;
+    }
+
+    // right looking variant: row k updates all rows i>k with U_ki!=0
+    for (rowiterator k=U.begin(); k!=U.end(); ++k)
+    {
+      coliterator kk=(*k).begin();           // diagonal is first entry
+      coliterator endk=(*k).end();
+      block dinv(*kk);
+      try {
+        dinv.invert();   // compute inverse of diagonal block
+      }
+      catch (Dune::FMatrixError & e) {
+        DUNE_THROW(MatrixBlockError, "IC failed to invert matrix block A["
+                   << k.index() << "][" << k.index() << "]" << e.what();
+                   th__ex.r=k.index(); th__ex.c=k.index(););
+      }
+
+      coliterator ki=kk;
+      for (++ki; ki!=endk; ++ki)
+      {
+        // T = D_k^-1 U_ki, i.e. T^T = L_ik
+        block T(*ki);
+        T.leftmultiply(dinv);
+
+        // U_ij -= L_ik U_kj for all j>=i in the pattern
+        coliterator ij=U[ki.index()].begin();
+        coliterator endij=U[ki.index()].end();
+        coliterator kj=ki;
+        while (ij!=endij && kj!=endk)
+          if (ij.index()==kj.index())
+          {
+            bic0_mmtm(T,*kj,*ij);
+            ++ij; ++kj;
+          }
+          else
+          {
+            if (ij.index()<kj.index())
+              ++ij;
+            else
+              ++kj;
+          }
+      }
+      *kk = dinv;   // store the inverse in U
+    }
+  }
+
+  //! backsolve \f$ U^T D^{-1} U v = d \f$ with IC(0) decomposition from bic0_decomposition
+  template<class M, class X, class Y>
+  void bic0_backsolve (const M& U, X& v, const Y& d)
+  {
+    // iterator types
+    typedef typename M::ConstRowIterator rowiterator;
+    typedef typename M::ConstColIterator coliterator;
+    typedef typename X::block_type vblock;
+
+    // lower triangular solve with U^T D^-1, done column wise on the rows of U
+    rowiterator endi=U.end();
+    for (rowiterator i=U.begin(); i!=endi; ++i)
+      v[i.index()] = d[i.index()];
+    vblock w;
+    for (rowiterator k=U.begin(); k!=endi; ++k)
+    {
+      coliterator kj=(*k).begin();
+      coliterator endkj=(*k).end();
+      (*kj).mv(v[k.index()],w);           // w = D_k^-1 v_k, diagonal stores inverse!
+      for (++kj; kj!=endkj; ++kj)
+        (*kj).mmtv(w,v[kj.index()]);
+    }
+
+    // upper triangular solve
+    rowiterator rendi=U.beforeBegin();
+    for (rowiterator i=U.beforeEnd(); i!=rendi; --i)
+    {
+      vblock rhs(v[i.index()]);
+      coliterator j;
+      for (j=(*i).beforeEnd(); j.index()>i.index(); --j)
+        (*j).mmv(v[j.index()],rhs);
+      v[i.index()] = 0;
+      (*j).umv(rhs,v[i.index()]);           // diagonal stores inverse!
+    }
+  }
+
+
   /** @} end documentation */
 
 } // end namespace
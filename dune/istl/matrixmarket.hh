@@ -3,12 +3,23 @@
 #ifndef DUNE_MATRIXMARKET_HH
 #define DUNE_MATRIXMARKET_HH
 
+#include <algorithm>
+#include <cctype>
+#include <complex>
+#include <cstdlib>
 #include <ostream>
 #include <istream>
 #include <fstream>
 #include <sstream>
 #include <limits>
 #include <ios>
+#include <string>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include "matrixutils.hh"
 #include "bcrsmatrix.hh"
 #include "owneroverlapcopy.hh"
@@ -33,6 +44,8 @@ namespace Dune
    * Using storeMartrixMarket and loadMatrixMarket one can store and load a parallel ISTL
    * matrix in MatrixMarket format. The latter can even read a matrix written with
    * writeMatrixToMatlab.
+   * storeBinary and loadBinary write and read matrices and vectors in a
+   * native binary format that can be memory mapped.
    *
    *
    * @addtogroup ISTL_IO
@@ -44,6 +57,9 @@ namespace Dune
    * @brief Provides classes for reading and writing MatrixMarket Files with
    * an extension for parallel matrices.
    */
+  class MatrixMarketFormatError : public Dune::Exception
+  {};
+
   namespace
   {
     /**
@@ -488,6 +504,7 @@ namespace Dune
           file.ignore(std::numeric_limits<std::streamsize>::max(),'\n');
           return false;
         }
+        break;
       default :
         file.ignore(std::numeric_limits<std::streamsize>::max(),'\n');
         return false;
@@ -549,19 +566,6 @@ namespace Dune
       return Dune::make_tuple(blockrows, blockcols, blockentries);
     }
 
-    /*
-     *   @brief Storage class for the column index and the numeric value.
-     *
-     * \tparam T Either a NumericWrapper of the numeric type or PatternDummy
-     *     for MatrixMarket pattern case.
-     */
-    template<typename T>
-    struct IndexData : public T
-    {
-      std::size_t index;
-    };
-
-
     /**
      * @brief a wrapper class of numeric values.
      *
@@ -592,140 +596,410 @@ namespace Dune
     struct NumericWrapper<PatternDummy>
     {};
 
+    /*
+     *   @brief Storage class for the row and column index and the numeric value
+     *   of a matrix entry.
+     *
+     * \tparam D Either a NumericWrapper of the numeric type or
+     *     NumericWrapper<PatternDummy> for MatrixMarket pattern case.
+     */
+    template<typename D>
+    struct MMEntry : public D
+    {
+      std::size_t row;
+      std::size_t col;
+    };
+
+    /**
+     * @brief LessThan operator.
+     *
+     * Orders the entries of a row by their column index.
+     */
+    template<typename D>
+    bool operator<(const MMEntry<D>& e1, const MMEntry<D>& e2)
+    {
+      return e1.col<e2.col || (e1.col==e2.col && e1.row<e2.row);
+    }
+
+    /**
+     * @brief Parse a nonnegative integer from a buffer.
+     *
+     * Leading blanks are skipped, p points behind the number afterwards.
+     */
+    inline bool mm_parse_index(const char*& p, std::size_t& index)
+    {
+      while(*p==' ' || *p=='\t')
+        ++p;
+      if(*p<'0' || *p>'9')
+        return false;
+      index=0;
+      for(; *p>='0' && *p<='9'; ++p)
+        index = 10*index + (*p-'0');
+      return true;
+    }
+
+    /**
+     * @brief Skip blanks and tabs, but no line breaks.
+     *
+     * @return true if a token starts on the current line.
+     */
+    inline bool mm_skip_blanks(const char*& p)
+    {
+      while(*p==' ' || *p=='\t')
+        ++p;
+      return *p && !std::isspace(static_cast<unsigned char>(*p));
+    }
+
+    //! Read the next token of the current line with a stream.
+    template<typename T>
+    bool mm_parse_token(const char*& p, T& number)
+    {
+      if(!mm_skip_blanks(p))
+        return false;
+      const char* begin=p;
+      while(*p && !std::isspace(static_cast<unsigned char>(*p)))
+        ++p;
+      std::istringstream is(std::string(begin,p));
+      return static_cast<bool>(is>>number);
+    }
+
+    /**
+     * @brief Parse a number from a buffer.
+     *
+     * Only blanks are skipped, a number missing on the current line is
+     * an error. The generic version reads the next token with a stream.
+     */
     template<typename T>
-    std::istream& operator>>(std::istream& is, NumericWrapper<T>& num)
+    bool mm_parse_number(const char*& p, T& number)
     {
-      return is>>num.number;
+      return mm_parse_token(p, number);
     }
 
-    std::istream& operator>>(std::istream& is, NumericWrapper<PatternDummy>& num)
+    inline bool mm_parse_number(const char*& p, double& number)
     {
-      DUNE_UNUSED_PARAMETER(num);
-      return is;
+      if(!mm_skip_blanks(p))
+        return false;
+      char* end;
+      number=std::strtod(p, &end);
+      bool parsed = end!=p;
+      p=end;
+      return parsed;
+    }
+
+    inline bool mm_parse_number(const char*& p, float& number)
+    {
+      if(!mm_skip_blanks(p))
+        return false;
+      char* end;
+      number=std::strtof(p, &end);
+      bool parsed = end!=p;
+      p=end;
+      return parsed;
+    }
+
+    inline bool mm_parse_number(const char*& p, long double& number)
+    {
+      if(!mm_skip_blanks(p))
+        return false;
+      char* end;
+      number=std::strtold(p, &end);
+      bool parsed = end!=p;
+      p=end;
+      return parsed;
+    }
+
+    inline bool mm_parse_number(const char*& p, int& number)
+    {
+      if(!mm_skip_blanks(p))
+        return false;
+      char* end;
+      number=std::strtol(p, &end, 10);
+      bool parsed = end!=p;
+      p=end;
+      return parsed;
     }
 
     /**
-     * @brief LessThan operator.
+     * @brief Parse a complex number given by its real and imaginary part
+     * as in the MatrixMarket format.
      *
-     * It simply compares the index.
+     * The form (re,im) written by operator<< is accepted as well.
      */
     template<typename T>
-    bool operator<(const IndexData<T>& i1, const IndexData<T>& i2)
+    bool mm_parse_number(const char*& p, std::complex<T>& number)
+    {
+      if(!mm_skip_blanks(p))
+        return false;
+      if(*p=='(')
+        return mm_parse_token(p, number);
+      T re, im;
+      if(!mm_parse_number(p, re) || !mm_parse_number(p, im))
+        return false;
+      number=std::complex<T>(re, im);
+      return true;
+    }
+
+    template<typename T>
+    bool mm_parse_value(const char*& p, NumericWrapper<T>& num)
+    {
+      return mm_parse_number(p, num.number);
+    }
+
+    inline bool mm_parse_value(const char*& p, NumericWrapper<PatternDummy>& num)
+    {
+      DUNE_UNUSED_PARAMETER(p);
+      DUNE_UNUSED_PARAMETER(num);
+      return true;
+    }
+
+    template<typename T>
+    T mm_conj(const T& t)
+    {
+      return t;
+    }
+
+    template<typename T>
+    std::complex<T> mm_conj(const std::complex<T>& t)
     {
-      return i1.index<i2.index;
+      return std::conj(t);
     }
 
     /**
-     * @brief Read IndexData from a stream.
-     * @param is The input stream we read.
-     * @param data Where to store the read data.
+     * @brief Turn the value of an entry into the value of the mirrored
+     * entry of a symmetric, skew symmetric or hermitian matrix.
      */
     template<typename T>
-    std::istream& operator>>(std::istream& is, IndexData<T>& data)
+    void mm_mirror_value(NumericWrapper<T>& num, MM_STRUCTURE structure)
+    {
+      if(structure==skew_symmetric)
+        num.number = -num.number;
+      else if(structure==hermitian)
+        num.number = mm_conj(num.number);
+    }
+
+    inline void mm_mirror_value(NumericWrapper<PatternDummy>& num, MM_STRUCTURE structure)
+    {
+      DUNE_UNUSED_PARAMETER(num);
+      DUNE_UNUSED_PARAMETER(structure);
+    }
+
+    template<typename B, typename T>
+    void mm_set_value(B& block, std::size_t r, std::size_t c, const NumericWrapper<T>& num)
     {
-      is>>data.index;
-      /* MatrixMarket indices are one based. Decrement for C++ */
-      --data.index;
-      return is>>data.number;
+      block[r][c] = num.number;
+    }
+
+    template<typename B>
+    void mm_set_value(B& block, std::size_t r, std::size_t c, const NumericWrapper<PatternDummy>& num)
+    {
+      DUNE_UNUSED_PARAMETER(block);
+      DUNE_UNUSED_PARAMETER(r);
+      DUNE_UNUSED_PARAMETER(c);
+      DUNE_UNUSED_PARAMETER(num);
     }
 
     /**
-     * @brief Functor to the data values of the matrix.
+     * @brief Parse the coordinate entries in the buffer [p,end).
      *
-     * This is specialized for PatternDummy. The specialization does not
-     * set anything.
+     * The buffer has to start at the beginning of a line and be followed
+     * by a terminating zero or further lines.
+     * @return false if a line could not be parsed.
      */
-    template<typename D, int brows, int bcols>
-    struct MatrixValuesSetter
+    template<typename D>
+    bool mm_parse_entries(const char* p, const char* end, std::vector<MMEntry<D> >& entries)
     {
-      /**
-       * @brief Sets the matrixvalues.
-       * @param row The row data as read from file.
-       * @param matrix The matrix whose data we set.
-       */
-      template<typename M>
-      void operator()(const std::vector<std::set<IndexData<D> > >& rows,
-                      M& matrix)
-      {
-        for(typename M::RowIterator iter=matrix.begin();
-            iter!= matrix.end(); ++iter)
-        {
-          for(typename M::size_type brow=iter.index()*brows,
-              browend=iter.index()*brows+brows;
-              brow<browend; ++brow)
-          {
-            typedef typename std::set<IndexData<D> >::const_iterator Siter;
-            for(Siter siter=rows[brow].begin(), send=rows[brow].end();
-                siter != send; ++siter)
-              (*iter)[siter->index/bcols][brow%brows][siter->index%bcols]=siter->number;
-          }
+      while(p<end) {
+        // skip white space, empty lines and comments
+        if(std::isspace(static_cast<unsigned char>(*p))) {
+          ++p;
+          continue;
+        }
+        if(*p=='%') {
+          while(p<end && *p!='\n')
+            ++p;
+          continue;
         }
+        MMEntry<D> entry;
+        if(!mm_parse_index(p, entry.row) || !mm_parse_index(p, entry.col)
+           || !mm_parse_value(p, entry))
+          return false;
+        /* MatrixMarket indices are one based. Decrement for C++ */
+        if(entry.row==0 || entry.col==0)
+          return false;
+        --entry.row;
+        --entry.col;
+        entries.push_back(entry);
+        // disgard the rest of the line
+        while(p<end && *p!='\n')
+          ++p;
       }
-    };
+      return true;
+    }
 
-    template<int brows, int bcols>
-    struct MatrixValuesSetter<PatternDummy,brows,bcols>
+    /**
+     * @brief Read the rest of a stream into a buffer.
+     */
+    inline void mm_read_buffer(std::istream& istr, std::string& buffer)
     {
-      template<typename M>
-      void operator()(const std::vector<std::set<IndexData<PatternDummy> > >& rows,
-                      M& matrix)
-      {}
-    };
+      std::streampos start=istr.tellg();
+      if(start!=std::streampos(-1) && istr.seekg(0, std::ios::end)) {
+        std::streampos stop=istr.tellg();
+        istr.seekg(start);
+        buffer.resize(stop-start);
+        if(!buffer.empty())
+          istr.read(&buffer[0], buffer.size());
+        buffer.resize(istr.gcount());
+      }
+      else {
+        // not seekable, copy the stream buffer
+        istr.clear();
+        std::ostringstream os;
+        os<<istr.rdbuf();
+        buffer=os.str();
+      }
+    }
 
+    /**
+     * @brief Read the coordinate entries of a sparse matrix.
+     *
+     * The rest of the stream is read into memory and split into chunks
+     * at line boundaries, which are parsed in parallel if OpenMP is
+     * available. The entries are then sorted into the block rows by a
+     * counting sort. For symmetric, skew symmetric and hermitian
+     * matrices the mirrored entries are generated during the sort.
+     */
     template<typename T, typename A, int brows, int bcols, typename D>
     void readSparseEntries(Dune::BCRSMatrix<Dune::FieldMatrix<T,brows,bcols>,A>& matrix,
                            std::istream& file, std::size_t entries,
                            const MMHeader& mmHeader, const D&)
     {
       typedef Dune::BCRSMatrix<Dune::FieldMatrix<T,brows,bcols>,A> Matrix;
-      // First path
-      // store entries together with column index in a speparate
-      // data structure
-      std::vector<std::set<IndexData<D> > > rows(matrix.N()*brows);
-
-      for(; entries>0; --entries) {
-        std::size_t row;
-        IndexData<D> data;
-        skipComments(file);
-        file>>row;
-        --row; // Index was 1 based.
-        assert(row/bcols<matrix.N());
-        file>>data;
-        assert(data.index/bcols<matrix.M());
-        rows[row].insert(data);
+      typedef MMEntry<D> Entry;
+      const std::size_t blockrows=matrix.N();
+      const std::size_t blockcols=matrix.M();
+      const MM_STRUCTURE structure=mmHeader.structure;
+      if(structure==unknown_structure)
+        DUNE_THROW(Dune::NotImplemented, "Unknown matrix structure!");
+
+      std::string buffer;
+      mm_read_buffer(file, buffer);
+      const char* data=buffer.c_str();
+      const std::size_t size=buffer.size();
+
+      // split the buffer into chunks starting at the beginning of a line
+      int chunks=1;
+#ifdef _OPENMP
+      chunks=omp_get_max_threads();
+#endif
+      std::vector<std::size_t> bounds(chunks+1, size);
+      bounds[0]=0;
+      for(int t=1; t<chunks; ++t) {
+        std::size_t b=std::max(size*t/chunks, bounds[t-1]);
+        while(b>0 && b<size && data[b-1]!='\n')
+          ++b;
+        bounds[t]=b;
+      }
+
+      std::vector<std::vector<Entry> > parsed(chunks);
+      bool failed=false;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static,1)
+#endif
+      for(int t=0; t<chunks; ++t) {
+        parsed[t].reserve(entries/chunks+1);
+        if(!mm_parse_entries(data+bounds[t], data+bounds[t+1], parsed[t]))
+        {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+          failed=true;
+        }
       }
+      if(failed)
+        DUNE_THROW(MatrixMarketFormatError, "Could not parse the matrix entries");
+
+      // count the entries per block row
+      std::size_t read=0;
+      std::vector<std::size_t> offset(blockrows+1, 0);
+      for(int t=0; t<chunks; ++t) {
+        read+=parsed[t].size();
+        typedef typename std::vector<Entry>::const_iterator Iter;
+        for(Iter e=parsed[t].begin(); e!=parsed[t].end(); ++e) {
+          if(e->row/brows>=blockrows || e->col/bcols>=blockcols)
+            DUNE_THROW(MatrixMarketFormatError, "Entry ("<<e->row+1<<","<<e->col+1
+                       <<") is out of range");
+          ++offset[e->row/brows+1];
+          if(structure!=general && e->row!=e->col) {
+            if(e->col/brows>=blockrows || e->row/bcols>=blockcols)
+              DUNE_THROW(MatrixMarketFormatError, "Matrix is not square");
+            ++offset[e->col/brows+1];
+          }
+        }
+      }
+      if(read!=entries)
+        DUNE_THROW(MatrixMarketFormatError, "Expected "<<entries<<" entries, but found "<<read);
+      for(std::size_t i=0; i<blockrows; ++i)
+        offset[i+1]+=offset[i];
+
+      // sort the entries into the block rows
+      std::vector<Entry> sorted(offset[blockrows]);
+      std::vector<std::size_t> next(offset.begin(), offset.end()-1);
+      for(int t=0; t<chunks; ++t) {
+        typedef typename std::vector<Entry>::const_iterator Iter;
+        for(Iter e=parsed[t].begin(); e!=parsed[t].end(); ++e) {
+          sorted[next[e->row/brows]++]=*e;
+          if(structure!=general && e->row!=e->col) {
+            Entry mirrored(*e);
+            mirrored.row=e->col;
+            mirrored.col=e->row;
+            mm_mirror_value(mirrored, structure);
+            sorted[next[mirrored.row/brows]++]=mirrored;
+          }
+        }
+        std::vector<Entry>().swap(parsed[t]);
+      }
+
+      // sort each block row by column and count the blocks
+      const long rows=blockrows;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic,256)
+#endif
+      for(long i=0; i<rows; ++i)
+        std::sort(sorted.begin()+offset[i], sorted.begin()+offset[i+1]);
 
-      // TODO extend to capture the nongeneral cases.
-      if(mmHeader.structure!= general)
-        DUNE_THROW(Dune::NotImplemented, "Only general is supported right now!");
+      std::size_t nnz=0;
+      for(std::size_t i=0; i<blockrows; ++i)
+        for(std::size_t k=offset[i]; k<offset[i+1]; ++k)
+          if(k==offset[i] || sorted[k].col/bcols!=sorted[k-1].col/bcols)
+            ++nnz;
 
       // Setup the matrix sparsity pattern
-      int nnz=0;
+      matrix.setSize(blockrows, blockcols, nnz);
       for(typename Matrix::CreateIterator iter=matrix.createbegin();
           iter!= matrix.createend(); ++iter)
       {
-        for(std::size_t brow=iter.index()*brows, browend=iter.index()*brows+brows;
-            brow<browend; ++brow)
-        {
-          typedef typename std::set<IndexData<D> >::const_iterator Siter;
-          for(Siter siter=rows[brow].begin(), send=rows[brow].end();
-              siter != send; ++siter, ++nnz)
-            iter.insert(siter->index/bcols);
-        }
+        const std::size_t i=iter.index();
+        for(std::size_t k=offset[i]; k<offset[i+1]; ++k)
+          if(k==offset[i] || sorted[k].col/bcols!=sorted[k-1].col/bcols)
+            iter.insert(sorted[k].col/bcols);
       }
 
       //Set the matrix values
       matrix=0;
-
-      MatrixValuesSetter<D,brows,bcols> Setter;
-
-      Setter(rows, matrix);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic,256)
+#endif
+      for(long i=0; i<rows; ++i) {
+        typename Matrix::ColIterator col=matrix[i].begin();
+        for(std::size_t k=offset[i]; k<offset[i+1]; ++k) {
+          while(col.index()!=sorted[k].col/bcols)
+            ++col;
+          mm_set_value(*col, sorted[k].row%brows, sorted[k].col%bcols, sorted[k]);
+        }
+      }
     }
   } // end anonymous namespace
 
-  class MatrixMarketFormatError : public Dune::Exception
-  {};
-
 
   void mm_read_header(std::size_t& rows, std::size_t& cols, MMHeader& header, std::istream& istr,
                       bool isVector)
@@ -845,7 +1119,10 @@ namespace Dune
     if(header.type==array_type)
       DUNE_THROW(Dune::NotImplemented, "Array format currently not supported for matrices!");
 
-    readSparseEntries(matrix, istr, entries, header, NumericWrapper<T>());
+    if(header.ctype==pattern)
+      readSparseEntries(matrix, istr, entries, header, NumericWrapper<PatternDummy>());
+    else
+      readSparseEntries(matrix, istr, entries, header, NumericWrapper<T>());
   }
 
   template<typename M>
@@ -3,6 +3,9 @@
 #ifndef DUNE_MATRIXREDIST_HH
 #define DUNE_MATRIXREDIST_HH
 #include "repartition.hh"
+#include <algorithm>
+#include <memory>
+#include <vector>
 #include <dune/common/exceptions.hh>
 #include <dune/common/parallel/indexset.hh>
 #include <dune/common/unused.hh>
@@ -128,6 +131,7 @@ namespace Dune
     void resetSetup()
     {
       setup_=false;
+      resetValuePlan();
     }
 
     template<class GatherScatter, class D>
@@ -138,6 +142,68 @@ namespace Dune
       communicator.template forward<GatherScatter>(from, to);
       communicator.free();
     }
+
+    /**
+     * @brief Redistribute data with a communicator that is built on the
+     * first call and kept for the later ones.
+     *
+     * The message sizes are fixed by the first call, so the sizes of the
+     * data must not change until resetValuePlan() is called.
+     */
+    template<class GatherScatter, class D>
+    void redistributePersistent(const D& from, D& to) const
+    {
+      if(!valueCommunicator) {
+        valueCommunicator.reset(new BufferedCommunicator());
+        valueCommunicator->template build<D>(from,to, interface);
+      }
+      valueCommunicator->template forward<GatherScatter>(from, to);
+    }
+
+    //! @brief Whether the plan for value only redistribution is set up.
+    bool hasValuePlan() const
+    {
+      return !valueOffsets.empty();
+    }
+
+    //! @brief Forget the plan and the communicator for value only redistribution.
+    void resetValuePlan()
+    {
+      valueOffsets.clear();
+      valuePositions.clear();
+      valueCommunicator.reset();
+    }
+
+    /**
+     * @brief The offsets of the rows in getValuePositions().
+     *
+     * The entries of row i received during value only redistribution
+     * are described by the positions
+     * [getValueOffsets()[i], getValueOffsets()[i+1]).
+     */
+    std::vector<std::size_t>& getValueOffsets()
+    {
+      return valueOffsets;
+    }
+
+    const std::vector<std::size_t>& getValueOffsets() const
+    {
+      return valueOffsets;
+    }
+
+    /**
+     * @brief The position of each received entry in its row of the
+     * redistributed matrix or -1 if it is dropped.
+     */
+    std::vector<std::ptrdiff_t>& getValuePositions()
+    {
+      return valuePositions;
+    }
+
+    const std::vector<std::ptrdiff_t>& getValuePositions() const
+    {
+      return valuePositions;
+    }
     template<class GatherScatter, class D>
     void redistributeBackward(D& from, const D& to) const
     {
@@ -215,6 +281,9 @@ namespace Dune
     std::vector<std::size_t> rowSize;
     std::vector<std::size_t> copyrowSize;
     std::vector<std::size_t> backwardscopyrowSize;
+    std::vector<std::size_t> valueOffsets;
+    std::vector<std::ptrdiff_t> valuePositions;
+    mutable std::shared_ptr<BufferedCommunicator> valueCommunicator;
     RedistributeInterface interface;
     bool setup_;
   };
@@ -675,6 +744,182 @@ namespace Dune
   template<class M, class I>
   typename MatrixRowGatherScatter<M,I>::GlobalIndex MatrixRowGatherScatter<M,I>::numlimits;
 
+  /**
+   * @brief Utility class for computing where the entries of the
+   * communicated matrix rows are stored in the redistributed matrix.
+   *
+   * @tparam M The type of the matrix.
+   * @tparam I The type of the ParallelIndexSet.
+   */
+  template<class M, class I>
+  struct CommMatrixValuePlan
+    : public CommMatrixRow<M,I>
+  {
+    /**
+     * @brief Constructor for the sending side.
+     * @param m_ The local original matrix.
+     * @param idxset_ The index set for the original matrix.
+     * @param aggidxset_ The index set for the redistributed matrix.
+     */
+    CommMatrixValuePlan(M& m_, const Dune::GlobalLookupIndexSet<I>& idxset_, const I& aggidxset_)
+      : CommMatrixRow<M,I>(m_, idxset_, aggidxset_), offsets(), positions()
+    {}
+
+    /**
+     * @brief Constructor for the receiving side.
+     * @param m_ The redistributed matrix.
+     * @param idxset_ The index set for the original matrix.
+     * @param aggidxset_ The index set for the redistributed matrix.
+     * @param rowsize_ The sizes of the received rows.
+     * @param offsets_ The offsets of the rows in positions_.
+     * @param positions_ Where to store the positions of the received entries.
+     */
+    CommMatrixValuePlan(M& m_, const Dune::GlobalLookupIndexSet<I>& idxset_, const I& aggidxset_,
+                        std::vector<size_t>& rowsize_, const std::vector<std::size_t>& offsets_,
+                        std::vector<std::ptrdiff_t>& positions_)
+      : CommMatrixRow<M,I>(m_, idxset_, aggidxset_, rowsize_), offsets(&offsets_),
+        positions(&positions_)
+    {}
+
+    /** @brief The offsets of the rows in positions. */
+    const std::vector<std::size_t>* offsets;
+    /** @brief The positions of the received entries in their rows. */
+    std::vector<std::ptrdiff_t>* positions;
+  };
+
+  template<class M, class I>
+  struct CommPolicy<CommMatrixValuePlan<M,I> >
+  {
+    typedef CommMatrixValuePlan<M,I> Type;
+
+    /** @brief The global index of the column of each entry. */
+    typedef typename I::GlobalIndex IndexedType;
+
+    /** @brief Each row varies in size. */
+    typedef VariableSize IndexedTypeFlag;
+
+    static std::size_t getSize(const Type& t, std::size_t i)
+    {
+      return CommPolicy<CommMatrixRow<M,I> >::getSize(t, i);
+    }
+  };
+
+  template<class M, class I>
+  struct MatrixValuePlanGatherScatter
+  {
+    typedef typename I::GlobalIndex GlobalIndex;
+    typedef CommMatrixValuePlan<M,I> Container;
+
+    static const GlobalIndex& gather(const Container& cont, std::size_t i, std::size_t j)
+    {
+      // same entries as MatrixRowGatherScatter sends
+      return MatrixRowGatherScatter<M,I>::gather(cont, i, j).first;
+    }
+
+    static void scatter(Container& cont, const GlobalIndex& global, std::size_t i, std::size_t j)
+    {
+      std::ptrdiff_t& position = (*cont.positions)[(*cont.offsets)[i]+j];
+      position = -1;
+      if (global == std::numeric_limits<GlobalIndex>::max())
+        return;
+      typename M::size_type column;
+      try{
+        column=cont.aggidxset.at(global).local();
+      }
+      catch(Dune::RangeError er) {
+        // This an overlap row and might therefore lack some entries!
+        return;
+      }
+      const typename M::size_type* begin = cont.matrix[i].getindexptr();
+      const typename M::size_type* end = begin+cont.matrix[i].size();
+      const typename M::size_type* found = std::lower_bound(begin, end, column);
+      if (found!=end && *found==column)
+        position = found-begin;
+    }
+  };
+
+  /**
+   * @brief Utility class for communicating only the values of the matrix
+   * entries, see redistributeMatrixValues().
+   *
+   * @tparam M The type of the matrix.
+   */
+  template<class M>
+  struct CommMatrixValues
+  {
+    /**
+     * @brief Constructor for the sending side.
+     * @param m_ The local original matrix.
+     */
+    explicit CommMatrixValues(M& m_)
+      : matrix(m_), rowsize(), offsets(), positions()
+    {}
+
+    /**
+     * @brief Constructor for the receiving side.
+     * @param m_ The redistributed matrix.
+     * @param rowsize_ The sizes of the received rows.
+     * @param offsets_ The offsets of the rows in positions_.
+     * @param positions_ The positions of the received entries in their rows.
+     */
+    CommMatrixValues(M& m_, const std::vector<size_t>& rowsize_,
+                     const std::vector<std::size_t>& offsets_,
+                     const std::vector<std::ptrdiff_t>& positions_)
+      : matrix(m_), rowsize(&rowsize_), offsets(&offsets_), positions(&positions_)
+    {}
+
+    /** @brief The matrix to communicate the values of. */
+    M& matrix;
+    /** @brief row size information for the receiving side. */
+    const std::vector<size_t>* rowsize;
+    /** @brief The offsets of the rows in positions. */
+    const std::vector<std::size_t>* offsets;
+    /** @brief The positions of the received entries in their rows. */
+    const std::vector<std::ptrdiff_t>* positions;
+  };
+
+  template<class M>
+  struct CommPolicy<CommMatrixValues<M> >
+  {
+    typedef CommMatrixValues<M> Type;
+
+    /** @brief Only the matrix block is sent. */
+    typedef typename M::block_type IndexedType;
+
+    /** @brief Each row varies in size. */
+    typedef VariableSize IndexedTypeFlag;
+
+    static std::size_t getSize(const Type& t, std::size_t i)
+    {
+      if(!t.rowsize)
+        return t.matrix[i].size();
+      else
+      {
+        assert((*t.rowsize)[i]>0);
+        return (*t.rowsize)[i];
+      }
+    }
+  };
+
+  template<class M>
+  struct MatrixValuesGatherScatter
+  {
+    typedef CommMatrixValues<M> Container;
+    typedef typename M::block_type Block;
+
+    static const Block& gather(const Container& cont, std::size_t i, std::size_t j)
+    {
+      return cont.matrix[i].getptr()[j];
+    }
+
+    static void scatter(Container& cont, const Block& data, std::size_t i, std::size_t j)
+    {
+      std::ptrdiff_t position = (*cont.positions)[(*cont.offsets)[i]+j];
+      if (position>=0)
+        cont.matrix[i].getptr()[position]=data;
+    }
+  };
+
   template<typename M, typename C>
   void redistributeSparsityPattern(M& origMatrix, M& newMatrix, C& origComm, C& newComm,
                                    RedistributeInformation<C>& ri)
@@ -838,12 +1083,80 @@ namespace Dune
   void redistributeMatrix(M& origMatrix, M& newMatrix, C& origComm, C& newComm,
                           RedistributeInformation<C>& ri)
   {
+    ri.resetValuePlan();
     ri.setNoRows(newComm.indexSet().size());
     ri.setNoCopyRows(newComm.indexSet().size());
     ri.setNoBackwardsCopyRows(origComm.indexSet().size());
     redistributeSparsityPattern(origMatrix, newMatrix, origComm, newComm, ri);
     redistributeMatrixEntries(origMatrix, newMatrix, origComm, newComm, ri);
   }
+
+  /**
+   * @brief Redistribute the values of a matrix whose sparsity pattern
+   * has already been redistributed.
+   *
+   * The matrix has to have the same sparsity pattern as in the call of
+   * redistributeMatrix() that set up newMatrix and ri. On the first
+   * call the position of each communicated entry in the redistributed
+   * matrix is computed and stored in ri. Afterwards only the matrix
+   * blocks are sent, with a communicator that is kept in ri.
+   *
+   * For nonoverlapping communication the copy rows contribute entries,
+   * too. In that case the entries are redistributed with
+   * redistributeMatrixEntries() instead, which still skips the
+   * communication of the row sizes and the sparsity pattern.
+   *
+   * @param origMatrix The matrix on the original partitioning.
+   * @param newMatrix The redistributed matrix to store the new values in.
+   * @param origComm The parallel information of the original partitioning.
+   * @param newComm The parallel information of the new partitioning.
+   * @param ri The redistribution information used by redistributeMatrix().
+   */
+  template<typename M, typename C>
+  void redistributeMatrixValues(M& origMatrix, M& newMatrix, C& origComm, C& newComm,
+                                RedistributeInformation<C>& ri)
+  {
+    typedef typename C::ParallelIndexSet IndexSet;
+
+    if (origComm.getSolverCategory() == SolverCategory::nonoverlapping) {
+      // restore the copy to owner interface expected by redistributeMatrixEntries
+      typename C::CopySet copyflags;
+      typename C::OwnerSet ownerflags;
+      RemoteIndices<IndexSet> ris(origComm.indexSet(), newComm.indexSet(),
+                                  origComm.communicator());
+      ris.template rebuild<true>();
+      ri.getInterface().free();
+      ri.getInterface().build(ris,copyflags,ownerflags);
+      redistributeMatrixEntries(origMatrix, newMatrix, origComm, newComm, ri);
+      return;
+    }
+
+    std::vector<typename M::size_type> rowsize(newComm.indexSet().size(), 0);
+    for (std::size_t i=0; i < newComm.indexSet().size(); i++)
+      rowsize[i] = ri.getRowSize(i);
+
+    if (!ri.hasValuePlan()) {
+      std::vector<std::size_t>& offsets = ri.getValueOffsets();
+      offsets.resize(rowsize.size()+1);
+      offsets[0]=0;
+      for (std::size_t i=0; i < rowsize.size(); i++)
+        offsets[i+1] = offsets[i]+rowsize[i];
+      ri.getValuePositions().assign(offsets.back(), -1);
+
+      origComm.buildGlobalLookup();
+      CommMatrixValuePlan<M,IndexSet>
+      origplan(origMatrix, origComm.globalLookup(), newComm.indexSet());
+      CommMatrixValuePlan<M,IndexSet>
+      newplan(newMatrix, origComm.globalLookup(), newComm.indexSet(), rowsize,
+              offsets, ri.getValuePositions());
+      ri.template redistribute<MatrixValuePlanGatherScatter<M,IndexSet> >(origplan,newplan);
+    }
+
+    CommMatrixValues<M> origvalues(origMatrix);
+    CommMatrixValues<M> newvalues(newMatrix, rowsize, ri.getValueOffsets(),
+                                  ri.getValuePositions());
+    ri.template redistributePersistent<MatrixValuesGatherScatter<M> >(origvalues,newvalues);
+  }
 #endif
 }
 #endif
@@ -77,9 +77,6 @@ namespace Dune {
     typedef typename RIL::const_iterator RILIterator;
     typedef typename M::ConstColIterator ColIterator;
     typedef typename M::ConstRowIterator RowIterator;
-    typedef std::multimap<int,int> MM;
-    typedef std::multimap<int,std::pair<int,RILIterator> > RIMap;
-    typedef typename RIMap::iterator RIMapit;
 
     enum {
       //! \brief The solver category.
@@ -101,8 +98,7 @@ namespace Dune {
     virtual void apply (const X& x, Y& y) const
     {
       y = 0;
-      novlp_op_apply(x,y,1);
-      communication.addOwnerCopyToOwnerCopy(y,y);
+      novlp_op_apply_consistent(x,y,1);
     }
 
     //! apply operator to x, scale and add:  \f$ y = y + \alpha A(x) \f$
@@ -112,8 +108,7 @@ namespace Dune {
       // y already has to be consistent.
       Y y1(y);
       y = 0;
-      novlp_op_apply(x,y,alpha);
-      communication.addOwnerCopyToOwnerCopy(y,y);
+      novlp_op_apply_consistent(x,y,alpha);
       y += y1;
     }
 
@@ -124,19 +119,59 @@ namespace Dune {
     }
 
     void novlp_op_apply (const X& x, Y& y, field_type alpha) const
+    {
+      novlp_op_setup(x.size());
+
+      //compute alpha*A*x nonoverlapping case
+      for (RowIterator i = _A_.begin(); i != _A_.end(); ++i)
+        novlp_row_apply(i.index(),x,y,alpha);
+    }
+
+  private:
+    /**
+     * @brief Compute alpha*A*x and make it consistent.
+     *
+     * The rows of the border data points are computed first, their
+     * exchange with the neighbours is then overlapped with the
+     * computation of the interior rows.
+     */
+    void novlp_op_apply_consistent (const X& x, Y& y, field_type alpha) const
+    {
+      novlp_op_setup(x.size());
+
+      // the rows are distributed over the threads, the communication
+      // is only issued by the master thread between the parallel loops
+      const long border = borderRows.size();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+      for (long k=0; k<border; ++k)
+        novlp_row_apply(borderRows[k],x,y,alpha);
+      communication.startAddOwnerCopyToOwnerCopy(y);
+      const long interior = interiorRows.size();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+      for (long k=0; k<interior; ++k)
+        novlp_row_apply(interiorRows[k],x,y,alpha);
+      communication.finishAddOwnerCopyToOwnerCopy(y);
+    }
+
+    //! set up the mask vector, the border contributions and the border rows
+    void novlp_op_setup (std::size_t size) const
     {
       //get index sets
       const PIS& pis=communication.indexSet();
       const RI& ri = communication.remoteIndices();
 
-      // at the beginning make a multimap "bordercontribution".
+      // at the beginning mark the entries contributing to Ax.
       // process has i and j as border dofs but is not the owner
-      // => only contribute to Ax if i,j is in bordercontribution
+      // => only contribute to Ax if no other process does
       if (buildcomm == true) {
 
         // set up mask vector
-        if (mask.size()!=static_cast<typename std::vector<double>::size_type>(x.size())) {
-          mask.resize(x.size());
+        if (mask.size()!=static_cast<typename std::vector<double>::size_type>(size)) {
+          mask.resize(size);
           for (typename std::vector<double>::size_type i=0; i<mask.size(); i++)
             mask[i] = 1;
           for (typename PIS::const_iterator i=pis.begin(); i!=pis.end(); ++i)
@@ -146,97 +181,104 @@ namespace Dune {
               mask[i->local().local()] = 2;
         }
 
-        for (MM::iterator iter = bordercontribution.begin();
-             iter != bordercontribution.end(); ++iter)
-          bordercontribution.erase(iter);
-        std::map<int,int> owner; //key: local index i, value: process, that owns i
-        RIMap rimap;
-
-        // for each local index make multimap rimap:
-        // key: local index i, data: pair of process that knows i and pointer to RI entry
-        for (RowIterator i = _A_.begin(); i != _A_.end(); ++i)
-          if (mask[i.index()] == 0)
-            for (RIIterator remote = ri.begin(); remote != ri.end(); ++remote) {
-              RIL& ril = *(remote->second.first);
-              for (RILIterator rindex = ril.begin(); rindex != ril.end(); ++rindex)
-                if (rindex->attribute() != OwnerOverlapCopyAttributeSet::overlap)
-                  if (rindex->localIndexPair().local().local() == i.index()) {
-                    rimap.insert
-                      (std::make_pair(i.index(),
-                                      std::pair<int,RILIterator>(remote->first, rindex)));
-                    if(rindex->attribute()==OwnerOverlapCopyAttributeSet::owner)
-                      owner.insert(std::make_pair(i.index(),remote->first));
-                  }
-            }
-
-        int iowner = 0;
-        for (RowIterator i = _A_.begin(); i != _A_.end(); ++i) {
-          if (mask[i.index()] == 0) {
-            std::map<int,int>::iterator it = owner.find(i.index());
-            iowner = it->second;
-            std::pair<RIMapit, RIMapit> foundiit = rimap.equal_range(i.index());
-            for (ColIterator j = _A_[i.index()].begin(); j != _A_[i.index()].end(); ++j) {
-              if (mask[j.index()] == 0) {
-                bool flag = true;
-                for (RIMapit foundi = foundiit.first; foundi != foundiit.second; ++foundi) {
-                  std::pair<RIMapit, RIMapit> foundjit = rimap.equal_range(j.index());
-                  for (RIMapit foundj = foundjit.first; foundj != foundjit.second; ++foundj)
-                    if (foundj->second.first == foundi->second.first)
-                      if (foundj->second.second->attribute() == OwnerOverlapCopyAttributeSet::owner
-                          || foundj->second.first == iowner
-                          || foundj->second.first  < communication.communicator().rank()) {
-                        flag = false;
-                        continue;
-                      }
-                  if (flag == false)
-                    continue;
-                }
-                // don´t contribute to Ax if
-                // 1. the owner of j has i as interior/border dof
-                // 2. iowner has j as interior/border dof
-                // 3. there is another process with smaller rank that has i and j
-                // as interor/border dofs
-                // if the owner of j does not have i as interior/border dof,
-                // it will not be taken into account
-                if (flag==true)
-                  bordercontribution.insert(std::pair<int,int>(i.index(),j.index()));
-              }
+        // for each border index i the processes that know i together
+        // with the attribute there, and the process owning i
+        const std::size_t n = _A_.N();
+        std::vector<std::vector<std::pair<int,int> > > known(n);
+        std::vector<int> owner(n,-1);
+        for (RIIterator remote = ri.begin(); remote != ri.end(); ++remote) {
+          RIL& ril = *(remote->second.first);
+          for (RILIterator rindex = ril.begin(); rindex != ril.end(); ++rindex) {
+            const std::size_t i = rindex->localIndexPair().local().local();
+            if (i < n && mask[i] == 0
+                && rindex->attribute() != OwnerOverlapCopyAttributeSet::overlap) {
+              known[i].push_back(std::make_pair(remote->first,
+                                                static_cast<int>(rindex->attribute())));
+              if (rindex->attribute() == OwnerOverlapCopyAttributeSet::owner && owner[i] < 0)
+                owner[i] = remote->first;
             }
           }
         }
-        buildcomm = false;
-      }
 
-      //compute alpha*A*x nonoverlapping case
-      for (RowIterator i = _A_.begin(); i != _A_.end(); ++i) {
-        if (mask[i.index()] == 0) {
-          //dof doesn't belong to process but is border (not ghost)
-          for (ColIterator j = _A_[i.index()].begin(); j != _A_[i.index()].end(); ++j) {
-            if (mask[j.index()] == 1) //j is owner => then sum entries
-              (*j).usmv(alpha,x[j.index()],y[i.index()]);
-            else if (mask[j.index()] == 0) {
-              std::pair<MM::iterator, MM::iterator> itp =
-                bordercontribution.equal_range(i.index());
-              for (MM::iterator it = itp.first; it != itp.second; ++it)
-                if ((*it).second == (int)j.index())
-                  (*j).usmv(alpha,x[j.index()],y[i.index()]);
+        // one flag per nonzero telling whether the entry contributes to Ax
+        const int rank = communication.communicator().rank();
+        rowOffset.resize(n+1);
+        contribution.clear();
+        for (RowIterator i = _A_.begin(); i != _A_.end(); ++i) {
+          rowOffset[i.index()] = contribution.size();
+          for (ColIterator j = (*i).begin(); j != (*i).end(); ++j) {
+            bool flag;
+            if (mask[i.index()] == 1)
+              flag = (mask[j.index()] != 2);
+            else if (mask[i.index()] == 0 && mask[j.index()] == 1)
+              //dof doesn't belong to process but is border (not ghost)
+              flag = true;
+            else if (mask[i.index()] == 0 && mask[j.index()] == 0) {
+              // don´t contribute to Ax if
+              // 1. the owner of j has i as interior/border dof
+              // 2. iowner has j as interior/border dof
+              // 3. there is another process with smaller rank that has i and j
+              // as interor/border dofs
+              // if the owner of j does not have i as interior/border dof,
+              // it will not be taken into account
+              const std::vector<std::pair<int,int> >& knowni = known[i.index()];
+              const std::vector<std::pair<int,int> >& knownj = known[j.index()];
+              flag = true;
+              for (std::size_t a=0; a<knowni.size() && flag; ++a)
+                for (std::size_t b=0; b<knownj.size(); ++b)
+                  if (knownj[b].first == knowni[a].first
+                      && (knownj[b].second == OwnerOverlapCopyAttributeSet::owner
+                          || knownj[b].first == owner[i.index()]
+                          || knownj[b].first < rank)) {
+                    flag = false;
+                    break;
+                  }
             }
+            else
+              flag = false;
+            contribution.push_back(flag);
           }
         }
-        else if (mask[i.index()] == 1) {
-          for (ColIterator j = _A_[i.index()].begin(); j != _A_[i.index()].end(); ++j)
-            if (mask[j.index()] != 2)
-              (*j).usmv(alpha,x[j.index()],y[i.index()]);
+        rowOffset[n] = contribution.size();
+
+        // the rows exchanged by addOwnerCopyToOwnerCopy
+        std::vector<bool> border(_A_.N(),false);
+        for (RIIterator remote = ri.begin(); remote != ri.end(); ++remote) {
+          RIL& ril = *(remote->second.first);
+          for (RILIterator rindex = ril.begin(); rindex != ril.end(); ++rindex)
+            if (rindex->attribute() != OwnerOverlapCopyAttributeSet::overlap
+                && rindex->localIndexPair().local().attribute() != OwnerOverlapCopyAttributeSet::overlap)
+              border[rindex->localIndexPair().local().local()] = true;
         }
+        borderRows.clear();
+        interiorRows.clear();
+        for (std::size_t i=0; i<border.size(); ++i)
+          if (border[i])
+            borderRows.push_back(i);
+          else
+            interiorRows.push_back(i);
+
+        buildcomm = false;
       }
     }
 
-  private:
+    //! compute row i of alpha*A*x nonoverlapping case
+    void novlp_row_apply (std::size_t i, const X& x, Y& y, field_type alpha) const
+    {
+      std::size_t k = rowOffset[i];
+      for (ColIterator j = _A_[i].begin(); j != _A_[i].end(); ++j, ++k)
+        if (contribution[k])
+          (*j).usmv(alpha,x[j.index()],y[i]);
+    }
+
     const matrix_type& _A_;
     const communication_type& communication;
     mutable bool buildcomm;
     mutable std::vector<double> mask;
-    mutable std::multimap<int,int>  bordercontribution;
+    mutable std::vector<std::size_t> rowOffset;
+    mutable std::vector<char> contribution;
+    mutable std::vector<std::size_t> borderRows;
+    mutable std::vector<std::size_t> interiorRows;
   };
 
   /** @} */
@@ -291,6 +333,22 @@ namespace Dune {
       return communication.norm(x);
     }
 
+    /*! \brief Start several dot products with one non-blocking global reduction.
+       The results are valid only after wait() was called.
+     */
+    virtual void idots (const std::vector<const X*>& x, const std::vector<const X*>& y,
+                        std::vector<field_type>& result)
+    {
+      communication.localDots(x,y,result);
+      communication.startSum(result);
+    }
+
+    //! \brief Wait for the reduction started by idots().
+    virtual void wait ()
+    {
+      communication.waitSum();
+    }
+
     /*! \brief make additive vector consistent
      */
     void make_consistent (X& x) const
@@ -8,6 +8,7 @@
 #include <iostream>
 #include <iomanip>
 #include <string>
+#include <vector>
 
 #include "solvercategory.hh"
 
@@ -77,6 +78,17 @@ namespace Dune {
     //! apply operator to x, scale and add:  \f$ y = y + \alpha A(x) \f$
     virtual void applyscaleadd (field_type alpha, const X& x, Y& y) const = 0;
 
+    /*! \brief apply operator to several vectors:  \f$ y_k = A(x_k) \f$
+
+       The default implementation calls apply() for each pair of vectors,
+       derived classes may override it to process the vectors together.
+     */
+    virtual void applyMultiple (const std::vector<const X*>& x, const std::vector<Y*>& y) const
+    {
+      for (typename std::vector<const X*>::size_type k=0; k<x.size(); ++k)
+        apply(*x[k],*y[k]);
+    }
+
     //! every abstract base class has a virtual destructor
     virtual ~LinearOperator () {}
   };
@@ -112,6 +124,56 @@ namespace Dune {
   // Implementation for ISTL-matrix based operator
   //=====================================================================
 
+  template<class B, class A>
+  class BCRSMatrix;
+
+  //! \brief \f$ y_k = A x_k \f$ for several vectors, one mv per vector.
+  template<class M, class X, class Y>
+  void mvMultiple (const M& A, const std::vector<const X*>& x, const std::vector<Y*>& y)
+  {
+    for (typename std::vector<const X*>::size_type k=0; k<x.size(); ++k)
+      A.mv(*x[k],*y[k]);
+  }
+
+  //! \brief \f$ y_k = A x_k \f$ for several vectors, reading the matrix only once.
+  template<class B, class TA, class X, class Y>
+  void mvMultiple (const BCRSMatrix<B,TA>& A, const std::vector<const X*>& x, const std::vector<Y*>& y)
+  {
+    A.mvMultiple(x,y);
+  }
+
+  //! \brief \f$ y = y + \alpha A x \f$, generic version calling usmv of the matrix.
+  template<class M, class K, class X, class Y>
+  void threadedUsmv (const M& A, const K& alpha, const X& x, Y& y)
+  {
+    A.usmv(alpha,x,y);
+  }
+
+  /*!
+     \brief \f$ y = y + \alpha A x \f$ with the rows distributed over
+     the threads if compiled with OpenMP support.
+
+     Used by the parallel operators to run the local product
+     thread-parallel inside each process.
+   */
+  template<class B, class TA, class K, class X, class Y>
+  void threadedUsmv (const BCRSMatrix<B,TA>& A, const K& alpha, const X& x, Y& y)
+  {
+#ifdef _OPENMP
+    typedef typename BCRSMatrix<B,TA>::ConstColIterator ConstColIterator;
+    const long rows = A.N();
+#pragma omp parallel for schedule(static)
+    for (long i=0; i<rows; ++i)
+    {
+      ConstColIterator endj = A[i].end();
+      for (ConstColIterator j=A[i].begin(); j!=endj; ++j)
+        (*j).usmv(alpha,x[j.index()],y[i]);
+    }
+#else
+    A.usmv(alpha,x,y);
+#endif
+  }
+
   /*!
      \brief Adapter to turn a matrix into a linear operator.
 
@@ -145,6 +207,12 @@ namespace Dune {
       _A_.usmv(alpha,x,y);
     }
 
+    //! apply operator to several vectors:  \f$ y_k = A(x_k) \f$
+    virtual void applyMultiple (const std::vector<const X*>& x, const std::vector<Y*>& y) const
+    {
+      mvMultiple(_A_,x,y);
+    }
+
     //! get matrix via *
     virtual const M& getmat () const
     {
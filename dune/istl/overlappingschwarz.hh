@@ -18,6 +18,10 @@
 #include "ilusubdomainsolver.hh"
 #include <dune/istl/solvertype.hh>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 namespace Dune
 {
 
@@ -128,6 +132,18 @@ namespace Dune
   struct SymmetricMultiplicativeSchwarzMode
   {};
 
+  /**
+   * @brief Tag that tells the Schwarz method to be multiplicative
+   * between colors of subdomains.
+   *
+   * The subdomains are grouped into colors such that the subdomains of
+   * one color neither share rows nor are coupled by the matrix. The
+   * colors are processed one after another and the subdomains of a color
+   * concurrently if OpenMP is enabled.
+   */
+  struct ColoredMultiplicativeSchwarzMode
+  {};
+
   /**
    * @brief Exact subdomain solver using Dune::DynamicMatrix<T>::solve
    * @tparam M The type of the matrix.
@@ -586,6 +602,46 @@ namespace Dune
     typedef MultiplicativeAdder<S,X> Adder;
   };
 
+  template<class X, class S>
+  struct AdderSelector<ColoredMultiplicativeSchwarzMode,X,S>
+  {
+    typedef MultiplicativeAdder<S,X> Adder;
+  };
+
+  /**
+   * @brief template meta program for choosing whether the subdomains
+   * are processed color by color.
+   *
+   * Subdomains of the same color do not share rows. Therefore their
+   * solves can run concurrently and add their corrections without
+   * conflicts. The additive mode is only colored if there are several
+   * OpenMP threads.
+   *
+   * \tparam T The Schwarz mode.
+   */
+  template<typename T>
+  struct SeqOverlappingSchwarzColoring
+  {
+    enum {
+      //! \brief Whether the subdomains are colored.
+      colored = false,
+      //! \brief Whether subdomains coupled by the matrix get different colors.
+      coupled = false
+    };
+  };
+
+  template<>
+  struct SeqOverlappingSchwarzColoring<AdditiveSchwarzMode>
+  {
+    enum { colored = true, coupled = false };
+  };
+
+  template<>
+  struct SeqOverlappingSchwarzColoring<ColoredMultiplicativeSchwarzMode>
+  {
+    enum { colored = true, coupled = true };
+  };
+
   /**
    * @brief Helper template meta program for application of overlapping schwarz.
    *
@@ -741,8 +797,13 @@ namespace Dune
    *
    * @tparam M The matrix type.
    * @tparam X The range and domain type.
+   * If OpenMP is enabled, the subdomains of the AdditiveSchwarzMode and
+   * of the ColoredMultiplicativeSchwarzMode are solved concurrently, each
+   * thread with its own local vectors.
+   *
    * @tparam TM The Schwarz mode. Currently supported modes are AdditiveSchwarzMode,
-   * MultiplicativeSchwarzMode, and SymmetricMultiplicativeSchwarzMode. (Default values is AdditiveSchwarzMode)
+   * MultiplicativeSchwarzMode, SymmetricMultiplicativeSchwarzMode, and
+   * ColoredMultiplicativeSchwarzMode. (Default values is AdditiveSchwarzMode)
    * @tparam TD The type of the local subdomain solver to be used.
    * @tparam TA The type of the allocator to use.
    */
@@ -873,6 +934,13 @@ namespace Dune
     void apply(X& v, const X& d);
 
   private:
+    //! \brief Group the subdomains into colors, see SeqOverlappingSchwarzColoring.
+    void colorSubdomains();
+
+    //! \brief Apply the subdomains color by color.
+    template<bool forward>
+    void applyColored(X& v, const X& d);
+
     const M& mat;
     slu_vector solvers;
     subdomain_vector subDomains;
@@ -881,6 +949,9 @@ namespace Dune
     typename M::size_type maxlength;
 
     bool onTheFly;
+
+    //! \brief The subdomains of each color, empty if not colored.
+    std::vector<std::vector<size_type> > colors;
   };
 
 
@@ -1052,6 +1123,7 @@ namespace Dune
 #endif
     maxlength = SeqOverlappingSchwarzAssembler<slu>
                 ::assembleLocalProblems(rowToDomain, mat, solvers, subDomains, onTheFly);
+    colorSubdomains();
   }
 
   template<class M, class X, class TM, class TD, class TA>
@@ -1093,6 +1165,7 @@ namespace Dune
 
     maxlength = SeqOverlappingSchwarzAssembler<slu>
                 ::assembleLocalProblems(rowToDomain, mat, solvers, subDomains, onTheFly);
+    colorSubdomains();
   }
 
   /**
@@ -1235,6 +1308,11 @@ namespace Dune
   template<bool forward>
   void SeqOverlappingSchwarz<M,X,TM,TD,TA>::apply(X& x, const X& b)
   {
+    if(!colors.empty()) {
+      applyColored<forward>(x, b);
+      return;
+    }
+
     typedef slu_vector solver_vector;
     typedef typename IteratorDirectionSelector<solver_vector,subdomain_vector,forward>::solver_iterator iterator;
     typedef typename IteratorDirectionSelector<solver_vector,subdomain_vector,forward>::domain_iterator
@@ -1275,6 +1353,111 @@ namespace Dune
     assigner.deallocate();
   }
 
+  template<class M, class X, class TM, class TD, class TA>
+  void SeqOverlappingSchwarz<M,X,TM,TD,TA>::colorSubdomains()
+  {
+    typedef SeqOverlappingSchwarzColoring<TM> Coloring;
+    colors.clear();
+    if(!Coloring::colored)
+      return;
+#ifdef _OPENMP
+    if(!Coloring::coupled && omp_get_max_threads()<2)
+      return;
+#else
+    if(!Coloring::coupled)
+      return;
+#endif
+
+    // Greedy coloring: each color takes, in order, the remaining
+    // subdomains that neither write a row that the color reads nor
+    // read a row that the color writes.
+    typedef typename subdomain_type::const_iterator iterator;
+    typedef typename M::ConstColIterator col_iterator;
+    std::vector<long> written(mat.N(), -1), read(mat.N(), -1);
+    std::vector<bool> done(subDomains.size(), false);
+    size_type remaining=subDomains.size();
+
+    for(long color=0; remaining>0; ++color) {
+      colors.push_back(std::vector<size_type>());
+      for(size_type d=0; d<subDomains.size(); ++d) {
+        if(done[d])
+          continue;
+        bool conflict=false;
+        for(iterator row=subDomains[d].begin(); row!=subDomains[d].end() && !conflict; ++row) {
+          conflict = written[*row]==color || read[*row]==color;
+          if(Coloring::coupled)
+            for(col_iterator col=mat[*row].begin(); col!=mat[*row].end() && !conflict; ++col)
+              conflict = written[col.index()]==color;
+        }
+        if(conflict)
+          continue;
+        for(iterator row=subDomains[d].begin(); row!=subDomains[d].end(); ++row) {
+          written[*row]=read[*row]=color;
+          if(Coloring::coupled)
+            for(col_iterator col=mat[*row].begin(); col!=mat[*row].end(); ++col)
+              read[col.index()]=color;
+        }
+        colors.back().push_back(d);
+        done[d]=true;
+        --remaining;
+      }
+    }
+  }
+
+  template<class M, class X, class TM, class TD, class TA>
+  template<bool forward>
+  void SeqOverlappingSchwarz<M,X,TM,TD,TA>::applyColored(X& x, const X& b)
+  {
+    X v(x); // temporary for the update
+    v=0;
+
+    typedef typename AdderSelector<TM,X,TD >::Adder Adder;
+    const size_type noColors=colors.size();
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+      // each thread uses its own local vectors
+      OverlappingAssigner<TD> assigner(maxlength, mat, b, x);
+      Adder adder(v, x, assigner, relax);
+
+      for(size_type k=0; k<noColors; ++k) {
+        const std::vector<size_type>& color = colors[forward ? k : noColors-1-k];
+        const long noDomains=color.size();
+
+        // The subdomains of a color do not share rows, so the corrections
+        // can be added without conflicts. The barrier at the end of the
+        // loop separates the colors.
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+        for(long i=0; i<noDomains; ++i) {
+          const size_type d=color[i];
+          std::for_each(subDomains[d].begin(), subDomains[d].end(), assigner);
+          assigner.resetIndexForNextDomain();
+          if(onTheFly) {
+            // Create the subdomain solver
+            slu sdsolver;
+            sdsolver.setSubMatrix(mat, subDomains[d]);
+            // Apply
+            sdsolver.apply(assigner.lhs(), assigner.rhs());
+          }else
+            solvers[d].apply(assigner.lhs(), assigner.rhs());
+
+          std::for_each(subDomains[d].begin(), subDomains[d].end(), adder);
+          assigner.resetIndexForNextDomain();
+        }
+      }
+
+#ifdef _OPENMP
+#pragma omp single
+#endif
+      adder.axpy();
+      assigner.deallocate();
+    }
+  }
+
   template<class K, int n, class Al, class X, class Y>
   OverlappingAssignerHelper< DynamicMatrixSubdomainSolver< BCRSMatrix< FieldMatrix<K,n,n>, Al>, X, Y >,false>
   ::OverlappingAssignerHelper(std::size_t maxlength, const BCRSMatrix<FieldMatrix<K,n,n>, Al>& mat_,
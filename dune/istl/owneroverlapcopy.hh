@@ -8,7 +8,11 @@
 #include <vector>
 #include <list>
 #include <map>
+#include <memory>
 #include <set>
+#include <string>
+#include <typeinfo>
+#include <utility>
 
 #include "cmath"
 
@@ -20,8 +24,10 @@
 
 #include <dune/common/tuples.hh>
 #include <dune/common/enumset.hh>
+#include <dune/common/ftraits.hh>
 
 #if HAVE_MPI
+#include <dune/common/parallel/mpitraits.hh>
 #include <dune/common/parallel/indexset.hh>
 #include <dune/common/parallel/communicator.hh>
 #include <dune/common/parallel/remoteindices.hh>
@@ -194,6 +200,8 @@ namespace Dune {
     typedef Combine<EnumItem<AttributeSet,OwnerOverlapCopyAttributeSet::owner>,EnumItem<AttributeSet,OwnerOverlapCopyAttributeSet::overlap>,AttributeSet> OwnerOverlapSet;
     typedef Dune::AllSet<AttributeSet> AllSet;
   protected:
+    //! communicators by interface and data type
+    typedef std::map<std::pair<const IF*,std::string>, std::shared_ptr<BC> > CommunicatorCache;
 
 
     /** \brief gather/scatter callback for communcation */
@@ -230,8 +238,10 @@ namespace Dune {
 
     void buildOwnerOverlapToAllInterface () const
     {
-      if (OwnerOverlapToAllInterfaceBuilt)
+      if (OwnerOverlapToAllInterfaceBuilt) {
+        freeCommunicators(OwnerOverlapToAllInterface);
         OwnerOverlapToAllInterface.free();
+      }
       typedef Combine<EnumItem<AttributeSet,OwnerOverlapCopyAttributeSet::owner>,EnumItem<AttributeSet,OwnerOverlapCopyAttributeSet::overlap>,AttributeSet> OwnerOverlapSet;
       typedef Combine<OwnerOverlapSet,EnumItem<AttributeSet,OwnerOverlapCopyAttributeSet::copy>,AttributeSet> AllSet;
       OwnerOverlapSet sourceFlags;
@@ -242,8 +252,10 @@ namespace Dune {
 
     void buildOwnerToAllInterface () const
     {
-      if (OwnerToAllInterfaceBuilt)
+      if (OwnerToAllInterfaceBuilt) {
+        freeCommunicators(OwnerToAllInterface);
         OwnerToAllInterface.free();
+      }
       OwnerSet sourceFlags;
       AllSet destFlags;
       OwnerToAllInterface.build(ri,sourceFlags,destFlags);
@@ -252,8 +264,10 @@ namespace Dune {
 
     void buildOwnerCopyToAllInterface () const
     {
-      if (OwnerCopyToAllInterfaceBuilt)
+      if (OwnerCopyToAllInterfaceBuilt) {
+        freeCommunicators(OwnerCopyToAllInterface);
         OwnerCopyToAllInterface.free();
+      }
       typedef Combine<EnumItem<AttributeSet,OwnerOverlapCopyAttributeSet::owner>,EnumItem<AttributeSet,OwnerOverlapCopyAttributeSet::copy>,AttributeSet> OwnerCopySet;
       typedef Combine<OwnerCopySet,EnumItem<AttributeSet,OwnerOverlapCopyAttributeSet::overlap>,AttributeSet> AllSet;
       OwnerCopySet sourceFlags;
@@ -264,8 +278,11 @@ namespace Dune {
 
     void buildOwnerCopyToOwnerCopyInterface () const
     {
-      if (OwnerCopyToOwnerCopyInterfaceBuilt)
+      if (OwnerCopyToOwnerCopyInterfaceBuilt) {
+        freeCommunicators(OwnerCopyToOwnerCopyInterface);
+        freeHaloRequests();
         OwnerCopyToOwnerCopyInterface.free();
+      }
       typedef Combine<EnumItem<AttributeSet,OwnerOverlapCopyAttributeSet::owner>,EnumItem<AttributeSet,OwnerOverlapCopyAttributeSet::copy>,AttributeSet> OwnerCopySet;
       OwnerCopySet sourceFlags;
       OwnerCopySet destFlags;
@@ -273,10 +290,67 @@ namespace Dune {
       OwnerCopyToOwnerCopyInterfaceBuilt = true;
     }
 
+    /**
+     * \brief The communicator for an interface and a data type.
+     *
+     * The communicators are built on first use and kept, so that
+     * later communications only move the data.
+     */
+    template<class T>
+    BC& cachedCommunicator (const IF& interface) const
+    {
+      std::shared_ptr<BC>& communicator =
+        communicators[std::make_pair(&interface,std::string(typeid(T).name()))];
+      if (!communicator) {
+        communicator.reset(new BC());
+        communicator->template build<T>(interface);
+      }
+      return *communicator;
+    }
+
+    //! \brief Free the cached communicators of an interface.
+    void freeCommunicators (const IF& interface) const
+    {
+      typename CommunicatorCache::iterator i=communicators.begin();
+      while (i!=communicators.end())
+        if (i->first.first==&interface)
+          communicators.erase(i++);
+        else
+          ++i;
+    }
+
+    //! \brief Free the persistent requests of the split phase exchange.
+    void freeHaloRequests () const
+    {
+      int finalized = 0;
+      MPI_Finalized(&finalized);
+      if (!finalized)
+        for (std::size_t k=0; k<haloRequests.size(); ++k)
+          MPI_Request_free(&haloRequests[k]);
+      haloRequests.clear();
+      haloBlockSize = 0;
+    }
+
+    /** \brief set up the mask vector which is one for owner data points and zero otherwise */
+    void buildMask (std::size_t size) const
+    {
+      if (mask.size()!=static_cast<typename std::vector<double>::size_type>(size))
+      {
+        mask.resize(size);
+        for (typename std::vector<double>::size_type i=0; i<mask.size(); i++)
+          mask[i] = 1;
+        for (typename PIS::const_iterator i=pis.begin(); i!=pis.end(); ++i)
+          if (i->local().attribute()!=OwnerOverlapCopyAttributeSet::owner)
+            mask[i->local().local()] = 0;
+      }
+    }
+
     void buildCopyToAllInterface () const
     {
-      if (CopyToAllInterfaceBuilt)
+      if (CopyToAllInterfaceBuilt) {
+        freeCommunicators(CopyToAllInterface);
         CopyToAllInterface.free();
+      }
       CopySet sourceFlags;
       AllSet destFlags;
       CopyToAllInterface.build(ri,sourceFlags,destFlags);
@@ -316,10 +390,7 @@ namespace Dune {
     {
       if (!OwnerToAllInterfaceBuilt)
         buildOwnerToAllInterface ();
-      BC communicator;
-      communicator.template build<T>(OwnerToAllInterface);
-      communicator.template forward<CopyGatherScatter<T> >(source,dest);
-      communicator.free();
+      cachedCommunicator<T>(OwnerToAllInterface).template forward<CopyGatherScatter<T> >(source,dest);
     }
 
     /**
@@ -333,10 +404,7 @@ namespace Dune {
     {
       if (!CopyToAllInterfaceBuilt)
         buildCopyToAllInterface ();
-      BC communicator;
-      communicator.template build<T>(CopyToAllInterface);
-      communicator.template forward<CopyGatherScatter<T> >(source,dest);
-      communicator.free();
+      cachedCommunicator<T>(CopyToAllInterface).template forward<CopyGatherScatter<T> >(source,dest);
     }
 
     /**
@@ -350,10 +418,7 @@ namespace Dune {
     {
       if (!OwnerOverlapToAllInterfaceBuilt)
         buildOwnerOverlapToAllInterface ();
-      BC communicator;
-      communicator.template build<T>(OwnerOverlapToAllInterface);
-      communicator.template forward<AddGatherScatter<T> >(source,dest);
-      communicator.free();
+      cachedCommunicator<T>(OwnerOverlapToAllInterface).template forward<AddGatherScatter<T> >(source,dest);
     }
 
     /**
@@ -367,10 +432,7 @@ namespace Dune {
     {
       if (!OwnerCopyToAllInterfaceBuilt)
         buildOwnerCopyToAllInterface ();
-      BC communicator;
-      communicator.template build<T>(OwnerCopyToAllInterface);
-      communicator.template forward<AddGatherScatter<T> >(source,dest);
-      communicator.free();
+      cachedCommunicator<T>(OwnerCopyToAllInterface).template forward<AddGatherScatter<T> >(source,dest);
     }
 
     /**
@@ -384,41 +446,233 @@ namespace Dune {
     {
       if (!OwnerCopyToOwnerCopyInterfaceBuilt)
         buildOwnerCopyToOwnerCopyInterface ();
-      BC communicator;
-      communicator.template build<T>(OwnerCopyToOwnerCopyInterface);
-      communicator.template forward<AddGatherScatter<T> >(source,dest);
-      communicator.free();
+      cachedCommunicator<T>(OwnerCopyToOwnerCopyInterface).template forward<AddGatherScatter<T> >(source,dest);
+    }
+
+    /**
+     * @brief Start adding the values of owner and copy data points to
+     * owner and copy data points without blocking.
+     *
+     * Split phase version of addOwnerCopyToOwnerCopy(). The values to
+     * send are copied from source immediately and the messages are
+     * posted without waiting for them. The received values are added in
+     * finishAddOwnerCopyToOwnerCopy(), so computations that do not touch
+     * the communicated data points can be done in between. Only one
+     * exchange may be pending at a time. The buffers and persistent MPI
+     * requests are set up on the first call and reused afterwards.
+     *
+     * The blocks of T have to be of fixed size, e.g. FieldVector.
+     *
+     * @param source The data to send from.
+     */
+    template<class T>
+    void startAddOwnerCopyToOwnerCopy (const T& source) const
+    {
+      typedef typename T::block_type block_type;
+      typedef typename IF::InformationMap::const_iterator InterfaceIterator;
+
+      if (!OwnerCopyToOwnerCopyInterfaceBuilt)
+        buildOwnerCopyToOwnerCopyInterface ();
+      const typename IF::InformationMap& interfaces = OwnerCopyToOwnerCopyInterface.interfaces();
+
+      // set up the buffers and persistent requests once per block size
+      if (haloBlockSize!=sizeof(block_type)) {
+        freeHaloRequests();
+        haloSendBuffers.resize(interfaces.size());
+        haloRecvBuffers.resize(interfaces.size());
+        std::size_t k=0;
+        for (InterfaceIterator i=interfaces.begin(); i!=interfaces.end(); ++i, ++k)
+        {
+          haloRecvBuffers[k].resize(i->second.second.size()*sizeof(block_type));
+          haloSendBuffers[k].resize(i->second.first.size()*sizeof(block_type));
+          if (!haloRecvBuffers[k].empty()) {
+            haloRequests.push_back(MPI_Request());
+            MPI_Recv_init(&haloRecvBuffers[k][0], haloRecvBuffers[k].size(), MPI_BYTE,
+                          i->first, haloTag, comm, &haloRequests.back());
+          }
+          if (!haloSendBuffers[k].empty()) {
+            haloRequests.push_back(MPI_Request());
+            MPI_Send_init(&haloSendBuffers[k][0], haloSendBuffers[k].size(), MPI_BYTE,
+                          i->first, haloTag, comm, &haloRequests.back());
+          }
+        }
+        haloBlockSize = sizeof(block_type);
+      }
+
+      std::size_t k=0;
+      for (InterfaceIterator i=interfaces.begin(); i!=interfaces.end(); ++i, ++k)
+      {
+        const std::size_t size = i->second.first.size();
+        if (size==0)
+          continue;
+        block_type* buffer = reinterpret_cast<block_type*>(&haloSendBuffers[k][0]);
+        for (std::size_t j=0; j<size; ++j)
+          buffer[j] = source[i->second.first[j]];
+      }
+      if (!haloRequests.empty())
+        MPI_Startall(haloRequests.size(), &haloRequests[0]);
     }
 
+    /**
+     * @brief Finish the exchange started by startAddOwnerCopyToOwnerCopy().
+     *
+     * Waits for the messages and adds the received values.
+     *
+     * @param dest The data to add the communicated values to.
+     */
+    template<class T>
+    void finishAddOwnerCopyToOwnerCopy (T& dest) const
+    {
+      typedef typename T::block_type block_type;
+      typedef typename IF::InformationMap::const_iterator InterfaceIterator;
+
+      if (!haloRequests.empty())
+        MPI_Waitall(haloRequests.size(), &haloRequests[0], MPI_STATUSES_IGNORE);
+
+      const typename IF::InformationMap& interfaces = OwnerCopyToOwnerCopyInterface.interfaces();
+      std::size_t k=0;
+      for (InterfaceIterator i=interfaces.begin(); i!=interfaces.end(); ++i, ++k)
+      {
+        const std::size_t size = i->second.second.size();
+        if (size==0)
+          continue;
+        const block_type* buffer = reinterpret_cast<const block_type*>(&haloRecvBuffers[k][0]);
+        for (std::size_t j=0; j<size; ++j)
+          dest[i->second.second[j]] += buffer[j];
+      }
+    }
 
     /**
-     * @brief Compute a global dot product of two vectors.
+     * @brief Compute the local part of a dot product of two vectors.
+     *
+     * Only owner data points contribute, such that the global
+     * dot product is the sum of the local parts of all processes.
      *
      * @param x The first vector of the product.
      * @param y The second vector of the product.
      * @param result Reference to store the result in.
      */
     template<class T1, class T2>
-    void dot (const T1& x, const T1& y, T2& result) const
+    void localDot (const T1& x, const T1& y, T2& result) const
     {
-      // set up mask vector
-      if (mask.size()!=static_cast<typename std::vector<double>::size_type>(x.size()))
+      buildMask(x.size());
+      result = T2(0.0);
+
+      const long n = x.size();
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
       {
-        mask.resize(x.size());
-        for (typename std::vector<double>::size_type i=0; i<mask.size(); i++)
-          mask[i] = 1;
-        for (typename PIS::const_iterator i=pis.begin(); i!=pis.end(); ++i)
-          if (i->local().attribute()!=OwnerOverlapCopyAttributeSet::owner)
-            mask[i->local().local()] = 0;
+        // partial sums per thread, complex types rule out a reduction clause
+        T2 partial = T2(0.0);
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+        for (long i=0; i<n; i++)
+          partial += x[i]*(y[i])*mask[i];
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+        result += partial;
       }
-      result = T2(0.0);
+    }
 
-      for (typename T1::size_type i=0; i<x.size(); i++)
-        result += x[i]*(y[i])*mask[i];
+    /**
+     * @brief Compute the local parts of several dot products in a single
+     * sweep over the vectors.
+     *
+     * @param x The first vectors of the products.
+     * @param y The second vectors of the products.
+     * @param result Vector to store the results in.
+     */
+    template<class T1, class T2>
+    void localDots (const std::vector<const T1*>& x, const std::vector<const T1*>& y,
+                    std::vector<T2>& result) const
+    {
+      typedef typename std::vector<const T1*>::size_type index_type;
+      result.assign(x.size(),T2(0.0));
+      if (x.empty())
+        return;
+      buildMask(x[0]->size());
+
+      const long n = x[0]->size();
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+      {
+        std::vector<T2> partial(x.size(),T2(0.0));
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+        for (long i=0; i<n; i++)
+          for (index_type k=0; k<x.size(); k++)
+            partial[k] += (*x[k])[i]*((*y[k])[i])*mask[i];
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+        for (index_type k=0; k<x.size(); k++)
+          result[k] += partial[k];
+      }
+    }
+
+    /**
+     * @brief Compute a global dot product of two vectors.
+     *
+     * @param x The first vector of the product.
+     * @param y The second vector of the product.
+     * @param result Reference to store the result in.
+     */
+    template<class T1, class T2>
+    void dot (const T1& x, const T1& y, T2& result) const
+    {
+      localDot(x,y,result);
       result = cc.sum(result);
       return;
     }
 
+    /**
+     * @brief Start the global sum of several values without blocking.
+     *
+     * The values are summed up in place over all processes and must
+     * not be accessed before waitSum() returned. Only one sum may be
+     * pending at a time. If the MPI implementation does not support
+     * non-blocking collectives the sum is computed immediately.
+     *
+     * @param values The local values, overwritten by the global sums.
+     */
+    template<class T>
+    void startSum (std::vector<T>& values) const
+    {
+      typedef typename FieldTraits<T>::real_type real_type;
+      if (values.empty())
+        return;
+      // complex numbers are summed up as pairs of real numbers, the
+      // standard guarantees that std::complex<R> has the layout of R[2]
+      static_assert(sizeof(T)%sizeof(real_type)==0,
+                    "startSum needs values made up of their real type");
+      int count = values.size()*sizeof(T)/sizeof(real_type);
+      real_type* data = reinterpret_cast<real_type*>(&values[0]);
+#if MPI_VERSION >= 3
+      MPI_Iallreduce(MPI_IN_PLACE, data, count, MPITraits<real_type>::getType(),
+                     MPI_SUM, comm, &sumRequest);
+      sumPending = true;
+#else
+      MPI_Allreduce(MPI_IN_PLACE, data, count, MPITraits<real_type>::getType(),
+                    MPI_SUM, comm);
+#endif
+    }
+
+    /**
+     * @brief Wait for the sum started by startSum() to finish.
+     */
+    void waitSum () const
+    {
+      if (sumPending) {
+        MPI_Wait(&sumRequest, MPI_STATUS_IGNORE);
+        sumPending = false;
+      }
+    }
+
     /**
      * @brief Compute the global euclidian norm of a vector.
      *
@@ -428,19 +682,24 @@ namespace Dune {
     template<class T1>
     double norm (const T1& x) const
     {
-      // set up mask vector
-      if (mask.size()!=static_cast<typename std::vector<double>::size_type>(x.size()))
+      buildMask(x.size());
+      typename T1::field_type result = typename T1::field_type(0.0);
+      const long n = x.size();
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
       {
-        mask.resize(x.size());
-        for (typename std::vector<double>::size_type i=0; i<mask.size(); i++)
-          mask[i] = 1;
-        for (typename PIS::const_iterator i=pis.begin(); i!=pis.end(); ++i)
-          if (i->local().attribute()!=OwnerOverlapCopyAttributeSet::owner)
-            mask[i->local().local()] = 0;
+        typename T1::field_type partial = typename T1::field_type(0.0);
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+        for (long i=0; i<n; i++)
+          partial += x[i].two_norm2()*mask[i];
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+        result += partial;
       }
-      typename T1::field_type result = typename T1::field_type(0.0);
-      for (typename T1::size_type i=0; i<x.size(); i++)
-        result += x[i].two_norm2()*mask[i];
       return static_cast<double>(sqrt(cc.sum(result)));
     }
 
@@ -559,7 +818,7 @@ namespace Dune {
         OwnerToAllInterfaceBuilt(false), OwnerOverlapToAllInterfaceBuilt(false),
         OwnerCopyToAllInterfaceBuilt(false), OwnerCopyToOwnerCopyInterfaceBuilt(false),
         CopyToAllInterfaceBuilt(false), globalLookup_(0), category(cat_),
-        freecomm(freecomm_)
+        freecomm(freecomm_), sumPending(false), haloBlockSize(0)
     {}
 
     /**
@@ -574,7 +833,8 @@ namespace Dune {
       : comm(MPI_COMM_WORLD), cc(MPI_COMM_WORLD), pis(), ri(pis,pis,MPI_COMM_WORLD),
         OwnerToAllInterfaceBuilt(false), OwnerOverlapToAllInterfaceBuilt(false),
         OwnerCopyToAllInterfaceBuilt(false), OwnerCopyToOwnerCopyInterfaceBuilt(false),
-        CopyToAllInterfaceBuilt(false), globalLookup_(0), category(cat_), freecomm(false)
+        CopyToAllInterfaceBuilt(false), globalLookup_(0), category(cat_), freecomm(false),
+        sumPending(false), haloBlockSize(0)
     {}
 
     /**
@@ -591,7 +851,7 @@ namespace Dune {
       : comm(comm_), cc(comm_), OwnerToAllInterfaceBuilt(false),
         OwnerOverlapToAllInterfaceBuilt(false), OwnerCopyToAllInterfaceBuilt(false),
         OwnerCopyToOwnerCopyInterfaceBuilt(false), CopyToAllInterfaceBuilt(false),
-        globalLookup_(0), category(cat_), freecomm(freecomm_)
+        globalLookup_(0), category(cat_), freecomm(freecomm_), sumPending(false), haloBlockSize(0)
     {
       // set up an ISTL index set
       pis.beginResize();
@@ -650,6 +910,16 @@ namespace Dune {
     // destructor: free memory in some objects
     ~OwnerOverlapCopyCommunication ()
     {
+      // a pending sum still uses the communicator
+      if (sumPending) {
+        int finalized = 0;
+        MPI_Finalized(&finalized);
+        if (!finalized)
+          MPI_Wait(&sumRequest, MPI_STATUS_IGNORE);
+        sumPending = false;
+      }
+      communicators.clear();
+      freeHaloRequests();
       ri.free();
       if (OwnerToAllInterfaceBuilt) OwnerToAllInterface.free();
       if (OwnerOverlapToAllInterfaceBuilt) OwnerOverlapToAllInterface.free();
@@ -689,11 +959,20 @@ namespace Dune {
     mutable bool OwnerCopyToOwnerCopyInterfaceBuilt;
     mutable IF CopyToAllInterface;
     mutable bool CopyToAllInterfaceBuilt;
+    mutable CommunicatorCache communicators;
     mutable std::vector<double> mask;
     int oldseqNo;
     GlobalLookupIndexSet* globalLookup_;
     SolverCategory::Category category;
     bool freecomm;
+    mutable MPI_Request sumRequest;
+    mutable bool sumPending;
+    //! message tag of the split phase exchange
+    enum { haloTag = 335 };
+    mutable std::vector<std::vector<char> > haloSendBuffers;
+    mutable std::vector<std::vector<char> > haloRecvBuffers;
+    mutable std::vector<MPI_Request> haloRequests;
+    mutable std::size_t haloBlockSize;
   };
 
 #endif
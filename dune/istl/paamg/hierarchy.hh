@@ -716,14 +716,9 @@ namespace Dune
         MatrixOperator* matrix=&(*mlevel);
         ParallelInformation* info =&(*infoLevel);
 
-        if((
-#if HAVE_PARMETIS
-             criterion.accumulate()==successiveAccu
-#else
-             false
-#endif
-             || (criterion.accumulate()==atOnceAccu
-                 && dunknowns < 30*infoLevel->communicator().size()))
+        if((criterion.accumulate()==successiveAccu
+            || (criterion.accumulate()==atOnceAccu
+                && dunknowns < 30*infoLevel->communicator().size()))
            && infoLevel->communicator().size()>1 &&
            dunknowns/infoLevel->communicator().size() <= criterion.coarsenTarget())
         {
@@ -971,13 +966,6 @@ namespace Dune
 
       if(criterion.accumulate() && !redistributes_.back().isSetup() &&
          infoLevel->communicator().size()>1) {
-#if HAVE_MPI && !HAVE_PARMETIS
-        if(criterion.accumulate()==successiveAccu &&
-           infoLevel->communicator().rank()==0)
-          std::cerr<<"Successive accumulation of data on coarse levels only works with ParMETIS installed."
-                   <<"  Fell back to accumulation to one domain on coarsest level"<<std::endl;
-#endif
-
         // accumulate to fewer processors
         Matrix* redistMat= new Matrix();
         ParallelInformation* redistComm=0;
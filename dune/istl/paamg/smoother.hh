@@ -69,17 +69,50 @@ namespace Dune
     template<class X, class Y, class C, class T>
     struct SmootherTraits<BlockPreconditioner<X,Y,C,T> >
     {
-      typedef DefaultSmootherArgs<typename T::matrix_type::field_type> Arguments;
+      typedef typename SmootherTraits<T>::Arguments Arguments;
 
     };
 
     template<class C, class T>
     struct SmootherTraits<NonoverlappingBlockPreconditioner<C,T> >
     {
-      typedef DefaultSmootherArgs<typename T::matrix_type::field_type> Arguments;
+      typedef typename SmootherTraits<T>::Arguments Arguments;
 
     };
 
+    /**
+     * @brief The arguments for the Chebyshev smoother.
+     *
+     * The number of iterations is the degree of the polynomial.
+     */
+    template<class T>
+    struct ChebyshevSmootherArgs
+      : public DefaultSmootherArgs<T>
+    {
+      /**
+       * @brief The lower bound of the damped spectrum relative to the
+       * largest eigenvalue.
+       */
+      double eigenvalueRatio;
+      /**
+       * @brief The number of power iterations to estimate the largest eigenvalue.
+       */
+      int powerIterations;
+
+      ChebyshevSmootherArgs(double eigenvalueRatio_=1.0/30.0,
+                            int powerIterations_=10)
+        : eigenvalueRatio(eigenvalueRatio_), powerIterations(powerIterations_)
+      {
+        this->iterations=2;
+      }
+    };
+
+    template<class M, class X, class Y, int l>
+    struct SmootherTraits<SeqChebyshev<M,X,Y,l> >
+    {
+      typedef ChebyshevSmootherArgs<typename M::field_type> Arguments;
+    };
+
     /**
      * @brief Construction Arguments for the default smoothers
      */
@@ -234,6 +267,29 @@ namespace Dune
     };
 
 
+    /**
+     * @brief Policy for the construction of the SeqChebyshev smoother
+     */
+    template<class M, class X, class Y, int l>
+    struct ConstructionTraits<SeqChebyshev<M,X,Y,l> >
+    {
+      typedef DefaultConstructionArgs<SeqChebyshev<M,X,Y,l> > Arguments;
+
+      static inline SeqChebyshev<M,X,Y,l>* construct(Arguments& args)
+      {
+        return new SeqChebyshev<M,X,Y,l>(args.getMatrix(), args.getArgs().iterations,
+                                         args.getArgs().relaxationFactor,
+                                         args.getArgs().eigenvalueRatio,
+                                         args.getArgs().powerIterations);
+      }
+
+      static void deconstruct(SeqChebyshev<M,X,Y,l>* cheb)
+      {
+        delete cheb;
+      }
+
+    };
+
     /**
      * @brief Policy for the construction of the SeqILUn smoother
      */
@@ -255,6 +311,27 @@ namespace Dune
 
     };
 
+    /**
+     * @brief Policy for the construction of the SeqIC0 smoother
+     */
+    template<class M, class X, class Y>
+    struct ConstructionTraits<SeqIC0<M,X,Y> >
+    {
+      typedef DefaultConstructionArgs<SeqIC0<M,X,Y> > Arguments;
+
+      static inline SeqIC0<M,X,Y>* construct(Arguments& args)
+      {
+        return new SeqIC0<M,X,Y>(args.getMatrix(),
+                                 args.getArgs().relaxationFactor);
+      }
+
+      static void deconstruct(SeqIC0<M,X,Y>* ic)
+      {
+        delete ic;
+      }
+
+    };
+
     template<class M, class X, class Y>
     class ConstructionArgs<SeqILUn<M,X,Y> >
       : public DefaultConstructionArgs<SeqILUn<M,X,Y> >
@@ -364,7 +441,7 @@ namespace Dune
      * whenever possible.
      *
      * The specializations for SOR and SeqOverlappingSchwarz in
-     * MultiplicativeSchwarzMode will apply
+     * MultiplicativeSchwarzMode and ColoredMultiplicativeSchwarzMode will apply
      * the smoother forward when pre and backward when post smoothing.
      */
     template<class T>
@@ -506,6 +583,7 @@ namespace Dune
   class SeqOverlappingSchwarz;
 
   struct MultiplicativeSchwarzMode;
+  struct ColoredMultiplicativeSchwarzMode;
 
   namespace Amg
   {
@@ -530,6 +608,27 @@ namespace Dune
       }
     };
 
+    template<class M, class X, class MS, class TA>
+    struct SmootherApplier<SeqOverlappingSchwarz<M,X,ColoredMultiplicativeSchwarzMode,
+            MS,TA> >
+    {
+      typedef SeqOverlappingSchwarz<M,X,ColoredMultiplicativeSchwarzMode,MS,TA> Smoother;
+      typedef typename Smoother::range_type Range;
+      typedef typename Smoother::domain_type Domain;
+
+      static void preSmooth(Smoother& smoother, Domain& v, const Range& d)
+      {
+        smoother.template apply<true>(v,d);
+      }
+
+
+      static void postSmooth(Smoother& smoother, Domain& v, const Range& d)
+      {
+        smoother.template apply<false>(v,d);
+
+      }
+    };
+
     //    template<class M, class X, class TM, class TA>
     //    class SeqOverlappingSchwarz;
 
@@ -59,7 +59,7 @@ void randomize(const M& mat, V& b)
 
 
 template <int BS>
-void testAMG(int N, int coarsenTarget, int ml)
+int testAMG(int N, int coarsenTarget, int ml)
 {
 
   std::cout<<"N="<<N<<" coarsenTarget="<<coarsenTarget<<" maxlevel="<<ml<<std::endl;
@@ -157,6 +157,34 @@ void testAMG(int N, int coarsenTarget, int ml)
 
      std::cout<<"CG solving took "<<watch.elapsed()<<" seconds"<<std::endl;
    */
+
+  // the same hierarchy with the Chebyshev smoother
+  typedef Dune::SeqChebyshev<BCRSMat,Vector,Vector> ChebyshevSmoother;
+  typedef typename Dune::Amg::SmootherTraits<ChebyshevSmoother>::Arguments ChebyshevArgs;
+  typedef Dune::Amg::AMG<Operator,Vector,ChebyshevSmoother> ChebyshevAMG;
+
+  ChebyshevArgs chebyshevArgs;
+  chebyshevArgs.iterations = 2;
+  chebyshevArgs.relaxationFactor = 1;
+
+  watch.reset();
+  ChebyshevAMG chebyshevAMG(fop, criterion, chebyshevArgs, 1, 1, 1, false);
+  buildtime = watch.elapsed();
+  std::cout<<"Building hierarchy with Chebyshev smoother took "<<buildtime<<" seconds"<<std::endl;
+
+  x=0;
+  randomize(mat, b);
+  Dune::GeneralizedPCGSolver<Vector> chebyshevCG(fop,chebyshevAMG,1e-6,80,2);
+  watch.reset();
+  Dune::InverseOperatorResult chebyshevResult;
+  chebyshevCG.apply(x,b,chebyshevResult);
+  std::cout<<"AMG with Chebyshev smoother solving took "<<watch.elapsed()<<" seconds"<<std::endl;
+
+  if(!chebyshevResult.converged) {
+    std::cerr<<"AMG with Chebyshev smoother did not converge"<<std::endl;
+    return 1;
+  }
+  return 0;
 }
 
 
@@ -176,7 +204,8 @@ int main(int argc, char** argv)
   if(argc>3)
     ml = atoi(argv[3]);
 
-  testAMG<1>(N, coarsenTarget, ml);
-  testAMG<2>(N, coarsenTarget, ml);
+  int ret = testAMG<1>(N, coarsenTarget, ml);
+  ret += testAMG<2>(N, coarsenTarget, ml);
 
+  return ret;
 }
@@ -2,6 +2,9 @@
 // vi: set et ts=4 sw=2 sts=2:
 #ifndef DUNE_PRECONDITIONER_HH
 #define DUNE_PRECONDITIONER_HH
+
+#include <vector>
+
 namespace Dune {
 /**
  * @addtogroup ISTL_Prec
@@ -61,6 +64,20 @@ namespace Dune {
      */
     virtual void apply (X& v, const Y& d) = 0;
 
+    /*! \brief Apply the preconditioner to several defects at once.
+
+       Used by block solvers that iterate on several right hand sides.
+       The default implementation calls apply() for each pair of vectors,
+       derived classes may override it to process the vectors together.
+       \param[out] v The updates to be computed.
+       \param d The current defects.
+     */
+    virtual void applyMultiple (const std::vector<X*>& v, const std::vector<const Y*>& d)
+    {
+      for (typename std::vector<X*>::size_type k=0; k<v.size(); ++k)
+        apply(*v[k],*d[k]);
+    }
+
     /*! \brief Clean up.
 
        This method is called after the last apply call for the
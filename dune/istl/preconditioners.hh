@@ -3,12 +3,15 @@
 #ifndef DUNE_PRECONDITIONERS_HH
 #define DUNE_PRECONDITIONERS_HH
 
+#include <algorithm>
 #include <cmath>
 #include <complex>
 #include <iostream>
 #include <iomanip>
 #include <string>
+#include <vector>
 
+#include <dune/common/ftraits.hh>
 #include <dune/common/unused.hh>
 
 #include "preconditioner.hh"
@@ -18,6 +21,8 @@
 #include "matrixutils.hh"
 #include "gsetc.hh"
 #include "ilu.hh"
+#include "operators.hh"
+#include "spai.hh"
 
 
 namespace Dune {
@@ -555,6 +560,271 @@ namespace Dune {
   };
 
 
+  /*!
+     \brief Sequential incomplete Cholesky IC(0) preconditioner.
+
+     Wraps the naked ISTL generic IC(0) decomposition into the solver
+     framework. In contrast to SeqILU0 only the upper triangle of the
+     factorization is stored, which halves the memory and setup cost.
+     The matrix has to be real symmetric (positive definite).
+
+     \tparam M The matrix type to operate on
+     \tparam X Type of the update
+     \tparam Y Type of the defect
+     \tparam l Ignored. Just there to have the same number of template arguments
+     as other preconditioners.
+   */
+  template<class M, class X, class Y, int l=1>
+  class SeqIC0 : public Preconditioner<X,Y> {
+  public:
+    //! \brief The matrix type the preconditioner is for.
+    typedef typename Dune::remove_const<M>::type matrix_type;
+    //! \brief The domain type of the preconditioner.
+    typedef X domain_type;
+    //! \brief The range type of the preconditioner.
+    typedef Y range_type;
+    //! \brief The field type of the preconditioner.
+    typedef typename X::field_type field_type;
+
+    // define the category
+    enum {
+      //! \brief The category the preconditioner is part of.
+      category=SolverCategory::sequential
+    };
+
+    /*! \brief Constructor.
+
+       Constructor gets all parameters to operate the prec.
+       \param A The matrix to operate on.
+       \param w The relaxation factor.
+     */
+    SeqIC0 (const M& A, field_type w)
+      : IC(A.N(),A.M(),M::row_wise)
+    {
+      _w = w;
+      bic0_decomposition(A,IC);
+    }
+
+    /*!
+       \brief Prepare the preconditioner.
+
+       \copydoc Preconditioner::pre(X&,Y&)
+     */
+    virtual void pre (X& x, Y& b)
+    {
+      DUNE_UNUSED_PARAMETER(x);
+      DUNE_UNUSED_PARAMETER(b);
+    }
+
+    /*!
+       \brief Apply the preconditoner.
+
+       \copydoc Preconditioner::apply(X&,const Y&)
+     */
+    virtual void apply (X& v, const Y& d)
+    {
+      bic0_backsolve(IC,v,d);
+      v *= _w;
+    }
+
+    /*!
+       \brief Clean up.
+
+       \copydoc Preconditioner::post(X&)
+     */
+    virtual void post (X& x)
+    {
+      DUNE_UNUSED_PARAMETER(x);
+    }
+
+  private:
+    //! \brief The relaxation factor to use.
+    field_type _w;
+    //! \brief The upper triangle of the IC(0) decomposition of the matrix.
+    matrix_type IC;
+  };
+
+
+  /*!
+     \brief Sequential factorized sparse approximate inverse (FSAI) preconditioner.
+
+     Computes a lower triangular G with \f$ G^T G \approx A^{-1} \f$ on the
+     pattern of the lower triangle of \f$ A^{level} \f$. Applying the
+     preconditioner only needs two sparse matrix vector products and no
+     triangular solves. The matrix has to be symmetric positive definite.
+     \f$ G^T \f$ is stored explicitly, so that both products run row
+     parallel with OpenMP.
+
+     \tparam M The matrix type to operate on
+     \tparam X Type of the update
+     \tparam Y Type of the defect
+     \tparam l Ignored. Just there to have the same number of template arguments
+     as other preconditioners.
+   */
+  template<class M, class X, class Y, int l=1>
+  class SeqFSAI : public Preconditioner<X,Y> {
+  public:
+    //! \brief The matrix type the preconditioner is for.
+    typedef typename Dune::remove_const<M>::type matrix_type;
+    //! \brief The domain type of the preconditioner.
+    typedef X domain_type;
+    //! \brief The range type of the preconditioner.
+    typedef Y range_type;
+    //! \brief The field type of the preconditioner.
+    typedef typename X::field_type field_type;
+
+    // define the category
+    enum {
+      //! \brief The category the preconditioner is part of.
+      category=SolverCategory::sequential
+    };
+
+    /*! \brief Constructor.
+
+       Constructor gets all parameters to operate the prec.
+       \param A The matrix to operate on.
+       \param level The power of the pattern of A used for the pattern of G.
+       \param w The relaxation factor.
+     */
+    SeqFSAI (const M& A, int level, field_type w)
+      : G(A.N(),A.M(),M::row_wise), GT(A.M(),A.N(),M::row_wise), t(A.N())
+    {
+      _w = w;
+      fsai_decomposition(A,level,G);
+      matrix_transpose(G,GT);
+    }
+
+    /*!
+       \brief Prepare the preconditioner.
+
+       \copydoc Preconditioner::pre(X&,Y&)
+     */
+    virtual void pre (X& x, Y& b)
+    {
+      DUNE_UNUSED_PARAMETER(x);
+      DUNE_UNUSED_PARAMETER(b);
+    }
+
+    /*!
+       \brief Apply the preconditoner.
+
+       \copydoc Preconditioner::apply(X&,const Y&)
+     */
+    virtual void apply (X& v, const Y& d)
+    {
+      t = 0;
+      threadedUsmv(G,field_type(1),d,t);
+      v = 0;
+      threadedUsmv(GT,_w,t,v);
+    }
+
+    /*!
+       \brief Clean up.
+
+       \copydoc Preconditioner::post(X&)
+     */
+    virtual void post (X& x)
+    {
+      DUNE_UNUSED_PARAMETER(x);
+    }
+
+  private:
+    //! \brief The relaxation factor to use.
+    field_type _w;
+    //! \brief The lower triangular factor of the approximate inverse.
+    matrix_type G;
+    //! \brief The transpose of G.
+    matrix_type GT;
+    //! \brief Temporary vector for G d.
+    X t;
+  };
+
+
+  /*!
+     \brief Sequential sparse approximate inverse (SPAI) preconditioner.
+
+     Computes an approximate inverse of a general matrix on the pattern of
+     \f$ A^{level} \f$ by minimizing \f$ \|MI\,A-I\|_F \f$ row by row.
+     Applying the preconditioner is a single sparse matrix vector product.
+
+     \tparam M The matrix type to operate on
+     \tparam X Type of the update
+     \tparam Y Type of the defect
+     \tparam l Ignored. Just there to have the same number of template arguments
+     as other preconditioners.
+   */
+  template<class M, class X, class Y, int l=1>
+  class SeqSPAI : public Preconditioner<X,Y> {
+  public:
+    //! \brief The matrix type the preconditioner is for.
+    typedef typename Dune::remove_const<M>::type matrix_type;
+    //! \brief The domain type of the preconditioner.
+    typedef X domain_type;
+    //! \brief The range type of the preconditioner.
+    typedef Y range_type;
+    //! \brief The field type of the preconditioner.
+    typedef typename X::field_type field_type;
+
+    // define the category
+    enum {
+      //! \brief The category the preconditioner is part of.
+      category=SolverCategory::sequential
+    };
+
+    /*! \brief Constructor.
+
+       Constructor gets all parameters to operate the prec.
+       \param A The matrix to operate on.
+       \param level The power of the pattern of A used for the approximate inverse.
+       \param w The relaxation factor.
+     */
+    SeqSPAI (const M& A, int level, field_type w)
+      : MI(A.N(),A.M(),M::row_wise)
+    {
+      _w = w;
+      spai_decomposition(A,level,MI);
+    }
+
+    /*!
+       \brief Prepare the preconditioner.
+
+       \copydoc Preconditioner::pre(X&,Y&)
+     */
+    virtual void pre (X& x, Y& b)
+    {
+      DUNE_UNUSED_PARAMETER(x);
+      DUNE_UNUSED_PARAMETER(b);
+    }
+
+    /*!
+       \brief Apply the preconditoner.
+
+       \copydoc Preconditioner::apply(X&,const Y&)
+     */
+    virtual void apply (X& v, const Y& d)
+    {
+      v = 0;
+      threadedUsmv(MI,_w,d,v);
+    }
+
+    /*!
+       \brief Clean up.
+
+       \copydoc Preconditioner::post(X&)
+     */
+    virtual void post (X& x)
+    {
+      DUNE_UNUSED_PARAMETER(x);
+    }
+
+  private:
+    //! \brief The relaxation factor to use.
+    field_type _w;
+    //! \brief The approximate inverse.
+    matrix_type MI;
+  };
+
+
   /*!
      \brief Sequential ILU(n) preconditioner.
 
@@ -644,6 +914,208 @@ namespace Dune {
 
 
 
+  /*!
+     \brief Sequential Chebyshev polynomial preconditioner.
+
+     Applies a Chebyshev polynomial in the Jacobi preconditioned
+     operator \f$ D^{-1}A \f$ that damps the eigenvalues in the
+     interval \f$ [r\lambda_{max},\lambda_{max}] \f$.
+     The largest eigenvalue is estimated by a few power iterations
+     during construction. The application only needs matrix vector
+     products and vector updates, but no scalar products. Therefore it
+     is well suited as a smoother for (parallel) AMG.
+
+     The matrix is assumed to be symmetric positive definite.
+
+     \tparam M The matrix type to operate on
+     \tparam X Type of the update
+     \tparam Y Type of the defect
+     \tparam l Ignored. Just there to have the same number of template arguments
+     as other preconditioners.
+   */
+  template<class M, class X, class Y, int l=1>
+  class SeqChebyshev : public Preconditioner<X,Y> {
+  public:
+    //! \brief The matrix type the preconditioner is for.
+    typedef M matrix_type;
+    //! \brief The domain type of the preconditioner.
+    typedef X domain_type;
+    //! \brief The range type of the preconditioner.
+    typedef Y range_type;
+    //! \brief The field type of the preconditioner.
+    typedef typename X::field_type field_type;
+    //! \brief The real type of the field type.
+    typedef typename FieldTraits<field_type>::real_type real_type;
+
+    // define the category
+    enum {
+      //! \brief The category the preconditioner is part of.
+      category=SolverCategory::sequential
+    };
+
+    /*! \brief Constructor.
+
+       Constructor gets all parameters to operate the prec.
+       \param A The matrix to operate on.
+       \param n The degree of the polynomial, i.e. the number of
+       matrix vector products per application.
+       \param w The relaxation factor.
+       \param ratio The lower bound of the damped spectrum relative to
+       the estimated largest eigenvalue.
+       \param powerIterations The number of power iterations used to
+       estimate the largest eigenvalue of \f$ D^{-1}A \f$.
+       \param boost Safety factor the estimated eigenvalue is multiplied
+       with, as the power iteration approximates it from below.
+     */
+    SeqChebyshev (const M& A, int n, field_type w, real_type ratio=1.0/30.0,
+                  int powerIterations=10, real_type boost=1.1)
+      : _A_(A), _n(n), _w(w), _diag(A.N())
+    {
+      // store the inverted diagonal blocks
+      typedef typename M::ConstRowIterator rowiterator;
+      typedef typename M::ConstColIterator coliterator;
+      for (rowiterator i=_A_.begin(); i!=_A_.end(); ++i) {
+        coliterator ii=(*i).find(i.index());
+        if (ii==(*i).end())
+          DUNE_THROW(ISTLError,"SeqChebyshev: missing diagonal entry in row " << i.index());
+        _diag[i.index()] = *ii;
+        _diag[i.index()].invert();
+      }
+      _lambdaMax = boost*estimateMaxEigenvalue(powerIterations);
+      _lambdaMin = ratio*_lambdaMax;
+    }
+
+    /*!
+       \brief Prepare the preconditioner.
+
+       \copydoc Preconditioner::pre(X&,Y&)
+     */
+    virtual void pre (X& x, Y& b)
+    {
+      DUNE_UNUSED_PARAMETER(x);
+      DUNE_UNUSED_PARAMETER(b);
+    }
+
+    /*!
+       \brief Apply the preconditioner.
+
+       \copydoc Preconditioner::apply(X&,const Y&)
+     */
+    virtual void apply (X& v, const Y& d)
+    {
+      const real_type theta = (_lambdaMax+_lambdaMin)/2;
+      const real_type delta = (_lambdaMax-_lambdaMin)/2;
+      const real_type sigma = theta/delta;
+      real_type rho = 1/sigma;
+
+      Y r(d);                       // current defect
+      threadedUsmv(_A_,field_type(-1),v,r);
+      X p(v);                       // current correction
+      jacobi(r,p);
+      p *= 1/theta;
+      v += p;
+
+      for (int k=1; k<_n; ++k) {
+        threadedUsmv(_A_,field_type(-1),p,r); // update defect
+        real_type rhonew = 1/(2*sigma-rho);
+        p *= rhonew*rho;
+        jacobiAdd(2*rhonew/delta,r,p);
+        v += p;
+        rho = rhonew;
+      }
+      v *= _w;
+    }
+
+    /*!
+       \brief Clean up.
+
+       \copydoc Preconditioner::post(X&)
+     */
+    virtual void post (X& x)
+    {
+      DUNE_UNUSED_PARAMETER(x);
+    }
+
+    //! \brief The upper bound of the damped spectrum.
+    real_type maxEigenvalue () const
+    {
+      return _lambdaMax;
+    }
+
+    //! \brief The lower bound of the damped spectrum.
+    real_type minEigenvalue () const
+    {
+      return _lambdaMin;
+    }
+
+  private:
+    typedef typename M::block_type block_type;
+
+    //! \brief Compute \f$ p = D^{-1}r \f$.
+    void jacobi (const Y& r, X& p) const
+    {
+      const long rows = p.size();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+      for (long i=0; i<rows; ++i)
+        _diag[i].mv(r[i],p[i]);
+    }
+
+    //! \brief Compute \f$ p = p + \alpha D^{-1}r \f$.
+    void jacobiAdd (real_type alpha, const Y& r, X& p) const
+    {
+      const long rows = p.size();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+      for (long i=0; i<rows; ++i)
+        _diag[i].usmv(alpha,r[i],p[i]);
+    }
+
+    //! \brief Estimate the largest eigenvalue of \f$ D^{-1}A \f$ by power iteration.
+    real_type estimateMaxEigenvalue (int iterations) const
+    {
+      X x(_A_.N()), y(_A_.N());
+      Y z(_A_.N());
+      // deterministic pseudo random start vector, which is (almost surely)
+      // not orthogonal to the eigenvector we are looking for.
+      unsigned long seed = 12345;
+      for (typename X::size_type i=0; i<x.size(); ++i)
+        for (typename X::block_type::iterator j=x[i].begin(); j!=x[i].end(); ++j) {
+          seed = (1103515245*seed+12345) % 2147483648UL;
+          *j = 0.5 + static_cast<real_type>(seed)/2147483648.0;
+        }
+
+      real_type lambda = 0;
+      for (int k=0; k<std::max(iterations,1); ++k) {
+        x *= 1/x.two_norm();
+        z = 0;
+        threadedUsmv(_A_,field_type(1),x,z);
+        jacobi(z,y);
+        lambda = y.two_norm();
+        if (lambda==0)
+          DUNE_THROW(ISTLError,"SeqChebyshev: power iteration broke down");
+        x = y;
+      }
+      return lambda;
+    }
+
+    //! \brief The matrix we operate on.
+    const M& _A_;
+    //! \brief The degree of the polynomial.
+    int _n;
+    //! \brief The relaxation factor to use.
+    field_type _w;
+    //! \brief The inverted diagonal blocks.
+    std::vector<block_type> _diag;
+    //! \brief Upper bound of the damped spectrum.
+    real_type _lambdaMax;
+    //! \brief Lower bound of the damped spectrum.
+    real_type _lambdaMin;
+  };
+
+
   /*!
      \brief Richardson preconditioner.
 
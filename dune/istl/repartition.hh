@@ -3,9 +3,12 @@
 #ifndef DUNE_REPARTITION_HH
 #define DUNE_REPARTITION_HH
 
+#include <algorithm>
 #include <cassert>
 #include <map>
+#include <queue>
 #include <utility>
+#include <vector>
 
 #if HAVE_PARMETIS
 // Explicitly use C linkage as scotch does not extern "C" in its headers.
@@ -17,6 +20,7 @@ extern "C"
 }
 #endif
 
+#include <dune/common/exceptions.hh>
 #include <dune/common/timer.hh>
 #include <dune/common/unused.hh>
 #include <dune/common/enumset.hh>
@@ -750,6 +754,320 @@ namespace Dune
       }
       xadj[j] = ew.index();
     }
+
+    /**
+     * @brief Create the vertex weights of the owner vertices.
+     *
+     * The weight of a vertex is its entry in vertexCosts or, if that is
+     * empty, the number of nonzeros of its matrix row, i.e. the number
+     * of its edges plus the diagonal.
+     *
+     * @param graph the local graph.
+     * @param indexSet the local indexSet.
+     * @param vertexCosts The costs of the local vertices or an empty vector.
+     * @param vwgt The array to store the weights of the owner vertices in.
+     */
+    template<class F, class G, class IS>
+    void getVertexWeights(const G& graph, IS& indexSet, const std::vector<int>& vertexCosts,
+                          int* vwgt)
+    {
+      typedef typename G::ConstVertexIterator VertexIterator;
+      typedef typename G::ConstEdgeIterator EdgeIterator;
+
+      int j=0;
+      VertexIterator vend = graph.end();
+      for(VertexIterator vertex = graph.begin(); vertex != vend; ++vertex)
+        if (isOwner<F>(indexSet,*vertex)) {
+          if(vertexCosts.empty()) {
+            int nonzeros=1;
+            EdgeIterator eend = vertex.end();
+            for(EdgeIterator edge = vertex.begin(); edge != eend; ++edge)
+              ++nonzeros;
+            vwgt[j++]=nonzeros;
+          }else
+            vwgt[j++]=vertexCosts[*vertex];
+        }
+    }
+
+    /**
+     * @brief The number of nonzeros of the matrix rows owned by this process.
+     *
+     * Rows without an entry in the index set count as owned, as they
+     * become owner indices in fillIndexSetHoles.
+     *
+     * @param mat The local matrix.
+     * @param oocomm The parallel information about the matrix.
+     */
+    template<class M, class C>
+    int ownedNonzeroes(const M& mat, const C& oocomm)
+    {
+      typedef typename C::ParallelIndexSet::const_iterator IndexIterator;
+      int nonzeroes = mat.nonzeroes();
+      for(IndexIterator i=oocomm.indexSet().begin(); i!=oocomm.indexSet().end(); ++i)
+        if(i->local().attribute()!=OwnerOverlapCopyAttributeSet::owner)
+          nonzeroes -= mat[i->local().local()].getsize();
+      return nonzeroes;
+    }
+
+    /**
+     * @brief Print the load of the parts of a partitioning.
+     *
+     * The load of a part is the sum of the weights of its vertices. The
+     * imbalance is the ratio of the maximum and the average load.
+     *
+     * @param part The part of each local owner vertex.
+     * @param vwgt The weights of the local owner vertices.
+     * @param n The number of local owner vertices.
+     * @param nparts The number of parts.
+     * @param comm The communicator of the processes.
+     */
+    template<class T>
+    void printPartitionBalance(const T* part, const int* vwgt, std::size_t n, int nparts,
+                               MPI_Comm comm)
+    {
+      std::vector<long> load(nparts, 0), gload(nparts, 0);
+      for(std::size_t i=0; i<n; ++i)
+        load[part[i]]+=vwgt[i];
+      MPI_Allreduce(&load[0], &gload[0], nparts, MPI_LONG, MPI_SUM, comm);
+
+      int rank;
+      MPI_Comm_rank(comm, &rank);
+      if(rank==0) {
+        long sum=0, minLoad=gload[0], maxLoad=gload[0];
+        for(int p=0; p<nparts; ++p) {
+          sum+=gload[p];
+          minLoad=std::min(minLoad, gload[p]);
+          maxLoad=std::max(maxLoad, gload[p]);
+        }
+        double avg=static_cast<double>(sum)/nparts;
+        std::cout<<"Partition loads: min "<<minLoad<<" avg "<<avg<<" max "<<maxLoad
+                 <<", imbalance "<<(avg>0 ? maxLoad/avg : 1.0)<<std::endl;
+      }
+    }
+
+    /**
+     * @brief Partition a graph by greedy graph growing followed by a
+     * boundary refinement.
+     *
+     * Built-in replacement for METIS used if ParMETIS is not available.
+     * The parts are grown one after another by always adding the
+     * frontier vertex with the strongest connection to the part until
+     * the part holds its share of the remaining vertex weight. The first
+     * part starts at a pseudo peripheral vertex, all others at the
+     * frontier of the previous part. Afterwards vertices on the part
+     * boundaries are moved to neighbouring parts as long as this reduces
+     * the edge cut without violating the balance.
+     *
+     * @param n The number of vertices.
+     * @param xadj The offsets of the adjacency lists.
+     * @param adjncy The adjacency lists.
+     * @param vwgt The vertex weights or an empty vector for unit weights.
+     * @param adjwgt The edge weights or an empty vector for unit weights.
+     * @param nparts The number of parts.
+     * @param part Vector to store the part of each vertex in.
+     */
+    inline void partGraphGreedy(int n, const std::vector<int>& xadj, const std::vector<int>& adjncy,
+                                const std::vector<int>& vwgt, const std::vector<int>& adjwgt,
+                                int nparts, std::vector<int>& part)
+    {
+      part.assign(n, -1);
+      if(n==0)
+        return;
+
+      long totalWeight=0, maxVertexWeight=1;
+      for(int v=0; v<n; ++v) {
+        long w = vwgt.empty() ? 1 : vwgt[v];
+        totalWeight += w;
+        maxVertexWeight = std::max(maxVertexWeight, w);
+      }
+
+      // pseudo peripheral start vertex: the last one reached by a
+      // breadth first search from vertex 0
+      int seed=0;
+      {
+        std::vector<int> queue(1, 0);
+        std::vector<bool> visited(n, false);
+        visited[0]=true;
+        for(std::size_t q=0; q<queue.size(); ++q)
+          for(int e=xadj[queue[q]]; e<xadj[queue[q]+1]; ++e)
+            if(!visited[adjncy[e]]) {
+              visited[adjncy[e]]=true;
+              queue.push_back(adjncy[e]);
+            }
+        seed=queue.back();
+      }
+
+      // grow the parts
+      std::vector<long> partWeight(nparts, 0);
+      std::vector<long> gain(n, 0);
+      std::vector<int> touched;
+      long remaining=totalWeight;
+      int next=0;
+      typedef std::priority_queue<std::pair<long,int> > Frontier;
+      Frontier frontier;
+      frontier.push(std::make_pair(0L, seed));
+
+      for(int p=0; p<nparts; ++p) {
+        const long target = remaining/(nparts-p);
+
+        while(p==nparts-1 || partWeight[p]<target) {
+          // the frontier vertex with the strongest connection, stale
+          // entries are skipped
+          int v=-1;
+          while(!frontier.empty()) {
+            std::pair<long,int> top=frontier.top();
+            frontier.pop();
+            if(part[top.second]==-1 && top.first==gain[top.second]) {
+              v=top.second;
+              break;
+            }
+          }
+          if(v<0) {
+            // the connected component is exhausted
+            while(next<n && part[next]!=-1)
+              ++next;
+            if(next==n)
+              break;
+            v=next;
+          }
+
+          const long w = vwgt.empty() ? 1 : vwgt[v];
+          part[v]=p;
+          partWeight[p]+=w;
+          remaining-=w;
+          for(int e=xadj[v]; e<xadj[v+1]; ++e) {
+            int u=adjncy[e];
+            if(part[u]==-1) {
+              if(gain[u]==0)
+                touched.push_back(u);
+              gain[u]+= adjwgt.empty() ? 1 : adjwgt[e];
+              frontier.push(std::make_pair(gain[u], u));
+            }
+          }
+        }
+
+        // the next part starts at the frontier of this one
+        Frontier nextFrontier;
+        for(std::size_t i=0; i<touched.size(); ++i) {
+          gain[touched[i]]=0;
+          if(part[touched[i]]==-1)
+            nextFrontier.push(std::make_pair(0L, touched[i]));
+        }
+        touched.clear();
+        std::swap(frontier, nextFrontier);
+      }
+
+      // boundary refinement
+      const long maxWeight = static_cast<long>(1.03*totalWeight/nparts) + maxVertexWeight;
+      std::vector<long> connection(nparts, 0);
+      std::vector<int> neighbourParts;
+      for(int pass=0; pass<4; ++pass) {
+        int moved=0;
+        for(int v=0; v<n; ++v) {
+          const int from=part[v];
+          const long w = vwgt.empty() ? 1 : vwgt[v];
+          for(int e=xadj[v]; e<xadj[v+1]; ++e) {
+            int q=part[adjncy[e]];
+            if(connection[q]==0)
+              neighbourParts.push_back(q);
+            connection[q]+= adjwgt.empty() ? 1 : adjwgt[e];
+          }
+          int to=from;
+          long best=connection[from];
+          for(std::size_t i=0; i<neighbourParts.size(); ++i) {
+            int q=neighbourParts[i];
+            if(q!=from && (connection[q]>best ||
+                           (connection[q]==best && partWeight[q]+w<partWeight[to]))
+               && partWeight[q]+w<=maxWeight) {
+              to=q;
+              best=connection[q];
+            }
+          }
+          if(to!=from && partWeight[from]>w &&
+             (best>connection[from] || partWeight[to]+w<partWeight[from])) {
+            part[v]=to;
+            partWeight[from]-=w;
+            partWeight[to]+=w;
+            ++moved;
+          }
+          for(std::size_t i=0; i<neighbourParts.size(); ++i)
+            connection[neighbourParts[i]]=0;
+          neighbourParts.clear();
+        }
+        if(moved==0)
+          break;
+      }
+    }
+
+    /**
+     * @brief Partition a distributed graph with partGraphGreedy on process 0.
+     *
+     * The arrays have the same meaning as the ones passed to
+     * ParMETIS_V3_PartKway. The graphs that are repartitioned during the
+     * coarsening are small enough to be gathered on one process.
+     *
+     * @param vtxdist The range of the global vertex numbers of each process.
+     * @param xadj The offsets of the local adjacency lists.
+     * @param adjncy The local adjacency lists with global vertex numbers.
+     * @param vwgt The vertex weights or NULL for unit weights.
+     * @param adjwgt The edge weights or NULL for unit weights.
+     * @param nparts The number of parts.
+     * @param part Array to store the part of each local vertex in.
+     * @param comm The communicator of the processes.
+     */
+    inline void gatherAndPartGraph(const int* vtxdist, const int* xadj, const int* adjncy,
+                                   const int* vwgt, const int* adjwgt, int nparts,
+                                   int* part, MPI_Comm comm)
+    {
+      int rank, procs;
+      MPI_Comm_rank(comm, &rank);
+      MPI_Comm_size(comm, &procs);
+      const int n = vtxdist[rank+1]-vtxdist[rank];
+      const int gn = vtxdist[procs];
+      int noEdges = xadj[n]-xadj[0];
+
+      std::vector<int> vtxCounts(procs), edgeCounts(procs), edgeDispl(procs+1, 0);
+      for(int p=0; p<procs; ++p)
+        vtxCounts[p]=vtxdist[p+1]-vtxdist[p];
+      MPI_Gather(&noEdges, 1, MPI_INT, &edgeCounts[0], 1, MPI_INT, 0, comm);
+      for(int p=0; p<procs; ++p)
+        edgeDispl[p+1]=edgeDispl[p]+edgeCounts[p];
+
+      // the degrees are gathered instead of the offsets
+      std::vector<int> degree(n+1);
+      for(int i=0; i<n; ++i)
+        degree[i]=xadj[i+1]-xadj[i];
+
+      const bool root = rank==0;
+      std::vector<int> gxadj(root ? gn+1 : 1, 0), gadjncy(root ? edgeDispl[procs]+1 : 1);
+      std::vector<int> gvwgt, gadjwgt;
+      MPI_Gatherv(&degree[0], n, MPI_INT, &gxadj[1], &vtxCounts[0],
+                  const_cast<int*>(vtxdist), MPI_INT, 0, comm);
+      MPI_Gatherv(const_cast<int*>(adjncy+xadj[0]), noEdges, MPI_INT, &gadjncy[0],
+                  &edgeCounts[0], &edgeDispl[0], MPI_INT, 0, comm);
+      if(vwgt) {
+        gvwgt.resize(root ? gn+1 : 1);
+        MPI_Gatherv(const_cast<int*>(vwgt), n, MPI_INT, &gvwgt[0], &vtxCounts[0],
+                    const_cast<int*>(vtxdist), MPI_INT, 0, comm);
+        gvwgt.resize(root ? gn : 0);
+      }
+      if(adjwgt) {
+        gadjwgt.resize(root ? edgeDispl[procs]+1 : 1);
+        MPI_Gatherv(const_cast<int*>(adjwgt+xadj[0]), noEdges, MPI_INT, &gadjwgt[0],
+                    &edgeCounts[0], &edgeDispl[0], MPI_INT, 0, comm);
+        gadjwgt.resize(root ? edgeDispl[procs] : 0);
+      }
+
+      std::vector<int> gpart(1);
+      if(root) {
+        for(int i=0; i<gn; ++i)
+          gxadj[i+1]+=gxadj[i];
+        partGraphGreedy(gn, gxadj, gadjncy, gvwgt, gadjwgt, nparts, gpart);
+        gpart.resize(gn+1);
+      }
+      MPI_Scatterv(&gpart[0], &vtxCounts[0], const_cast<int*>(vtxdist), MPI_INT,
+                   part, n, MPI_INT, 0, comm);
+    }
   } // end anonymous namespace
 
   template<class G, class T1, class T2>
@@ -845,6 +1163,30 @@ namespace Dune
 #if !HAVE_PARMETIS
     int* part = new int[1];
     part[0]=0;
+
+    if(nparts>1) {
+      // No ParMETIS available: partition the communication graph, with
+      // one vertex per process weighted by the nonzeros of its owned
+      // rows, with the built-in partitioner.
+      typedef typename  Dune::OwnerOverlapCopyCommunication<T1,T2>::RemoteIndices RemoteIndices;
+      typedef typename RemoteIndices::const_iterator NeighbourIterator;
+
+      std::vector<int> adjncy;
+      for(NeighbourIterator n= oocomm.remoteIndices().begin(); n !=  oocomm.remoteIndices().end();
+          ++n)
+        if(n->first!=rank)
+          adjncy.push_back(n->first);
+      int xadj[2] = {0, static_cast<int>(adjncy.size())};
+      adjncy.push_back(0);
+
+      std::vector<int> vtxdist(oocomm.communicator().size()+1);
+      for(std::size_t i=0; i<vtxdist.size(); ++i)
+        vtxdist[i]=i;
+      int vwgt = ownedNonzeroes(mat, oocomm);
+
+      gatherAndPartGraph(&vtxdist[0], xadj, &adjncy[0], &vwgt, NULL, nparts, part,
+                         oocomm.communicator());
+    }
 #else
     idxtype* part = new idxtype[1]; // where all our data moves to
 
@@ -923,7 +1265,7 @@ namespace Dune
 
 #ifdef USE_WEIGHTS
         vwgt   = new idxtype[1];
-        vwgt[0]= mat.N(); // weight is numer of rows TODO: Should actually be the nonzeros.
+        vwgt[0]= ownedNonzeroes(mat, oocomm); // the cost of a matrix-vector product
 
         adjwgt = new idxtype[noNeighbours];
         idxtype* adjwp=adjwgt;
@@ -1219,7 +1561,14 @@ namespace Dune
    * @brief execute a graph repartition for a giving graph and indexset.
    *
    * This function provides repartition functionality using the
-   * PARMETIS library
+   * PARMETIS library. If ParMETIS is not available the graph is gathered
+   * on process 0 and partitioned by a built-in greedy graph growing
+   * partitioner instead.
+   *
+   * The partitioning balances the cost of the vertices. By default the
+   * cost of a vertex is the number of nonzeros of its matrix row, which
+   * is proportional to its share of a matrix-vector product.
+   * If verbose is true, the loads of the new domains are reported.
    *
    * @param graph The given graph to repartition
    * @param oocomm The parallel information about the graph.
@@ -1227,14 +1576,21 @@ namespace Dune
    * @param[out] outcomm Pointer store the parallel information of the
    * redistributed domains in.
    * @param redistInf Redistribute interface
+   * @param vertexCosts The costs of the local vertices. If empty the
+   * number of nonzeros of the matrix rows is used.
    * @param verbose Verbosity flag to give out additional information.
    */
   template<class G, class T1, class T2>
   bool graphRepartition(const G& graph, Dune::OwnerOverlapCopyCommunication<T1,T2>& oocomm, int nparts,
                         Dune::OwnerOverlapCopyCommunication<T1,T2>*& outcomm,
                         RedistributeInterface& redistInf,
+                        const std::vector<int>& vertexCosts,
                         bool verbose=false)
   {
+    if(!vertexCosts.empty() && vertexCosts.size()!=graph.noVertices())
+      DUNE_THROW(RangeError, "graphRepartition: "<<vertexCosts.size()
+                 <<" vertex costs given for "<<graph.noVertices()<<" vertices");
+
     Timer time;
 
     MPI_Comm comm=oocomm.communicator();
@@ -1291,12 +1647,32 @@ namespace Dune
     for(std::size_t i=0; i < indexMap.numOfOwnVtx(); ++i)
       part[i]=mype;
 
+    // The weights of the owner vertices
+    std::vector<int> vwgt(indexMap.numOfOwnVtx()+1);
+    getVertexWeights<OwnerSet>(graph, oocomm.globalLookup(), vertexCosts, &vwgt[0]);
+
 #if !HAVE_PARMETIS
-    if(oocomm.communicator().rank()==0 && nparts>1)
-      std::cerr<<"ParMETIS not activated. Will repartition to 1 domain instead of requested "
-               <<nparts<<" domains."<<std::endl;
-    nparts=1; // No parmetis available, fallback to agglomerating to 1 process
+    if(nparts>1) {
+      // No ParMETIS available, partition with the built-in partitioner
+      std::vector<int> xadj(indexMap.numOfOwnVtx()+1);
+      std::vector<int> adjncy(graph.noEdges()+1);
+      EdgeFunctor<G> ef(&adjncy[0], indexMap, graph.noEdges());
+      getAdjArrays<OwnerSet>(graph, oocomm.globalLookup(), &xadj[0], ef);
+
+      std::vector<int> ownPart(indexMap.numOfOwnVtx()+1);
+      gatherAndPartGraph(indexMap.vtxDist(), &xadj[0], &adjncy[0], &vwgt[0],
+                         ef.getWeights(), nparts, &ownPart[0], comm);
+      ef.free();
+      for(std::size_t i=0; i < indexMap.numOfOwnVtx(); ++i)
+        part[i]=ownPart[i];
 
+      if(verbose) {
+        oocomm.communicator().barrier();
+        if(oocomm.communicator().rank()==0)
+          std::cout<<"Built-in partitioning took "<<time.elapsed()<<std::endl;
+      }
+      time.reset();
+    }else
 #else
 
     if(nparts>1) {
@@ -1323,7 +1699,8 @@ namespace Dune
       options[1] = 0; // show info: 0=no message
 #endif
       options[2] = 1; // random number seed, default is 15
-      wgtflag = (ef.getWeights()!=NULL) ? 1 : 0;
+      // vertex weights and, if available, edge weights
+      wgtflag = (ef.getWeights()!=NULL) ? 3 : 2;
       numflag = 0;
       edgecut = 0;
       ncon=1;
@@ -1355,7 +1732,7 @@ namespace Dune
       // ParMETIS_V3_PartKway
       //=======================================================
       ParMETIS_V3_PartKway(indexMap.vtxDist(), xadj, adjncy,
-                           NULL, ef.getWeights(), &wgtflag,
+                           &vwgt[0], ef.getWeights(), &wgtflag,
                            &numflag, &ncon, &nparts, tpwgts, ubvec, options, &edgecut, part, &const_cast<MPI_Comm&>(comm));
 
 
@@ -1408,6 +1785,9 @@ namespace Dune
     //    result
     //
 
+    if(verbose)
+      printPartitionBalance(part, &vwgt[0], indexMap.numOfOwnVtx(), nparts, comm);
+
     std::vector<int> domainMapping(nparts);
     if(nparts>1)
       getDomain(comm, part, indexMap.numOfOwnVtx(), nparts, &myDomain, domainMapping);
@@ -1453,6 +1833,29 @@ namespace Dune
     return ret;
   }
 
+  /**
+   * @brief execute a graph repartition for a giving graph and indexset.
+   *
+   * The cost of each vertex is the number of nonzeros of its matrix row.
+   *
+   * @param graph The given graph to repartition
+   * @param oocomm The parallel information about the graph.
+   * @param nparts The number of domains the repartitioning should achieve.
+   * @param[out] outcomm Pointer store the parallel information of the
+   * redistributed domains in.
+   * @param redistInf Redistribute interface
+   * @param verbose Verbosity flag to give out additional information.
+   */
+  template<class G, class T1, class T2>
+  bool graphRepartition(const G& graph, Dune::OwnerOverlapCopyCommunication<T1,T2>& oocomm, int nparts,
+                        Dune::OwnerOverlapCopyCommunication<T1,T2>*& outcomm,
+                        RedistributeInterface& redistInf,
+                        bool verbose=false)
+  {
+    return graphRepartition(graph, oocomm, nparts, outcomm, redistInf, std::vector<int>(),
+                            verbose);
+  }
+
 
 
   template<class G, class T1, class T2>
@@ -1898,6 +2301,20 @@ namespace Dune
       DUNE_THROW(NotImplemented, "only available for MPI programs");
   }
 
+  template<class G, class P, class R>
+  bool graphRepartition(const G&, P& oocomm, int nparts,
+                        P*& outcomm,
+                        R&,
+                        const std::vector<int>&,
+                        bool=false)
+  {
+    if(nparts!=oocomm.size())
+      DUNE_THROW(NotImplemented, "only available for MPI programs");
+    // nothing is repartitioned
+    outcomm = 0;
+    return false;
+  }
+
 
   template<class G, class P,class T1, class T2, class R>
   bool commGraphRepartition(const G& graph, P& oocomm, int nparts,
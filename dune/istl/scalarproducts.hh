@@ -3,12 +3,15 @@
 #ifndef DUNE_SCALARPRODUCTS_HH
 #define DUNE_SCALARPRODUCTS_HH
 
+#include <algorithm>
 #include <cmath>
 #include <complex>
 #include <iostream>
 #include <iomanip>
 #include <string>
+#include <vector>
 
+#include "bvector.hh"
 #include "solvercategory.hh"
 
 
@@ -57,6 +60,66 @@ namespace Dune {
      */
     virtual double norm (const X& x) = 0;
 
+    /*! \brief Update a defect and compute its norm.
+
+       Computes \f$ y = y + a x \f$ and returns the norm of the updated y.
+       The default implementation does the update and the norm one after
+       the other, implementations may fuse them into one sweep over the
+       vectors.
+     */
+    virtual double axpyNorm (X& y, field_type a, const X& x)
+    {
+      y.axpy(a,x);
+      return norm(y);
+    }
+
+    /*! \brief Start the computation of several dot products.
+
+       Computes \f$ result_k = x_k \cdot y_k \f$ for all k. Parallel
+       implementations combine all products into a single global reduction,
+       which is started without blocking. Therefore the values in result must
+       not be used before wait() was called. At most one computation may be
+       pending at a time and the vectors must not be changed before wait()
+       returns. The default implementation computes the products
+       immediately.
+     */
+    virtual void idots (const std::vector<const X*>& x, const std::vector<const X*>& y,
+                        std::vector<field_type>& result)
+    {
+      result.resize(x.size());
+      for (typename std::vector<const X*>::size_type k=0; k<x.size(); ++k)
+        result[k] = dot(*x[k],*y[k]);
+    }
+
+    /*! \brief Wait for the dot products started by idots() to finish.
+     */
+    virtual void wait ()
+    {}
+
+    /*! \brief Compute several dot products and norms at once.
+
+       Computes \f$ dots_k = x_k \cdot y_k \f$ and \f$ norms_l = \|z_l\| \f$.
+       All of them are computed by a single call of idots(), so parallel
+       implementations need only one global reduction. The norms are
+       taken from the dot products of the vectors with themselves, the
+       vectors z_l have to be consistent like for norm().
+     */
+    void dotsAndNorms (const std::vector<const X*>& x, const std::vector<const X*>& y,
+                       std::vector<field_type>& dots,
+                       const std::vector<const X*>& z, std::vector<double>& norms)
+    {
+      typedef typename std::vector<const X*>::size_type size_type;
+      std::vector<const X*> left(x), right(y);
+      left.insert(left.end(),z.begin(),z.end());
+      right.insert(right.end(),z.begin(),z.end());
+      std::vector<field_type> result;
+      idots(left,right,result);
+      wait();
+      dots.assign(result.begin(),result.begin()+x.size());
+      norms.resize(z.size());
+      for (size_type l=0; l<z.size(); ++l)
+        norms[l] = std::sqrt(std::max(static_cast<double>(std::real(result[x.size()+l])),0.0));
+    }
 
     //! every abstract base class has a virtual destructor
     virtual ~ScalarProduct () {}
@@ -110,6 +173,15 @@ namespace Dune {
       return x.dot(y);
     }
 
+    /*! \brief Compute several dot products in a single sweep over the vectors.
+       The results are available immediately.
+     */
+    virtual void idots (const std::vector<const X*>& x, const std::vector<const X*>& y,
+                        std::vector<field_type>& result)
+    {
+      fusedDots(x,y,result);
+    }
+
     /*! \brief Norm of a right-hand side vector.
        The vector must be consistent on the interior+border partition
      */
@@ -117,6 +189,13 @@ namespace Dune {
     {
       return static_cast<double>(x.two_norm());
     }
+
+    /*! \brief Update a defect and compute its norm in a single sweep over the vectors.
+     */
+    virtual double axpyNorm (X& y, field_type a, const X& x)
+    {
+      return std::sqrt(static_cast<double>(fusedAxpyNorm2(y,a,x)));
+    }
   };
 
   template<class X, class C>
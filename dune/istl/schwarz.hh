@@ -12,6 +12,10 @@
 
 #include <dune/common/timer.hh>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include "io.hh"
 #include "bvector.hh"
 #include "vbvector.hh"
@@ -118,7 +122,7 @@ namespace Dune {
     virtual void apply (const X& x, Y& y) const
     {
       y = 0;
-      _A_.umv(x,y);     // result is consistent on interior+border
+      threadedUsmv(_A_,field_type(1),x,y);     // result is consistent on interior+border
       communication.project(y);     // we want this here to avoid it before the preconditioner
                                     // since there d is const!
     }
@@ -126,7 +130,7 @@ namespace Dune {
     //! apply operator to x, scale and add:  \f$ y = y + \alpha A(x) \f$
     virtual void applyscaleadd (field_type alpha, const X& x, Y& y) const
     {
-      _A_.usmv(alpha,x,y);     // result is consistent on interior+border
+      threadedUsmv(_A_,alpha,x,y);     // result is consistent on interior+border
       communication.project(y);     // we want this here to avoid it before the preconditioner
                                     // since there d is const!
     }
@@ -206,6 +210,22 @@ namespace Dune {
       return communication.norm(x);
     }
 
+    /*! \brief Start several dot products with one non-blocking global reduction.
+       The results are valid only after wait() was called.
+     */
+    virtual void idots (const std::vector<const X*>& x, const std::vector<const X*>& y,
+                        std::vector<field_type>& result)
+    {
+      communication.localDots(x,y,result);
+      communication.startSum(result);
+    }
+
+    //! \brief Wait for the reduction started by idots().
+    virtual void wait ()
+    {
+      communication.waitSum();
+    }
+
   private:
     const communication_type& communication;
   };
@@ -276,9 +296,15 @@ namespace Dune {
        \param w The relaxation factor.
        \param c The communication object for syncing overlap and copy
      * data points. (E.~g. OwnerOverlapCopyCommunication )
+       \param threaded If true and compiled with OpenMP support, the rows
+       are split into one contiguous range per thread, which are relaxed
+       concurrently. This is SOR inside the ranges and Jacobi between
+       them, so the convergence depends on the number of threads.
+       Otherwise the sweeps are sequential.
      */
-    ParSSOR (const matrix_type& A, int n, field_type w, const communication_type& c)
-      : _A_(A), _n(n), _w(w), communication(c)
+    ParSSOR (const matrix_type& A, int n, field_type w, const communication_type& c,
+             bool threaded=false)
+      : _A_(A), _n(n), _w(w), communication(c), _threaded(threaded)
     {   }
 
     /*!
@@ -298,6 +324,16 @@ namespace Dune {
      */
     virtual void apply (X& v, const Y& d)
     {
+#ifdef _OPENMP
+      if (_threaded && omp_get_max_threads()>1) {
+        for (int i=0; i<_n; i++) {
+          threadedSweep(v,d,true);
+          threadedSweep(v,d,false);
+        }
+        communication.copyOwnerToAll(v,v);
+        return;
+      }
+#endif
       for (int i=0; i<_n; i++) {
         bsorf(_A_,v,d,_w);
         bsorb(_A_,v,d,_w);
@@ -313,6 +349,50 @@ namespace Dune {
     virtual void post (X& x) {}
 
   private:
+#ifdef _OPENMP
+    /*!
+       \brief One forward or backward SOR sweep distributed over the threads.
+
+       Each thread relaxes a contiguous range of rows with the newest
+       values of its own range and the values from before the sweep for
+       all other rows, i.e. SOR inside the ranges and Jacobi coupling
+       between them.
+     */
+    void threadedSweep (X& v, const Y& d, bool forward)
+    {
+      typedef typename matrix_type::ConstColIterator ColIterator;
+      const X old(v);
+      const long rows = _A_.N();
+#pragma omp parallel
+      {
+        const long threads = omp_get_num_threads();
+        const long thread = omp_get_thread_num();
+        const long begin = rows*thread/threads;
+        const long end = rows*(thread+1)/threads;
+        typename Y::block_type rhs;
+        typename X::block_type c;
+        if (begin<end)
+          c = v[begin];
+        for (long k=0; k<end-begin; ++k)
+        {
+          const long i = forward ? begin+k : end-1-k;
+          rhs = d[i];
+          ColIterator diag = _A_[i].end();
+          ColIterator endj = _A_[i].end();
+          for (ColIterator j=_A_[i].begin(); j!=endj; ++j)
+          {
+            const long col = j.index();
+            if (col==i)
+              diag = j;
+            (*j).mmv((col>=begin && col<end) ? v[col] : old[col], rhs);
+          }
+          (*diag).solve(c,rhs);
+          v[i].axpy(_w,c);
+        }
+      }
+    }
+#endif
+
     //! \brief The matrix we operate on.
     const matrix_type& _A_;
     //! \brief The number of steps to do in apply
@@ -321,6 +401,8 @@ namespace Dune {
     field_type _w;
     //! \brief the communication object
     const communication_type& communication;
+    //! \brief Whether to use the hybrid threaded sweeps
+    bool _threaded;
   };
 
   namespace Amg
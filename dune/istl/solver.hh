@@ -7,6 +7,8 @@
 #include <iomanip>
 #include <ostream>
 
+#include <dune/common/timer.hh>
+
 namespace Dune
 {
 /**
@@ -63,6 +65,90 @@ namespace Dune
   };
 
 
+  /**
+     \brief Time spent in the phases of an iterative solver.
+
+     The times are only measured while a SolverObserver is registered
+     with the solver.
+   */
+  struct SolverPhaseTimes
+  {
+    /** \brief Default constructor */
+    SolverPhaseTimes ()
+      : enabled(false)
+    {
+      clear();
+    }
+
+    /** \brief Resets all times */
+    void clear ()
+    {
+      operatorTime = 0;
+      preconditionerTime = 0;
+      scalarProductTime = 0;
+    }
+
+    /** \brief True if the times are measured */
+    bool enabled;
+
+    /** \brief Time spent in the application of the operator in seconds */
+    double operatorTime;
+
+    /** \brief Time spent in the preconditioner in seconds */
+    double preconditionerTime;
+
+    /** \brief Time spent in scalar products and norms in seconds */
+    double scalarProductTime;
+  };
+
+  /**
+     \brief Statistics about a single iteration of an iterative solver
+
+     Passed to a SolverObserver after each iteration. All times are
+     accumulated since the start of the solve.
+   */
+  struct IterationStatistics
+  {
+    /** \brief Number of the iteration, solvers with half steps like BiCGSTAB also report those */
+    double iteration;
+
+    /** \brief Norm of the defect monitored by the solver */
+    double defect;
+
+    /** \brief Reduction achieved: defect divided by the initial defect */
+    double reduction;
+
+    /** \brief Elapsed time in seconds */
+    double elapsed;
+
+    /** \brief Time spent in the operator, preconditioner and scalar products */
+    SolverPhaseTimes times;
+  };
+
+  /**
+     \brief Interface for monitoring the iterations of a solver.
+
+     An observer registered with InverseOperator::setObserver() is
+     called after each iteration of the iterative solvers in solvers.hh.
+     It can be used to log the convergence history or to stop an
+     iteration that stagnates.
+   */
+  class SolverObserver
+  {
+  public:
+    /**
+       \brief Called after each iteration.
+
+       \param statistics The statistics of the iteration.
+       \return false to stop the solver. The solve is then reported as not converged.
+     */
+    virtual bool iteration (const IterationStatistics& statistics) = 0;
+
+    //! every abstract base class has a virtual destructor
+    virtual ~SolverObserver () {}
+  };
+
+
   //=====================================================================
   /*!
      \brief Abstract base class for all solvers.
@@ -87,6 +173,11 @@ namespace Dune
     /** \brief The field type of the operator. */
     typedef typename X::field_type field_type;
 
+    //! \brief Constructor, no observer is registered.
+    InverseOperator ()
+      : _observer(0)
+    {}
+
     /**
         \brief Apply inverse operator,
 
@@ -110,10 +201,69 @@ namespace Dune
      */
     virtual void apply (X& x, Y& b, double reduction, InverseOperatorResult& res) = 0;
 
+    /**
+       \brief Register an observer that is called after each iteration.
+
+       Passing a null pointer removes the observer. While an observer is
+       registered the time spent in the different phases of the solver
+       is measured. The observer is not owned by the solver.
+     */
+    void setObserver (SolverObserver* observer)
+    {
+      _observer = observer;
+      _phaseTimes.enabled = (observer!=0);
+    }
+
+    //! \brief The registered observer or a null pointer.
+    SolverObserver* observer () const
+    {
+      return _observer;
+    }
+
     //! \brief Destructor
     virtual ~InverseOperator () {}
 
+  private:
+    // Solvers are not copyable: their timed operator, preconditioner and
+    // scalar product wrappers refer to the phase times of the object
+    // they were constructed in.
+    InverseOperator (const InverseOperator&);
+    InverseOperator& operator= (const InverseOperator&);
+
   protected:
+    //! helper function to be called at the start of a solve, resets the timers
+    void startObservation ()
+    {
+      _phaseTimes.clear();
+      _observationTimer.reset();
+    }
+
+    /**
+       \brief helper function to report an iteration to the observer
+
+       \return false if the observer requests to stop the solver
+     */
+    template <class DataType>
+    bool observeIteration (double iteration, const DataType& defect, const DataType& defect0)
+    {
+      if (!_observer)
+        return true;
+      IterationStatistics statistics;
+      statistics.iteration = iteration;
+      statistics.defect = static_cast<double>(defect);
+      statistics.reduction = static_cast<double>(defect/defect0);
+      statistics.elapsed = _observationTimer.elapsed();
+      statistics.times = _phaseTimes;
+      return _observer->iteration(statistics);
+    }
+
+    //! the observer notified after each iteration
+    SolverObserver* _observer;
+    //! time spent in the phases of the current solve
+    SolverPhaseTimes _phaseTimes;
+    //! timer for the current solve
+    Timer _observationTimer;
+
     // spacing values
     enum { iterationSpacing = 5 , normSpacing = 16 };
 
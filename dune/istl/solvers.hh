@@ -4,21 +4,27 @@
 #ifndef DUNE_SOLVERS_HH
 #define DUNE_SOLVERS_HH
 
+#include <algorithm>
 #include <cmath>
 #include <complex>
 #include <iostream>
 #include <iomanip>
+#include <limits>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "istlexception.hh"
+#include "bvector.hh"
 #include "operators.hh"
 #include "scalarproducts.hh"
 #include "solver.hh"
 #include "preconditioner.hh"
 #include <dune/common/array.hh>
 #include <dune/common/deprecated.hh>
+#include <dune/common/dynmatrix.hh>
+#include <dune/common/dynvector.hh>
 #include <dune/common/timer.hh>
 #include <dune/common/ftraits.hh>
 #include <dune/common/typetraits.hh>
@@ -45,6 +51,199 @@ namespace Dune {
   // Implementation of this interface
   //=====================================================================
 
+  /*!
+     \brief Linear operator used by the solvers, which measures the time
+     spent in the wrapped operator while an observer is registered.
+   */
+  template<class X, class Y>
+  class TimedLinearOperator : public LinearOperator<X,Y> {
+  public:
+    //! \brief The field type of the operator.
+    typedef typename X::field_type field_type;
+
+    //! \brief Wrap op, the time is accumulated in times.
+    TimedLinearOperator (LinearOperator<X,Y>& op, SolverPhaseTimes& times) :
+      _op(op), _times(times)
+    {}
+
+    virtual void apply (const X& x, Y& y) const
+    {
+      if (!_times.enabled) {
+        _op.apply(x,y);
+        return;
+      }
+      Timer watch;
+      _op.apply(x,y);
+      _times.operatorTime += watch.elapsed();
+    }
+
+    virtual void applyscaleadd (field_type alpha, const X& x, Y& y) const
+    {
+      if (!_times.enabled) {
+        _op.applyscaleadd(alpha,x,y);
+        return;
+      }
+      Timer watch;
+      _op.applyscaleadd(alpha,x,y);
+      _times.operatorTime += watch.elapsed();
+    }
+
+    virtual void applyMultiple (const std::vector<const X*>& x, const std::vector<Y*>& y) const
+    {
+      if (!_times.enabled) {
+        _op.applyMultiple(x,y);
+        return;
+      }
+      Timer watch;
+      _op.applyMultiple(x,y);
+      _times.operatorTime += watch.elapsed();
+    }
+
+  private:
+    LinearOperator<X,Y>& _op;
+    SolverPhaseTimes& _times;
+  };
+
+  /*!
+     \brief Preconditioner used by the solvers, which measures the time
+     spent in the wrapped preconditioner while an observer is registered.
+   */
+  template<class X, class Y>
+  class TimedPreconditioner : public Preconditioner<X,Y> {
+  public:
+    //! \brief Wrap prec, the time is accumulated in times.
+    TimedPreconditioner (Preconditioner<X,Y>& prec, SolverPhaseTimes& times) :
+      _prec(prec), _times(times)
+    {}
+
+    virtual void pre (X& x, Y& b)
+    {
+      if (!_times.enabled) {
+        _prec.pre(x,b);
+        return;
+      }
+      Timer watch;
+      _prec.pre(x,b);
+      _times.preconditionerTime += watch.elapsed();
+    }
+
+    virtual void apply (X& v, const Y& d)
+    {
+      if (!_times.enabled) {
+        _prec.apply(v,d);
+        return;
+      }
+      Timer watch;
+      _prec.apply(v,d);
+      _times.preconditionerTime += watch.elapsed();
+    }
+
+    virtual void applyMultiple (const std::vector<X*>& v, const std::vector<const Y*>& d)
+    {
+      if (!_times.enabled) {
+        _prec.applyMultiple(v,d);
+        return;
+      }
+      Timer watch;
+      _prec.applyMultiple(v,d);
+      _times.preconditionerTime += watch.elapsed();
+    }
+
+    virtual void post (X& x)
+    {
+      if (!_times.enabled) {
+        _prec.post(x);
+        return;
+      }
+      Timer watch;
+      _prec.post(x);
+      _times.preconditionerTime += watch.elapsed();
+    }
+
+  private:
+    Preconditioner<X,Y>& _prec;
+    SolverPhaseTimes& _times;
+  };
+
+  /*!
+     \brief Scalar product used by the solvers, which measures the time
+     spent in the wrapped scalar product while an observer is registered.
+
+     For the non-blocking ScalarProduct::idots() only the time spent in
+     idots() and wait() is measured, not the work overlapped with the
+     reduction.
+   */
+  template<class X>
+  class TimedScalarProduct : public ScalarProduct<X> {
+  public:
+    //! \brief The field type of the scalar product.
+    typedef typename X::field_type field_type;
+
+    //! \brief Wrap sp, the time is accumulated in times.
+    TimedScalarProduct (ScalarProduct<X>& sp, SolverPhaseTimes& times) :
+      _sp(sp), _times(times)
+    {}
+
+    virtual field_type dot (const X& x, const X& y)
+    {
+      if (!_times.enabled)
+        return _sp.dot(x,y);
+      Timer watch;
+      field_type result = _sp.dot(x,y);
+      _times.scalarProductTime += watch.elapsed();
+      return result;
+    }
+
+    virtual double norm (const X& x)
+    {
+      if (!_times.enabled)
+        return _sp.norm(x);
+      Timer watch;
+      double result = _sp.norm(x);
+      _times.scalarProductTime += watch.elapsed();
+      return result;
+    }
+
+    virtual double axpyNorm (X& y, field_type a, const X& x)
+    {
+      if (!_times.enabled)
+        return _sp.axpyNorm(y,a,x);
+      Timer watch;
+      double result = _sp.axpyNorm(y,a,x);
+      _times.scalarProductTime += watch.elapsed();
+      return result;
+    }
+
+    virtual void idots (const std::vector<const X*>& x, const std::vector<const X*>& y,
+                        std::vector<field_type>& result)
+    {
+      if (!_times.enabled) {
+        _sp.idots(x,y,result);
+        return;
+      }
+      Timer watch;
+      _sp.idots(x,y,result);
+      _times.scalarProductTime += watch.elapsed();
+    }
+
+    virtual void wait ()
+    {
+      if (!_times.enabled) {
+        _sp.wait();
+        return;
+      }
+      Timer watch;
+      _sp.wait();
+      _times.scalarProductTime += watch.elapsed();
+    }
+
+  private:
+    ScalarProduct<X>& _sp;
+    SolverPhaseTimes& _times;
+  };
+
+
+
   /*!
      \brief Preconditioned loop solver.
 
@@ -87,7 +286,7 @@ namespace Dune {
     template<class L, class P>
     LoopSolver (L& op, P& prec,
                 real_type reduction, int maxit, int verbose) :
-      ssp(), _op(op), _prec(prec), _sp(ssp), _reduction(reduction), _maxit(maxit), _verbose(verbose)
+      ssp(), _op(op,this->_phaseTimes), _prec(prec,this->_phaseTimes), _sp(ssp,this->_phaseTimes), _reduction(reduction), _maxit(maxit), _verbose(verbose)
     {
       static_assert(static_cast<int>(L::category) == static_cast<int>(P::category),
                     "L and P have to have the same category!");
@@ -118,7 +317,7 @@ namespace Dune {
     template<class L, class S, class P>
     LoopSolver (L& op, S& sp, P& prec,
                 real_type reduction, int maxit, int verbose) :
-      _op(op), _prec(prec), _sp(sp), _reduction(reduction), _maxit(maxit), _verbose(verbose)
+      _op(op,this->_phaseTimes), _prec(prec,this->_phaseTimes), _sp(sp,this->_phaseTimes), _reduction(reduction), _maxit(maxit), _verbose(verbose)
     {
       static_assert(static_cast<int>(L::category) == static_cast<int>(P::category),
                     "L and P must have the same category!");
@@ -132,6 +331,7 @@ namespace Dune {
     {
       // clear solver statistics
       res.clear();
+      this->startObservation();
 
       // start a timer
       Timer watch;
@@ -172,11 +372,14 @@ namespace Dune {
           this->printOutput(std::cout,real_type(i),defnew,def);
         //std::cout << i << " " << defnew << " " << defnew/def << std::endl;
         def = defnew;               // update norm
+        bool proceed = this->observeIteration(i,def,def0);
         if (def<def0*_reduction || def<1E-30)    // convergence check
         {
           res.converged  = true;
           break;
         }
+        if (!proceed)               // stopped by the observer
+          break;
       }
 
       //correct i which is wrong if convergence was not achieved.
@@ -216,9 +419,9 @@ namespace Dune {
 
   private:
     SeqScalarProduct<X> ssp;
-    LinearOperator<X,X>& _op;
-    Preconditioner<X,X>& _prec;
-    ScalarProduct<X>& _sp;
+    TimedLinearOperator<X,X> _op;
+    TimedPreconditioner<X,X> _prec;
+    TimedScalarProduct<X> _sp;
     real_type _reduction;
     int _maxit;
     int _verbose;
@@ -248,7 +451,7 @@ namespace Dune {
     template<class L, class P>
     GradientSolver (L& op, P& prec,
                     real_type reduction, int maxit, int verbose) :
-      ssp(), _op(op), _prec(prec), _sp(ssp), _reduction(reduction), _maxit(maxit), _verbose(verbose)
+      ssp(), _op(op,this->_phaseTimes), _prec(prec,this->_phaseTimes), _sp(ssp,this->_phaseTimes), _reduction(reduction), _maxit(maxit), _verbose(verbose)
     {
       static_assert(static_cast<int>(L::category) == static_cast<int>(P::category),
                     "L and P have to have the same category!");
@@ -263,7 +466,7 @@ namespace Dune {
     template<class L, class S, class P>
     GradientSolver (L& op, S& sp, P& prec,
                     real_type reduction, int maxit, int verbose) :
-      _op(op), _prec(prec), _sp(sp), _reduction(reduction), _maxit(maxit), _verbose(verbose)
+      _op(op,this->_phaseTimes), _prec(prec,this->_phaseTimes), _sp(sp,this->_phaseTimes), _reduction(reduction), _maxit(maxit), _verbose(verbose)
     {
       static_assert(static_cast<int>(L::category) == static_cast<int>(P::category),
                     "L and P have to have the same category!");
@@ -279,6 +482,7 @@ namespace Dune {
     virtual void apply (X& x, X& b, InverseOperatorResult& res)
     {
       res.clear();                  // clear solver statistics
+      this->startObservation();
       Timer watch;                // start a timer
       _prec.pre(x,b);             // prepare preconditioner
       _op.applyscaleadd(-1,x,b);  // overwrite b with defect
@@ -314,11 +518,14 @@ namespace Dune {
           this->printOutput(std::cout,real_type(i),defnew,def);
 
         def = defnew;               // update norm
+        bool proceed = this->observeIteration(i,def,def0);
         if (def<def0*_reduction || def<1E-30)    // convergence check
         {
           res.converged  = true;
           break;
         }
+        if (!proceed)               // stopped by the observer
+          break;
       }
 
       //correct i which is wrong if convergence was not achieved.
@@ -354,9 +561,9 @@ namespace Dune {
 
   private:
     SeqScalarProduct<X> ssp;
-    LinearOperator<X,X>& _op;
-    Preconditioner<X,X>& _prec;
-    ScalarProduct<X>& _sp;
+    TimedLinearOperator<X,X> _op;
+    TimedPreconditioner<X,X> _prec;
+    TimedScalarProduct<X> _sp;
     real_type _reduction;
     int _maxit;
     int _verbose;
@@ -384,7 +591,7 @@ namespace Dune {
      */
     template<class L, class P>
     CGSolver (L& op, P& prec, real_type reduction, int maxit, int verbose) :
-      ssp(), _op(op), _prec(prec), _sp(ssp), _reduction(reduction), _maxit(maxit), _verbose(verbose)
+      ssp(), _op(op,this->_phaseTimes), _prec(prec,this->_phaseTimes), _sp(ssp,this->_phaseTimes), _reduction(reduction), _maxit(maxit), _verbose(verbose)
     {
       static_assert(static_cast<int>(L::category) == static_cast<int>(P::category),
                     "L and P must have the same category!");
@@ -398,7 +605,7 @@ namespace Dune {
      */
     template<class L, class S, class P>
     CGSolver (L& op, S& sp, P& prec, real_type reduction, int maxit, int verbose) :
-      _op(op), _prec(prec), _sp(sp), _reduction(reduction), _maxit(maxit), _verbose(verbose)
+      _op(op,this->_phaseTimes), _prec(prec,this->_phaseTimes), _sp(sp,this->_phaseTimes), _reduction(reduction), _maxit(maxit), _verbose(verbose)
     {
       static_assert(static_cast<int>(L::category) == static_cast<int>(P::category),
                     "L and P must have the same category!");
@@ -414,6 +621,7 @@ namespace Dune {
     virtual void apply (X& x, X& b, InverseOperatorResult& res)
     {
       res.clear();                  // clear solver statistics
+      this->startObservation();
       Timer watch;                // start a timer
       _prec.pre(x,b);             // prepare preconditioner
       _op.applyscaleadd(-1,x,b);  // overwrite b with defect
@@ -448,6 +656,8 @@ namespace Dune {
       // some local variables
       real_type def=def0;   // loop variables
       field_type rho,rholast,lambda,alpha,beta;
+      std::vector<field_type> one(1,field_type(1));
+      std::vector<const X*> correction(1,&q);
 
       // determine initial search direction
       p = 0;                          // clear correction
@@ -463,28 +673,29 @@ namespace Dune {
         alpha = _sp.dot(p,q);       // scalar product
         lambda = rholast/alpha;     // minimization
         x.axpy(lambda,p);           // update solution
-        b.axpy(-lambda,q);          // update defect
 
-        // convergence test
-        real_type defnew=_sp.norm(b); // comp defect norm
+        // update defect and compute its norm in one sweep
+        real_type defnew=_sp.axpyNorm(b,-lambda,q);
 
         if (_verbose>1)             // print
           this->printOutput(std::cout,real_type(i),defnew,def);
 
         def = defnew;               // update norm
+        bool proceed = this->observeIteration(i,def,def0);
         if (def<def0*_reduction || def<1E-30)    // convergence check
         {
           res.converged  = true;
           break;
         }
+        if (!proceed)               // stopped by the observer
+          break;
 
         // determine new search direction
         q = 0;                      // clear correction
         _prec.apply(q,b);           // apply preconditioner
         rho = _sp.dot(q,b);         // orthogonalization
         beta = rho/rholast;         // scaling factor
-        p *= beta;                  // scale old search direction
-        p += q;                     // orthogonalization with correction
+        fusedAxpby(p,beta,one,correction); // p = beta p + q
         rholast = rho;              // remember rho for recurrence
       }
 
@@ -525,53 +736,62 @@ namespace Dune {
 
   private:
     SeqScalarProduct<X> ssp;
-    LinearOperator<X,X>& _op;
-    Preconditioner<X,X>& _prec;
-    ScalarProduct<X>& _sp;
+    TimedLinearOperator<X,X> _op;
+    TimedPreconditioner<X,X> _prec;
+    TimedScalarProduct<X> _sp;
     real_type _reduction;
     int _maxit;
     int _verbose;
   };
 
 
-  // Ronald Kriemanns BiCG-STAB implementation from Sumo
-  //! \brief Bi-conjugate Gradient Stabilized (BiCG-STAB)
+  /*!
+     \brief Pipelined preconditioned conjugate gradient method.
+
+     Mathematically equivalent to CGSolver, but the recurrences are
+     rearranged (P. Ghysels, W. Vanroose, Hiding global synchronization
+     latency in the preconditioned Conjugate Gradient algorithm, 2014)
+     such that all scalar products of one iteration are computed by a
+     single global reduction. This reduction is started with
+     ScalarProduct::idots() and overlapped with the application of the
+     preconditioner and the operator. In parallel runs with many
+     processes this hides the latency of the reduction, at the price of
+     additional vector updates and a slightly worse numerical stability.
+   */
   template<class X>
-  class BiCGSTABSolver : public InverseOperator<X,X> {
+  class PipelinedCGSolver : public InverseOperator<X,X> {
   public:
     //! \brief The domain type of the operator to be inverted.
     typedef X domain_type;
     //! \brief The range type of the operator to be inverted.
     typedef X range_type;
-    //! \brief The field type of the operator to be inverted
+    //! \brief The field type of the operator to be inverted.
     typedef typename X::field_type field_type;
     //! \brief The real type of the field type (is the same if using real numbers, but differs for std::complex)
     typedef typename FieldTraits<field_type>::real_type real_type;
 
     /*!
-       \brief Set up solver.
+       \brief Set up pipelined conjugate gradient solver.
 
        \copydoc LoopSolver::LoopSolver(L&,P&,double,int,int)
      */
     template<class L, class P>
-    BiCGSTABSolver (L& op, P& prec,
-                    real_type reduction, int maxit, int verbose) :
-      ssp(), _op(op), _prec(prec), _sp(ssp), _reduction(reduction), _maxit(maxit), _verbose(verbose)
+    PipelinedCGSolver (L& op, P& prec, real_type reduction, int maxit, int verbose) :
+      ssp(), _op(op,this->_phaseTimes), _prec(prec,this->_phaseTimes), _sp(ssp,this->_phaseTimes), _reduction(reduction), _maxit(maxit), _verbose(verbose)
     {
       static_assert(static_cast<int>(L::category) == static_cast<int>(P::category),
-                    "L and P must be of the same category!");
+                    "L and P must have the same category!");
       static_assert(static_cast<int>(L::category) == static_cast<int>(SolverCategory::sequential),
                     "L must be sequential!");
     }
     /*!
-       \brief Set up solver.
+       \brief Set up pipelined conjugate gradient solver.
 
        \copydoc LoopSolver::LoopSolver(L&,S&,P&,double,int,int)
      */
     template<class L, class S, class P>
-    BiCGSTABSolver (L& op, S& sp, P& prec,
-                    real_type reduction, int maxit, int verbose) :
-      _op(op), _prec(prec), _sp(sp), _reduction(reduction), _maxit(maxit), _verbose(verbose)
+    PipelinedCGSolver (L& op, S& sp, P& prec, real_type reduction, int maxit, int verbose) :
+      _op(op,this->_phaseTimes), _prec(prec,this->_phaseTimes), _sp(sp,this->_phaseTimes), _reduction(reduction), _maxit(maxit), _verbose(verbose)
     {
       static_assert(static_cast<int>(L::category) == static_cast<int>(P::category),
                     "L and P must have the same category!");
@@ -586,196 +806,603 @@ namespace Dune {
      */
     virtual void apply (X& x, X& b, InverseOperatorResult& res)
     {
-      const real_type EPSILON=1e-80;
-      double it;
-      field_type rho, rho_new, alpha, beta, h, omega;
-      real_type norm, norm_old, norm_0;
-
-      //
-      // get vectors and matrix
-      //
-      X& r=b;
-      X p(x);
-      X v(x);
-      X t(x);
-      X y(x);
-      X rt(x);
-
-      //
-      // begin iteration
-      //
-
-      // r = r - Ax; rt = r
-      res.clear();                // clear solver statistics
+      res.clear();                  // clear solver statistics
+      this->startObservation();
       Timer watch;                // start a timer
-      _prec.pre(x,r);             // prepare preconditioner
-      _op.applyscaleadd(-1,x,r);  // overwrite b with defect
-
-      rt=r;
-
-      norm = norm_old = norm_0 = _sp.norm(r);
-
-      p=0;
-      v=0;
+      _prec.pre(x,b);             // prepare preconditioner
+      _op.applyscaleadd(-1,x,b);  // overwrite b with defect
 
-      rho   = 1;
-      alpha = 1;
-      omega = 1;
+      real_type def0 = _sp.norm(b); // compute norm
+      if (def0<1E-30)    // convergence check
+      {
+        res.converged  = true;
+        res.iterations = 0;               // fill statistics
+        res.reduction = 0;
+        res.conv_rate  = 0;
+        res.elapsed=0;
+        if (_verbose>0)                 // final print
+          std::cout << "=== rate=" << res.conv_rate
+                    << ", T=" << res.elapsed << ", TIT=" << res.elapsed
+                    << ", IT=0" << std::endl;
+        return;
+      }
 
       if (_verbose>0)             // printing
       {
-        std::cout << "=== BiCGSTABSolver" << std::endl;
-        if (_verbose>1)
-        {
+        std::cout << "=== PipelinedCGSolver" << std::endl;
+        if (_verbose>1) {
           this->printHeader(std::cout);
-          this->printOutput(std::cout,real_type(0),norm_0);
-          //std::cout << " Iter       Defect         Rate" << std::endl;
-          //std::cout << "    0" << std::setw(14) << norm_0 << std::endl;
+          this->printOutput(std::cout,real_type(0),def0);
         }
       }
 
-      if ( norm < (_reduction * norm_0)  || norm<1E-30)
-      {
-        res.converged = 1;
-        _prec.post(x);                  // postprocess preconditioner
-        res.iterations = 0;             // fill statistics
-        res.reduction = 0;
-        res.conv_rate  = 0;
-        res.elapsed = watch.elapsed();
-        return;
-      }
+      X u(x);              // preconditioned defect
+      X w(x);              // operator applied to u
+      X m(x);              // preconditioner applied to w
+      X n(x);              // operator applied to m
+      X p(x), s(x), q(x), z(x); // search direction and its images
 
-      //
-      // iteration
-      //
+      // the scalar products (b,u), (w,u) and (b,b) of one iteration
+      std::vector<const X*> left(3), right(3);
+      left[0] = &b; right[0] = &u;
+      left[1] = &w; right[1] = &u;
+      left[2] = &b; right[2] = &b;
+      std::vector<field_type> dots(3);
 
-      for (it = 0.5; it < _maxit; it+=.5)
-      {
-        //
-        // preprocess, set vecsizes etc.
-        //
+      // some local variables
+      real_type def=def0;   // loop variables
+      field_type gamma,gammalast=0,delta,alpha=0,beta;
 
-        // rho_new = < rt , r >
-        rho_new = _sp.dot(rt,r);
+      u = 0;                          // clear correction
+      _prec.apply(u,b);               // apply preconditioner
+      _op.apply(u,w);                 // w=Au
 
-        // look if breakdown occured
-        if (std::abs(rho) <= EPSILON)
-          DUNE_THROW(ISTLError,"breakdown in BiCGSTAB - rho "
-                     << rho << " <= EPSILON " << EPSILON
-                     << " after " << it << " iterations");
-        if (std::abs(omega) <= EPSILON)
-          DUNE_THROW(ISTLError,"breakdown in BiCGSTAB - omega "
-                     << omega << " <= EPSILON " << EPSILON
-                     << " after " << it << " iterations");
+      // the loop
+      int i=0;
+      for (;;)
+      {
+        // start the reduction and overlap it with m=Bw, n=Am
+        _sp.idots(left,right,dots);
+        m = 0;
+        _prec.apply(m,w);
+        _op.apply(m,n);
+        _sp.wait();
+
+        // convergence test for the defect of the last iteration
+        if (i>0)
+        {
+          real_type defnew=std::sqrt(std::abs(dots[2]));
 
+          if (_verbose>1)             // print
+            this->printOutput(std::cout,real_type(i),defnew,def);
 
-        if (it<1)
-          p = r;
+          def = defnew;               // update norm
+          bool proceed = this->observeIteration(i,def,def0);
+          if (def<def0*_reduction || def<1E-30)    // convergence check
+          {
+            res.converged  = true;
+            break;
+          }
+          if (!proceed)               // stopped by the observer
+            break;
+        }
+        if (i==_maxit)
+          break;
+        ++i;
+
+        // determine new search direction
+        gamma = dots[0];
+        delta = dots[1];
+        if (i==1)
+        {
+          beta = 0;
+          alpha = gamma/delta;
+        }
         else
         {
-          beta = ( rho_new / rho ) * ( alpha / omega );
-          p.axpy(-omega,v); // p = r + beta (p - omega*v)
-          p *= beta;
-          p += r;
+          beta = gamma/gammalast;
+          alpha = gamma/(delta-beta*gamma/alpha);
         }
+        gammalast = gamma;
+        z *= beta; z += n;
+        q *= beta; q += m;
+        s *= beta; s += w;
+        p *= beta; p += u;
+
+        x.axpy(alpha,p);            // update solution
+        b.axpy(-alpha,s);           // update defect
+        u.axpy(-alpha,q);           // update preconditioned defect
+        w.axpy(-alpha,z);
+      }
 
-        // y = W^-1 * p
-        y = 0;
-        _prec.apply(y,p);           // apply preconditioner
+      if (_verbose==1)                // printing for non verbose
+        this->printOutput(std::cout,real_type(i),def);
 
-        // v = A * y
-        _op.apply(y,v);
+      _prec.post(x);                  // postprocess preconditioner
+      res.iterations = i;               // fill statistics
+      res.reduction = static_cast<double>(def/def0);
+      res.conv_rate  = static_cast<double>(pow(res.reduction,1.0/i));
+      res.elapsed = watch.elapsed();
 
-        // alpha = rho_new / < rt, v >
-        h = _sp.dot(rt,v);
+      if (_verbose>0)                 // final print
+      {
+        std::cout << "=== rate=" << res.conv_rate
+                  << ", T=" << res.elapsed
+                  << ", TIT=" << res.elapsed/i
+                  << ", IT=" << i << std::endl;
+      }
+    }
 
-        if ( std::abs(h) < EPSILON )
-          DUNE_THROW(ISTLError,"h=0 in BiCGSTAB");
+    /*!
+       \brief Apply inverse operator with given reduction factor.
 
-        alpha = rho_new / h;
+       \copydoc InverseOperator::apply(X&,Y&,double,InverseOperatorResult&)
+     */
+    virtual void apply (X& x, X& b, double reduction,
+                        InverseOperatorResult& res)
+    {
+      real_type saved_reduction = _reduction;
+      _reduction = reduction;
+      (*this).apply(x,b,res);
+      _reduction = saved_reduction;
+    }
 
-        // apply first correction to x
-        // x <- x + alpha y
-        x.axpy(alpha,y);
+  private:
+    SeqScalarProduct<X> ssp;
+    TimedLinearOperator<X,X> _op;
+    TimedPreconditioner<X,X> _prec;
+    TimedScalarProduct<X> _sp;
+    real_type _reduction;
+    int _maxit;
+    int _verbose;
+  };
 
-        // r = r - alpha*v
-        r.axpy(-alpha,v);
 
-        //
-        // test stop criteria
-        //
+  /**
+     \brief The Krylov basis used by the s-step solvers.
+   */
+  struct SStepBasis
+  {
+    enum Type {
+      //! \brief monomial basis \f$ v, Bv, \dots, B^{s-1}v \f$
+      monomial,
+      //! \brief Newton basis \f$ v, (B-\theta_0)v, \dots \f$ with Leja ordered shifts
+      newton
+    };
+  };
 
-        norm = _sp.norm(r);
+  /**
+     \brief Solve the symmetric generalized eigenvalue problem
+     \f$ A c = \lambda M c \f$ for a small dense pencil.
 
-        if (_verbose>1) // print
+     The problem is reduced to the standard one for \f$ L^{-1} A L^{-T} \f$,
+     where \f$ M=LL^T \f$, whose symmetric part is diagonalized with
+     cyclic Jacobi rotations. The eigenvalues are sorted in ascending
+     order, the corresponding eigenvectors are the columns of vectors
+     and satisfy \f$ C^T M C = I \f$.
+
+     \return false if M is not positive definite. The output is not changed in this case.
+   */
+  template<class T>
+  bool symmetricEigenpairs (const DynamicMatrix<T>& A, const DynamicMatrix<T>& M,
+                            std::vector<T>& values, DynamicMatrix<T>& vectors)
+  {
+    const int m = A.N();
+
+    // Cholesky decomposition M = L L^T
+    DynamicMatrix<T> L(m,m,T(0));
+    for (int i=0; i<m; ++i)
+      for (int j=0; j<=i; ++j)
+      {
+        T sum = M[i][j];
+        for (int k=0; k<j; ++k)
+          sum -= L[i][k]*L[j][k];
+        if (i==j)
         {
-          this->printOutput(std::cout,real_type(it),norm,norm_old);
+          if (!(sum>0))
+            return false;
+          L[i][i] = std::sqrt(sum);
         }
+        else
+          L[i][j] = sum/L[j][j];
+      }
 
-        if ( norm < (_reduction * norm_0) )
+    // C = L^-1 A L^-T
+    DynamicMatrix<T> C(A);
+    for (int j=0; j<m; ++j)
+      for (int i=0; i<m; ++i)
+      {
+        for (int k=0; k<i; ++k)
+          C[i][j] -= L[i][k]*C[k][j];
+        C[i][j] /= L[i][i];
+      }
+    for (int i=0; i<m; ++i)
+      for (int j=0; j<m; ++j)
+      {
+        for (int k=0; k<j; ++k)
+          C[i][j] -= L[j][k]*C[i][k];
+        C[i][j] /= L[j][j];
+      }
+    for (int i=0; i<m; ++i)
+      for (int j=0; j<i; ++j)
+        C[i][j] = C[j][i] = 0.5*(C[i][j]+C[j][i]);
+
+    // eigenpairs by cyclic Jacobi rotations, V accumulates the rotations
+    DynamicMatrix<T> V(m,m,T(0));
+    for (int i=0; i<m; ++i)
+      V[i][i] = 1;
+    for (int sweep=0; sweep<50; ++sweep)
+    {
+      T off = 0, diag = 0;
+      for (int i=0; i<m; ++i)
+        for (int j=0; j<m; ++j)
+          (i==j ? diag : off) += C[i][j]*C[i][j];
+      if (off<=1e-24*diag)
+        break;
+      for (int p=0; p<m; ++p)
+        for (int q=p+1; q<m; ++q)
         {
-          res.converged = 1;
-          break;
+          if (C[p][q]==T(0))
+            continue;
+          T theta = (C[q][q]-C[p][p])/(2*C[p][q]);
+          T t = 1/(std::abs(theta)+std::sqrt(theta*theta+1));
+          if (theta<0)
+            t = -t;
+          T c = 1/std::sqrt(t*t+1);
+          T s = t*c;
+          for (int k=0; k<m; ++k)
+          {
+            T ckp = C[k][p], ckq = C[k][q];
+            C[k][p] = c*ckp-s*ckq;
+            C[k][q] = s*ckp+c*ckq;
+            T vkp = V[k][p], vkq = V[k][q];
+            V[k][p] = c*vkp-s*vkq;
+            V[k][q] = s*vkp+c*vkq;
+          }
+          for (int k=0; k<m; ++k)
+          {
+            T cpk = C[p][k], cqk = C[q][k];
+            C[p][k] = c*cpk-s*cqk;
+            C[q][k] = s*cpk+c*cqk;
+          }
         }
-        it+=.5;
+    }
 
-        norm_old = norm;
+    // sort ascending and transform the eigenvectors back, c = L^-T v
+    std::vector<std::pair<T,int> > order(m);
+    for (int i=0; i<m; ++i)
+      order[i] = std::make_pair(C[i][i],i);
+    std::sort(order.begin(),order.end());
+    values.resize(m);
+    vectors.resize(m,m);
+    for (int j=0; j<m; ++j)
+    {
+      values[j] = order[j].first;
+      for (int i=m-1; i>=0; --i)
+      {
+        T sum = V[i][order[j].second];
+        for (int k=i+1; k<m; ++k)
+          sum -= L[k][i]*vectors[k][j];
+        vectors[i][j] = sum/L[i][i];
+      }
+    }
+    return true;
+  }
 
-        // y = W^-1 * r
-        y = 0;
-        _prec.apply(y,r);
+  /**
+     \brief Compute the shifts of the Newton basis for the s-step solvers.
 
-        // t = A * y
-        _op.apply(y,t);
+     The spectral interval is estimated by the eigenvalues of the
+     symmetric part of \f$ L^{-1} A L^{-T} \f$, where \f$ M=LL^T \f$,
+     i.e. by the Ritz values of the pencil (A,M), see symmetricEigenpairs().
+     The shifts are the n Chebyshev points of this interval in Leja ordering.
 
-        // omega = < t, r > / < t, t >
-        omega = _sp.dot(t,r)/_sp.dot(t,t);
+     \return false if M is not positive definite. The shifts are not changed in this case.
+   */
+  template<class T>
+  bool sstepNewtonShifts (const DynamicMatrix<T>& A, const DynamicMatrix<T>& M,
+                          int n, std::vector<T>& shifts)
+  {
+    std::vector<T> values;
+    DynamicMatrix<T> vectors;
+    if (!symmetricEigenpairs(A,M,values,vectors))
+      return false;
+    const T lmin = values.front(), lmax = values.back();
+
+    // Chebyshev points of [lmin,lmax]
+    const T pi = std::acos(T(-1));
+    std::vector<T> points(n);
+    for (int k=0; k<n; ++k)
+      points[k] = 0.5*(lmax+lmin) + 0.5*(lmax-lmin)*std::cos(pi*(2*k+1)/(2*n));
+
+    // Leja ordering: start with the point of largest modulus, then take the
+    // point maximizing the product of the distances to the points already chosen
+    shifts.resize(n);
+    for (int k=0; k<n; ++k)
+    {
+      int best = k;
+      T bestValue = -1;
+      for (int l=k; l<n; ++l)
+      {
+        T value = (k==0) ? std::abs(points[l]) : T(1);
+        for (int j=0; j<k; ++j)
+          value *= std::abs(points[l]-shifts[j]);
+        if (value>bestValue)
+        {
+          best = l;
+          bestValue = value;
+        }
+      }
+      shifts[k] = points[best];
+      std::swap(points[k],points[best]);
+    }
+    return true;
+  }
 
-        // apply second correction to x
-        // x <- x + omega y
-        x.axpy(omega,y);
+  /*!
+     \brief s-step (communication avoiding) conjugate gradient method.
+
+     Mathematically equivalent to CGSolver, but each outer step builds
+     s Krylov vectors \f$ R=[z, (BA)z, \dots] \f$, \f$ z=Br \f$, of the
+     preconditioned operator at once and makes them A-conjugate to the
+     previous block. All scalar products of an outer step (the Gram
+     matrices and the defect norm) are computed in one block reduction
+     started with ScalarProduct::idots(). This reduces the number of
+     global synchronizations by a factor of s.
+
+     The monomial basis gets ill conditioned quickly, s should not exceed
+     about 4 with it. The Newton basis uses shifts estimated from the
+     Ritz values of the first block and works well up to about s=7.
+
+     The defect norm is checked once per outer step, so the iteration
+     count is a multiple of s.
+   */
+  template<class X>
+  class SStepCGSolver : public InverseOperator<X,X> {
+  public:
+    //! \brief The domain type of the operator to be inverted.
+    typedef X domain_type;
+    //! \brief The range type of the operator to be inverted.
+    typedef X range_type;
+    //! \brief The field type of the operator to be inverted.
+    typedef typename X::field_type field_type;
+    //! \brief The real type of the field type (is the same if using real numbers, but differs for std::complex)
+    typedef typename FieldTraits<field_type>::real_type real_type;
 
-        // r = s - omega*t (remember : r = s)
-        r.axpy(-omega,t);
+    /*!
+       \brief Set up s-step conjugate gradient solver.
 
-        rho = rho_new;
+       \copydoc LoopSolver::LoopSolver(L&,P&,double,int,int)
+       \param s The number of Krylov vectors computed per outer step.
+       \param basis The type of the Krylov basis.
+     */
+    template<class L, class P>
+    SStepCGSolver (L& op, P& prec, real_type reduction, int maxit, int verbose,
+                   int s=4, SStepBasis::Type basis=SStepBasis::newton) :
+      ssp(), _op(op,this->_phaseTimes), _prec(prec,this->_phaseTimes), _sp(ssp,this->_phaseTimes), _reduction(reduction), _maxit(maxit), _verbose(verbose),
+      _s(s), _basis(basis)
+    {
+      static_assert(static_cast<int>(L::category) == static_cast<int>(P::category),
+                    "L and P must have the same category!");
+      static_assert(static_cast<int>(L::category) == static_cast<int>(SolverCategory::sequential),
+                    "L must be sequential!");
+    }
+    /*!
+       \brief Set up s-step conjugate gradient solver.
 
-        //
-        // test stop criteria
-        //
+       \copydoc LoopSolver::LoopSolver(L&,S&,P&,double,int,int)
+       \param s The number of Krylov vectors computed per outer step.
+       \param basis The type of the Krylov basis.
+     */
+    template<class L, class S, class P>
+    SStepCGSolver (L& op, S& sp, P& prec, real_type reduction, int maxit, int verbose,
+                   int s=4, SStepBasis::Type basis=SStepBasis::newton) :
+      _op(op,this->_phaseTimes), _prec(prec,this->_phaseTimes), _sp(sp,this->_phaseTimes), _reduction(reduction), _maxit(maxit), _verbose(verbose),
+      _s(s), _basis(basis)
+    {
+      static_assert(static_cast<int>(L::category) == static_cast<int>(P::category),
+                    "L and P must have the same category!");
+      static_assert(static_cast<int>(L::category) == static_cast<int>(S::category),
+                    "L and S must have the same category!");
+    }
 
-        norm = _sp.norm(r);
+    /*!
+       \brief Apply inverse operator.
 
-        if (_verbose > 1)             // print
+       \copydoc InverseOperator::apply(X&,Y&,InverseOperatorResult&)
+     */
+    virtual void apply (X& x, X& b, InverseOperatorResult& res)
+    {
+      res.clear();                  // clear solver statistics
+      this->startObservation();
+      Timer watch;                // start a timer
+      _prec.pre(x,b);             // prepare preconditioner
+      _op.applyscaleadd(-1,x,b);  // overwrite b with defect
+
+      real_type def0 = _sp.norm(b); // compute norm
+      if (def0<1E-30)    // convergence check
+      {
+        res.converged  = true;
+        res.iterations = 0;               // fill statistics
+        res.reduction = 0;
+        res.conv_rate  = 0;
+        res.elapsed=0;
+        if (_verbose>0)                 // final print
+          std::cout << "=== rate=" << res.conv_rate
+                    << ", T=" << res.elapsed << ", TIT=" << res.elapsed
+                    << ", IT=0" << std::endl;
+        return;
+      }
+
+      if (_verbose>0)             // printing
+      {
+        std::cout << "=== SStepCGSolver" << std::endl;
+        if (_verbose>1) {
+          this->printHeader(std::cout);
+          this->printOutput(std::cout,real_type(0),def0);
+        }
+      }
+
+      const int s = _s;
+      std::vector<X> R(s,x), AR(s,x); // Krylov basis of the block and its image
+      std::vector<X> P(s,x), AP(s,x); // A-conjugate search directions and their image
+      DynamicMatrix<field_type> G1(s,s), G2(s,s), W(s,s), B(s,s);
+      DynamicVector<field_type> g(s), alpha(s);
+
+      // shifts of the Newton basis, the first block always uses the monomial basis
+      std::vector<real_type> shifts(s,0.0);
+      bool estimateShifts = (_basis==SStepBasis::newton);
+
+      std::vector<const X*> left, right;
+      std::vector<field_type> dots;
+
+      // some local variables
+      real_type def=def0;   // loop variables
+
+      // the loop
+      int i=0;
+      for (int k=0; ; ++k)
+      {
+        // build the Krylov basis of the block
+        R[0] = 0;
+        _prec.apply(R[0],b);
+        for (int j=0; j<s; ++j)
         {
-          this->printOutput(std::cout,real_type(it),norm,norm_old);
+          _op.apply(R[j],AR[j]);
+          if (j+1<s)
+          {
+            R[j+1] = 0;
+            _prec.apply(R[j+1],AR[j]);
+            R[j+1].axpy(-shifts[j],R[j]);
+          }
         }
 
-        if ( norm < (_reduction * norm_0)  || norm<1E-30)
+        // all scalar products of the block with one reduction
+        left.clear(); right.clear();
+        for (int m=0; m<s; ++m)
+          for (int j=0; j<s; ++j)
+          {
+            if (k>0) {
+              left.push_back(&AP[m]); right.push_back(&R[j]);
+            }
+            left.push_back(&R[m]); right.push_back(&AR[j]);
+          }
+        for (int m=0; m<s; ++m) {
+          left.push_back(&R[m]); right.push_back(&b);
+        }
+        left.push_back(&b); right.push_back(&b);
+        _sp.idots(left,right,dots);
+        _sp.wait();
+
+        // convergence test for the defect of the last block
+        if (k>0)
         {
-          res.converged = 1;
+          real_type defnew=std::sqrt(std::abs(dots.back()));
+
+          if (_verbose>1)             // print
+            this->printOutput(std::cout,real_type(i),defnew,def);
+
+          def = defnew;               // update norm
+          bool proceed = this->observeIteration(i,def,def0);
+          if (def<def0*_reduction || def<1E-30)    // convergence check
+          {
+            res.converged  = true;
+            break;
+          }
+          if (!proceed)               // stopped by the observer
+            break;
+        }
+        if (i>=_maxit)
           break;
+
+        int c=0;
+        for (int m=0; m<s; ++m)
+          for (int j=0; j<s; ++j)
+          {
+            if (k>0)
+              G1[m][j] = dots[c++];
+            G2[m][j] = dots[c++];
+          }
+        for (int m=0; m<s; ++m)
+          g[m] = dots[c++];
+
+        if (estimateShifts)
+        {
+          // Ritz values of the monomial basis, for which
+          // R^H B^-1 R = [R^H r, R^H A R_0, ..., R^H A R_{s-2}]
+          DynamicMatrix<real_type> H(s,s), M(s,s);
+          for (int m=0; m<s; ++m)
+          {
+            M[m][0] = std::real(g[m]);
+            for (int j=0; j<s; ++j)
+            {
+              H[m][j] = std::real(G2[m][j]);
+              if (j+1<s)
+                M[m][j+1] = std::real(G2[m][j]);
+            }
+          }
+          sstepNewtonShifts(H,M,s-1,shifts);
+          estimateShifts = false;
         }
 
-        norm_old = norm;
-      } // end for
+        if (k>0)
+        {
+          // B = (P^H A P)^-1 (AP)^H R, the inverse is still stored in W
+          B = 0;
+          for (int m=0; m<s; ++m)
+            for (int j=0; j<s; ++j)
+              for (int l=0; l<s; ++l)
+                B[m][j] += W[m][l]*G1[l][j];
+
+          // make the block A-conjugate to the previous one
+          for (int j=0; j<s; ++j)
+            for (int m=0; m<s; ++m)
+            {
+              R[j].axpy(-B[m][j],P[m]);
+              AR[j].axpy(-B[m][j],AP[m]);
+            }
+          for (int m=0; m<s; ++m)
+            for (int j=0; j<s; ++j)
+              for (int l=0; l<s; ++l)
+                G2[m][j] -= conjugate(G1[l][m])*B[l][j];
+        }
+        P.swap(R);
+        AP.swap(AR);
 
-      //correct i which is wrong if convergence was not achieved.
-      it=std::min(static_cast<double>(_maxit),it);
+        // minimize in the space of the block, P^H r = R^H r = g
+        W = G2;
+        try {
+          W.invert();
+        }
+        catch (FMatrixError&) {
+          DUNE_THROW(ISTLError,"breakdown in s-step CG - singular block after "
+                     << i << " iterations");
+        }
+        W.mv(g,alpha);
+        for (int j=0; j<s; ++j)
+        {
+          x.axpy(alpha[j],P[j]);    // update solution
+          b.axpy(-alpha[j],AP[j]);  // update defect
+        }
+        i += s;
+      }
 
       if (_verbose==1)                // printing for non verbose
-        this->printOutput(std::cout,real_type(it),norm);
+        this->printOutput(std::cout,real_type(i),def);
 
       _prec.post(x);                  // postprocess preconditioner
-      res.iterations = static_cast<int>(std::ceil(it));              // fill statistics
-      res.reduction = static_cast<double>(norm/norm_0);
-      res.conv_rate  = static_cast<double>(pow(res.reduction,1.0/it));
+      res.iterations = i;               // fill statistics
+      res.reduction = static_cast<double>(def/def0);
+      res.conv_rate  = static_cast<double>(pow(res.reduction,1.0/i));
       res.elapsed = watch.elapsed();
+
       if (_verbose>0)                 // final print
+      {
         std::cout << "=== rate=" << res.conv_rate
                   << ", T=" << res.elapsed
-                  << ", TIT=" << res.elapsed/it
-                  << ", IT=" << it << std::endl;
+                  << ", TIT=" << res.elapsed/i
+                  << ", IT=" << i << std::endl;
+      }
     }
 
     /*!
@@ -783,7 +1410,8 @@ namespace Dune {
 
        \copydoc InverseOperator::apply(X&,Y&,double,InverseOperatorResult&)
      */
-    virtual void apply (X& x, X& b, double reduction, InverseOperatorResult& res)
+    virtual void apply (X& x, X& b, double reduction,
+                        InverseOperatorResult& res)
     {
       real_type saved_reduction = _reduction;
       _reduction = reduction;
@@ -792,23 +1420,53 @@ namespace Dune {
     }
 
   private:
+    template<typename T>
+    typename enable_if<is_same<field_type,real_type>::value,T>::type conjugate(const T& t) {
+      return t;
+    }
+
+    template<typename T>
+    typename enable_if<!is_same<field_type,real_type>::value,T>::type conjugate(const T& t) {
+      return conj(t);
+    }
+
     SeqScalarProduct<X> ssp;
-    LinearOperator<X,X>& _op;
-    Preconditioner<X,X>& _prec;
-    ScalarProduct<X>& _sp;
+    TimedLinearOperator<X,X> _op;
+    TimedPreconditioner<X,X> _prec;
+    TimedScalarProduct<X> _sp;
     real_type _reduction;
     int _maxit;
     int _verbose;
+    int _s;
+    SStepBasis::Type _basis;
   };
 
-  /*! \brief Minimal Residual Method (MINRES)
 
-     Symmetrically Preconditioned MINRES as in A. Greenbaum, 'Iterative Methods for Solving Linear Systems', pp. 121
-     Iterative solver for symmetric indefinite operators.
-     Note that in order to ensure the (symmetrically) preconditioned system to remain symmetric, the preconditioner has to be spd.
+  /*!
+     \brief Block conjugate gradient method for several right hand sides.
+
+     Solves \f$ A x_j = b_j \f$ for k right hand sides at once. All
+     systems share one block Krylov space, so the search directions
+     found for one right hand side also reduce the error of the others,
+     which usually needs considerably fewer iterations than k separate
+     CG solves. The operator and the preconditioner are applied to the
+     whole block with LinearOperator::applyMultiple() and
+     Preconditioner::applyMultiple(), so a matrix based operator reads
+     the matrix only once per iteration for all right hand sides, and
+     the scalar products of an iteration are computed with a single
+     reduction each.
+
+     The search directions are orthonormalized in every step and linearly
+     dependent directions are dropped (breakdown free block CG, H. Ji,
+     Y. Li, 2017), hence the block shrinks when right hand sides converge
+     or are linearly dependent.
+
+     The solver is also an InverseOperator for a single right hand side,
+     in which case it is equivalent to CGSolver. The preconditioner is
+     prepared with the first pair of solution and right hand side only.
    */
   template<class X>
-  class MINRESSolver : public InverseOperator<X,X> {
+  class BlockCGSolver : public InverseOperator<X,X> {
   public:
     //! \brief The domain type of the operator to be inverted.
     typedef X domain_type;
@@ -820,13 +1478,13 @@ namespace Dune {
     typedef typename FieldTraits<field_type>::real_type real_type;
 
     /*!
-       \brief Set up MINRES solver.
+       \brief Set up block conjugate gradient solver.
 
        \copydoc LoopSolver::LoopSolver(L&,P&,double,int,int)
      */
     template<class L, class P>
-    MINRESSolver (L& op, P& prec, real_type reduction, int maxit, int verbose) :
-      ssp(), _op(op), _prec(prec), _sp(ssp), _reduction(reduction), _maxit(maxit), _verbose(verbose)
+    BlockCGSolver (L& op, P& prec, real_type reduction, int maxit, int verbose) :
+      ssp(), _op(op,this->_phaseTimes), _prec(prec,this->_phaseTimes), _sp(ssp,this->_phaseTimes), _reduction(reduction), _maxit(maxit), _verbose(verbose)
     {
       static_assert(static_cast<int>(L::category) == static_cast<int>(P::category),
                     "L and P must have the same category!");
@@ -834,13 +1492,13 @@ namespace Dune {
                     "L must be sequential!");
     }
     /*!
-       \brief Set up MINRES solver.
+       \brief Set up block conjugate gradient solver.
 
        \copydoc LoopSolver::LoopSolver(L&,S&,P&,double,int,int)
      */
     template<class L, class S, class P>
-    MINRESSolver (L& op, S& sp, P& prec, real_type reduction, int maxit, int verbose) :
-      _op(op), _prec(prec), _sp(sp), _reduction(reduction), _maxit(maxit), _verbose(verbose)
+    BlockCGSolver (L& op, S& sp, P& prec, real_type reduction, int maxit, int verbose) :
+      _op(op,this->_phaseTimes), _prec(prec,this->_phaseTimes), _sp(sp,this->_phaseTimes), _reduction(reduction), _maxit(maxit), _verbose(verbose)
     {
       static_assert(static_cast<int>(L::category) == static_cast<int>(P::category),
                     "L and P must have the same category!");
@@ -855,251 +1513,2879 @@ namespace Dune {
      */
     virtual void apply (X& x, X& b, InverseOperatorResult& res)
     {
-      // clear solver statistics
-      res.clear();
-      // start a timer
-      Dune::Timer watch;
-      watch.reset();
-      // prepare preconditioner
-      _prec.pre(x,b);
-      // overwrite rhs with defect
-      _op.applyscaleadd(-1,x,b);
+      std::vector<X> xs(1,x), bs(1,b);
+      apply(xs,bs,res);
+      x = xs[0];
+      b = bs[0];
+    }
 
-      // compute residual norm
-      real_type def0 = _sp.norm(b);
+    /*!
+       \brief Apply inverse operator with given reduction factor.
 
-      // printing
-      if(_verbose > 0) {
-        std::cout << "=== MINRESSolver" << std::endl;
-        if(_verbose > 1) {
-          this->printHeader(std::cout);
-          this->printOutput(std::cout,real_type(0),def0);
-        }
-      }
+       \copydoc InverseOperator::apply(X&,Y&,double,InverseOperatorResult&)
+     */
+    virtual void apply (X& x, X& b, double reduction,
+                        InverseOperatorResult& res)
+    {
+      real_type saved_reduction = _reduction;
+      _reduction = reduction;
+      (*this).apply(x,b,res);
+      _reduction = saved_reduction;
+    }
 
-      // check for convergence
-      if(def0 < 1e-30 ) {
-        res.converged = true;
-        res.iterations = 0;
+    /*!
+       \brief Solve the systems for all right hand sides.
+
+       \param x The initial guesses, overwritten with the solutions.
+       \param b The right hand sides, overwritten with the defects.
+       \param res Statistics, the reduction is the worst one of all systems.
+
+       The defect of every system has to be reduced by the reduction factor.
+     */
+    void apply (std::vector<X>& x, std::vector<X>& b, InverseOperatorResult& res)
+    {
+      typedef typename std::vector<X>::size_type size_type;
+
+      res.clear();                  // clear solver statistics
+      this->startObservation();
+      Timer watch;                // start a timer
+      const size_type k = x.size();
+      if (b.size()!=k)
+        DUNE_THROW(ISTLError,"number of solutions and right hand sides does not match");
+      if (k==0)
+        return;
+
+      _prec.pre(x[0],b[0]);       // prepare preconditioner
+      for (size_type j=0; j<k; ++j)
+        _op.applyscaleadd(-1,x[j],b[j]);  // overwrite b with defect
+
+      std::vector<const X*> left, right;
+      std::vector<field_type> dots;
+
+      // norms of all defects with one reduction
+      std::vector<real_type> def0(k), def(k);
+      for (size_type j=0; j<k; ++j) {
+        left.push_back(&b[j]); right.push_back(&b[j]);
+      }
+      _sp.idots(left,right,dots);
+      _sp.wait();
+      for (size_type j=0; j<k; ++j)
+        def[j] = def0[j] = std::sqrt(std::abs(dots[j]));
+
+      real_type defmax = *std::max_element(def.begin(),def.end());
+      const real_type defmax0 = defmax;
+      if (converged(def,def0))
+      {
+        res.converged  = true;
+        res.iterations = 0;               // fill statistics
         res.reduction = 0;
-        res.conv_rate = 0;
-        res.elapsed = 0.0;
-        // final print
-        if(_verbose > 0)
+        res.conv_rate  = 0;
+        res.elapsed=0;
+        if (_verbose>0)                 // final print
           std::cout << "=== rate=" << res.conv_rate
-                    << ", T=" << res.elapsed
-                    << ", TIT=" << res.elapsed
-                    << ", IT=" << res.iterations
-                    << std::endl;
+                    << ", T=" << res.elapsed << ", TIT=" << res.elapsed
+                    << ", IT=0" << std::endl;
+        _prec.post(x[0]);
         return;
       }
 
-      // the defect norm
-      real_type def = def0;
-      // recurrence coefficients as computed in Lanczos algorithm
-      field_type alpha, beta;
-        // diagonal entries of givens rotation
-      Dune::array<real_type,2> c{{0.0,0.0}};
-        // off-diagonal entries of givens rotation
-      Dune::array<field_type,2> s{{0.0,0.0}};
+      if (_verbose>0)             // printing
+      {
+        std::cout << "=== BlockCGSolver" << std::endl;
+        if (_verbose>1) {
+          this->printHeader(std::cout);
+          this->printOutput(std::cout,real_type(0),defmax);
+        }
+      }
 
-      // recurrence coefficients (column k of tridiag matrix T_k)
-      Dune::array<field_type,3> T{{0.0,0.0,0.0}};
+      std::vector<X> P(k,x[0]), Q(k,x[0]), Z(k,x[0]);
+      std::vector<field_type> coeff;
+      DynamicMatrix<field_type> W, C;
 
-      // the rhs vector of the min problem
-      Dune::array<field_type,2> xi{{1.0,0.0}};
+      // the initial block of search directions
+      for (size_type j=0; j<k; ++j)
+        Z[j] = 0;
+      _prec.applyMultiple(pointers(Z,k),constPointers(b,k));
+      size_type m = orthonormalize(Z,k);
+      P.swap(Z);
 
-      // some temporary vectors
-      X z(b), dummy(b);
+      // the loop
+      int i=1;
+      for ( ; i<=_maxit; i++ )
+      {
+        if (m==0)
+          DUNE_THROW(ISTLError,"breakdown in block CG - no search directions left after "
+                     << i-1 << " iterations");
+
+        // minimize in the space of the search directions
+        _op.applyMultiple(constPointers(P,m),pointers(Q,m));  // Q=AP
+        left.clear(); right.clear();
+        for (size_type a=0; a<m; ++a)
+        {
+          for (size_type c=0; c<m; ++c) {
+            left.push_back(&P[a]); right.push_back(&Q[c]);
+          }
+          for (size_type c=0; c<k; ++c) {
+            left.push_back(&P[a]); right.push_back(&b[c]);
+          }
+        }
+        _sp.idots(left,right,dots);
+        _sp.wait();
+        W.resize(m,m);
+        C.resize(m,k);
+        for (size_type a=0, l=0; a<m; ++a)
+        {
+          for (size_type c=0; c<m; ++c)
+            W[a][c] = dots[l++];
+          for (size_type c=0; c<k; ++c)
+            C[a][c] = dots[l++];
+        }
+        try {
+          W.invert();               // W = (P^H A P)^-1
+        }
+        catch (FMatrixError&) {
+          DUNE_THROW(ISTLError,"breakdown in block CG - singular block after "
+                     << i-1 << " iterations");
+        }
+        coeff.resize(m);
+        for (size_type c=0; c<k; ++c)
+        {
+          for (size_type a=0; a<m; ++a)
+          {
+            coeff[a] = 0;
+            for (size_type l=0; l<m; ++l)
+              coeff[a] += W[a][l]*C[l][c];
+          }
+          fusedAxpy(x[c],coeff,constPointers(P,m));  // update solution
+          for (size_type a=0; a<m; ++a)
+            coeff[a] = -coeff[a];
+          fusedAxpy(b[c],coeff,constPointers(Q,m));  // update defect
+        }
+
+        // convergence test
+        left.clear(); right.clear();
+        for (size_type j=0; j<k; ++j) {
+          left.push_back(&b[j]); right.push_back(&b[j]);
+        }
+        _sp.idots(left,right,dots);
+        _sp.wait();
+        for (size_type j=0; j<k; ++j)
+          def[j] = std::sqrt(std::abs(dots[j]));
+        real_type defnew = *std::max_element(def.begin(),def.end());
+
+        if (_verbose>1)             // print
+          this->printOutput(std::cout,real_type(i),defnew,defmax);
+
+        defmax = defnew;            // update norm
+        bool proceed = this->observeIteration(i,defmax,defmax0);
+        if (converged(def,def0))    // convergence check
+        {
+          res.converged  = true;
+          break;
+        }
+        if (!proceed)               // stopped by the observer
+          break;
+
+        // determine new search directions, A-conjugate to the old ones
+        for (size_type j=0; j<k; ++j)
+          Z[j] = 0;
+        _prec.applyMultiple(pointers(Z,k),constPointers(b,k));
+        left.clear(); right.clear();
+        for (size_type a=0; a<m; ++a)
+          for (size_type c=0; c<k; ++c) {
+            left.push_back(&Q[a]); right.push_back(&Z[c]);
+          }
+        _sp.idots(left,right,dots);
+        _sp.wait();
+        for (size_type a=0, l=0; a<m; ++a)
+          for (size_type c=0; c<k; ++c)
+            C[a][c] = dots[l++];
+        for (size_type c=0; c<k; ++c)
+        {
+          for (size_type a=0; a<m; ++a)
+          {
+            coeff[a] = 0;
+            for (size_type l=0; l<m; ++l)
+              coeff[a] -= W[a][l]*C[l][c];
+          }
+          fusedAxpy(Z[c],coeff,constPointers(P,m));
+        }
+        m = orthonormalize(Z,k);
+        P.swap(Z);
+      }
+
+      //correct i which is wrong if convergence was not achieved.
+      i=std::min(_maxit,i);
+
+      if (_verbose==1)                // printing for non verbose
+        this->printOutput(std::cout,real_type(i),defmax);
+
+      _prec.post(x[0]);               // postprocess preconditioner
+      res.iterations = i;               // fill statistics
+      res.reduction = 0;
+      for (size_type j=0; j<k; ++j)
+        if (def0[j]>0)
+          res.reduction = std::max(res.reduction,static_cast<double>(def[j]/def0[j]));
+      res.conv_rate  = static_cast<double>(pow(res.reduction,1.0/i));
+      res.elapsed = watch.elapsed();
+
+      if (_verbose>0)                 // final print
+      {
+        std::cout << "=== rate=" << res.conv_rate
+                  << ", T=" << res.elapsed
+                  << ", TIT=" << res.elapsed/i
+                  << ", IT=" << i << std::endl;
+      }
+    }
+
+    /*!
+       \brief Solve the systems for all right hand sides with given reduction factor.
+
+       \copydoc apply(std::vector<X>&,std::vector<X>&,InverseOperatorResult&)
+       \param reduction The minimum defect reduction to achieve.
+     */
+    void apply (std::vector<X>& x, std::vector<X>& b, double reduction,
+                InverseOperatorResult& res)
+    {
+      real_type saved_reduction = _reduction;
+      _reduction = reduction;
+      (*this).apply(x,b,res);
+      _reduction = saved_reduction;
+    }
+
+  private:
+    bool converged (const std::vector<real_type>& def, const std::vector<real_type>& def0) const
+    {
+      for (typename std::vector<real_type>::size_type j=0; j<def.size(); ++j)
+        if (!(def[j]<def0[j]*_reduction || def[j]<1E-30))
+          return false;
+      return true;
+    }
+
+    static std::vector<X*> pointers (std::vector<X>& v, typename std::vector<X>::size_type n)
+    {
+      std::vector<X*> p(n);
+      for (typename std::vector<X>::size_type j=0; j<n; ++j)
+        p[j] = &v[j];
+      return p;
+    }
+
+    static std::vector<const X*> constPointers (const std::vector<X>& v, typename std::vector<X>::size_type n)
+    {
+      std::vector<const X*> p(n);
+      for (typename std::vector<X>::size_type j=0; j<n; ++j)
+        p[j] = &v[j];
+      return p;
+    }
+
+    /* Orthonormalize the first n vectors of Z by a Cholesky
+       decomposition of their Gram matrix. Vectors that are (numerically)
+       linearly dependent on the previous ones are dropped, the remaining
+       ones are moved to the front and their number is returned. */
+    typename std::vector<X>::size_type orthonormalize (std::vector<X>& Z, typename std::vector<X>::size_type n)
+    {
+      typedef typename std::vector<X>::size_type size_type;
+
+      std::vector<const X*> left, right;
+      std::vector<field_type> dots;
+      for (size_type a=0; a<n; ++a)
+        for (size_type c=a; c<n; ++c) {
+          left.push_back(&Z[a]); right.push_back(&Z[c]);
+        }
+      _sp.idots(left,right,dots);
+      _sp.wait();
+      DynamicMatrix<field_type> G(n,n), U(n,n,field_type(0));
+      for (size_type a=0, l=0; a<n; ++a)
+        for (size_type c=a; c<n; ++c)
+          G[a][c] = dots[l++];
+
+      // G = U^H U restricted to the kept vectors, Z = P U
+      const real_type tolerance = std::sqrt(std::numeric_limits<real_type>::epsilon());
+      std::vector<size_type> kept;
+      std::vector<field_type> coeff;
+      std::vector<const X*> p;
+      for (size_type c=0; c<n; ++c)
+      {
+        for (size_type a=0; a<kept.size(); ++a)
+        {
+          field_type sum = G[kept[a]][c];
+          for (size_type t=0; t<a; ++t)
+            sum -= conjugate(U[kept[t]][kept[a]])*U[kept[t]][c];
+          U[kept[a]][c] = sum/U[kept[a]][kept[a]];
+        }
+        real_type d = std::real(G[c][c]);
+        for (size_type a=0; a<kept.size(); ++a)
+          d -= std::norm(U[kept[a]][c]);
+        if (d<=tolerance*std::real(G[c][c]) || !(d>0))
+          continue;                 // linearly dependent, drop it
+        U[c][c] = std::sqrt(d);
+
+        // P_c = (Z_c - sum_a P_a U_ac) / U_cc, stored in slot kept.size()
+        coeff.resize(kept.size());
+        p.resize(kept.size());
+        for (size_type a=0; a<kept.size(); ++a)
+        {
+          coeff[a] = -U[kept[a]][c];
+          p[a] = &Z[a];
+        }
+        const size_type slot = kept.size();
+        if (slot!=c)
+          Z[slot] = Z[c];
+        fusedAxpy(Z[slot],coeff,p);
+        Z[slot] *= 1.0/U[c][c];
+        kept.push_back(c);
+      }
+      return kept.size();
+    }
+
+    template<typename T>
+    typename enable_if<is_same<field_type,real_type>::value,T>::type conjugate(const T& t) {
+      return t;
+    }
+
+    template<typename T>
+    typename enable_if<!is_same<field_type,real_type>::value,T>::type conjugate(const T& t) {
+      return conj(t);
+    }
+
+    SeqScalarProduct<X> ssp;
+    TimedLinearOperator<X,X> _op;
+    TimedPreconditioner<X,X> _prec;
+    TimedScalarProduct<X> _sp;
+    real_type _reduction;
+    int _maxit;
+    int _verbose;
+  };
+
+
+  /*!
+     \brief Deflated conjugate gradient method for sequences of systems.
+
+     Preconditioned CG that keeps the search directions A-orthogonal
+     to a deflation space W (Y. Saad, M. Yeung, J. Erhel, F. Guyomarc'h,
+     A deflated version of the conjugate gradient algorithm, 2000). The
+     initial guess is corrected by a Galerkin projection onto W, so the
+     components of the error in W are removed before the iteration
+     starts. If W approximates the eigenvectors of the smallest
+     eigenvalues, CG converges as if these were not present.
+
+     The deflation space is kept by the solver and reused by the next
+     call of apply(). During a solve the search directions are collected
+     and every l iterations the collection is compressed to the k Ritz
+     vectors of the smallest Ritz values of A in its span (a restarted
+     Rayleigh-Ritz procedure similar to eigCG, A. Stathopoulos,
+     K. Orginos, 2010). The final Ritz vectors replace the deflation
+     space. Hence, when a sequence of slowly changing systems is solved
+     with the same solver object, the deflation space is improved from
+     solve to solve. This needs 2(k+l) additional vectors. The product AW
+     is recomputed for every solve, so the operator may change in between.
+
+     The update of the deflation space is only done for real field types,
+     for complex ones a deflation space can be set with setDeflationSpace().
+   */
+  template<class X>
+  class DeflatedCGSolver : public InverseOperator<X,X> {
+  public:
+    //! \brief The domain type of the operator to be inverted.
+    typedef X domain_type;
+    //! \brief The range type of the operator to be inverted.
+    typedef X range_type;
+    //! \brief The field type of the operator to be inverted.
+    typedef typename X::field_type field_type;
+    //! \brief The real type of the field type (is the same if using real numbers, but differs for std::complex)
+    typedef typename FieldTraits<field_type>::real_type real_type;
+
+    /*!
+       \brief Set up deflated conjugate gradient solver.
+
+       \copydoc LoopSolver::LoopSolver(L&,P&,double,int,int)
+       \param k The number of deflation vectors kept between the solves.
+       \param l The number of search directions collected before the Ritz vectors are updated.
+     */
+    template<class L, class P>
+    DeflatedCGSolver (L& op, P& prec, real_type reduction, int maxit, int verbose, int k=8, int l=16) :
+      ssp(), _op(op,this->_phaseTimes), _prec(prec,this->_phaseTimes), _sp(ssp,this->_phaseTimes), _reduction(reduction), _maxit(maxit), _verbose(verbose),
+      _k(k), _l(std::max(l,1))
+    {
+      static_assert(static_cast<int>(L::category) == static_cast<int>(P::category),
+                    "L and P must have the same category!");
+      static_assert(static_cast<int>(L::category) == static_cast<int>(SolverCategory::sequential),
+                    "L must be sequential!");
+    }
+    /*!
+       \brief Set up deflated conjugate gradient solver.
+
+       \copydoc LoopSolver::LoopSolver(L&,S&,P&,double,int,int)
+       \param k The number of deflation vectors kept between the solves.
+       \param l The number of search directions collected before the Ritz vectors are updated.
+     */
+    template<class L, class S, class P>
+    DeflatedCGSolver (L& op, S& sp, P& prec, real_type reduction, int maxit, int verbose, int k=8, int l=16) :
+      _op(op,this->_phaseTimes), _prec(prec,this->_phaseTimes), _sp(sp,this->_phaseTimes), _reduction(reduction), _maxit(maxit), _verbose(verbose),
+      _k(k), _l(std::max(l,1))
+    {
+      static_assert(static_cast<int>(L::category) == static_cast<int>(P::category),
+                    "L and P must have the same category!");
+      static_assert(static_cast<int>(L::category) == static_cast<int>(S::category),
+                    "L and S must have the same category!");
+    }
+
+    /*!
+       \brief Apply inverse operator.
+
+       \copydoc InverseOperator::apply(X&,Y&,InverseOperatorResult&)
+     */
+    virtual void apply (X& x, X& b, InverseOperatorResult& res)
+    {
+      typedef typename std::vector<X>::size_type size_type;
+
+      res.clear();                  // clear solver statistics
+      this->startObservation();
+      Timer watch;                // start a timer
+      _prec.pre(x,b);             // prepare preconditioner
+      _op.applyscaleadd(-1,x,b);  // overwrite b with defect
+
+      X p(x);              // the search direction
+      X q(x);              // a temporary vector
+
+      std::vector<const X*> left, right;
+      std::vector<field_type> dots;
+
+      // the deflation space is only updated for real field types
+      const bool collect = is_same<field_type,real_type>::value && _k>0;
+
+      // the image of the deflation space and the inverse of W^H A W
+      size_type nw = _W.size();
+      std::vector<X> AW(nw,x);
+      if (nw>0)
+        _op.applyMultiple(constPointers(_W),pointers(AW));
+      if (collect && nw>static_cast<size_type>(_k))
+      {
+        // a deflation space given by setDeflationSpace() may be larger
+        // than the k vectors kept, reduce it to its best Ritz vectors
+        nw = compress(_W,AW,nw);
+        _W.resize(nw,x);
+        AW.resize(nw,x);
+      }
+      DynamicMatrix<field_type> E(nw,nw);
+      DynamicVector<field_type> g(nw), mu(nw);
+      for (size_type a=0; a<nw; ++a)
+      {
+        for (size_type c=0; c<nw; ++c) {
+          left.push_back(&_W[a]); right.push_back(&AW[c]);
+        }
+        left.push_back(&_W[a]); right.push_back(&b);
+      }
+      left.push_back(&b); right.push_back(&b);
+      _sp.idots(left,right,dots);
+      _sp.wait();
+      real_type def0 = std::sqrt(std::abs(dots.back())); // compute norm
+      if (nw>0)
+      {
+        for (size_type a=0, l=0; a<nw; ++a)
+        {
+          for (size_type c=0; c<nw; ++c)
+            E[a][c] = dots[l++];
+          g[a] = dots[l++];
+        }
+        try {
+          E.invert();
+        }
+        catch (FMatrixError&) {
+          // the deflation space is degenerated, solve without it
+          _W.clear();
+          AW.clear();
+          nw = 0;
+        }
+      }
+
+      if (def0<1E-30)    // convergence check
+      {
+        res.converged  = true;
+        res.iterations = 0;               // fill statistics
+        res.reduction = 0;
+        res.conv_rate  = 0;
+        res.elapsed=0;
+        if (_verbose>0)                 // final print
+          std::cout << "=== rate=" << res.conv_rate
+                    << ", T=" << res.elapsed << ", TIT=" << res.elapsed
+                    << ", IT=0" << std::endl;
+        _prec.post(x);
+        return;
+      }
+
+      if (_verbose>0)             // printing
+      {
+        std::cout << "=== DeflatedCGSolver" << std::endl;
+        if (_verbose>1) {
+          this->printHeader(std::cout);
+          this->printOutput(std::cout,real_type(0),def0);
+        }
+      }
+
+      // some local variables
+      real_type def=def0;   // loop variables
+      field_type rho,rholast,lambda,alpha,beta;
+
+      // Galerkin projection of the initial guess onto the deflation space
+      if (nw>0)
+      {
+        E.mv(g,mu);
+        for (size_type a=0; a<nw; ++a)
+        {
+          x.axpy(mu[a],_W[a]);
+          b.axpy(-mu[a],AW[a]);
+        }
+      }
+
+      // the deflation space and the search directions with their
+      // images, compressed to Ritz vectors every _l iterations
+      std::vector<X> Y, AY;
+      size_type ny = 0;
+      if (collect)
+      {
+        Y.resize(_k+_l,x);
+        AY.resize(_k+_l,x);
+        for (; ny<nw; ++ny)
+        {
+          Y[ny] = _W[ny];
+          AY[ny] = AW[ny];
+        }
+      }
+
+      // determine initial search direction
+      p = 0;                          // clear correction
+      _prec.apply(p,b);               // apply preconditioner
+      rholast = deflate(p,b,AW,E);    // orthogonalization
+
+      // the loop
+      int i=1;
+      for ( ; i<=_maxit; i++ )
+      {
+        // minimize in given search direction p
+        _op.apply(p,q);             // q=Ap
+        alpha = _sp.dot(p,q);       // scalar product
+        lambda = rholast/alpha;     // minimization
+        x.axpy(lambda,p);           // update solution
+        b.axpy(-lambda,q);          // update defect
+        if (collect)
+        {
+          Y[ny] = p;
+          AY[ny] = q;
+          if (++ny==Y.size())
+            ny = compress(Y,AY,ny);
+        }
+
+        // convergence test
+        real_type defnew=_sp.norm(b); // comp defect norm
+
+        if (_verbose>1)             // print
+          this->printOutput(std::cout,real_type(i),defnew,def);
+
+        def = defnew;               // update norm
+        bool proceed = this->observeIteration(i,def,def0);
+        if (def<def0*_reduction || def<1E-30)    // convergence check
+        {
+          res.converged  = true;
+          break;
+        }
+        if (!proceed)               // stopped by the observer
+          break;
+
+        // determine new search direction
+        q = 0;                      // clear correction
+        _prec.apply(q,b);           // apply preconditioner
+        rho = deflate(q,b,AW,E);    // orthogonalization
+        beta = rho/rholast;         // scaling factor
+        p *= beta;                  // scale old search direction
+        p += q;                     // orthogonalization with correction
+        rholast = rho;              // remember rho for recurrence
+      }
+
+      //correct i which is wrong if convergence was not achieved.
+      i=std::min(_maxit,i);
+
+      if (_verbose==1)                // printing for non verbose
+        this->printOutput(std::cout,real_type(i),def);
+
+      _prec.post(x);                  // postprocess preconditioner
+      if (collect && ny>0)
+      {
+        // the Ritz vectors are the deflation space of the next solve
+        ny = compress(Y,AY,ny);
+        Y.resize(ny,x);
+        _W.swap(Y);
+      }
+      res.iterations = i;               // fill statistics
+      res.reduction = static_cast<double>(def/def0);
+      res.conv_rate  = static_cast<double>(pow(res.reduction,1.0/i));
+      res.elapsed = watch.elapsed();
+
+      if (_verbose>0)                 // final print
+      {
+        std::cout << "=== rate=" << res.conv_rate
+                  << ", T=" << res.elapsed
+                  << ", TIT=" << res.elapsed/i
+                  << ", IT=" << i << std::endl;
+      }
+    }
+
+    /*!
+       \brief Apply inverse operator with given reduction factor.
+
+       \copydoc InverseOperator::apply(X&,Y&,double,InverseOperatorResult&)
+     */
+    virtual void apply (X& x, X& b, double reduction,
+                        InverseOperatorResult& res)
+    {
+      real_type saved_reduction = _reduction;
+      _reduction = reduction;
+      (*this).apply(x,b,res);
+      _reduction = saved_reduction;
+    }
+
+    //! \brief The current deflation space.
+    const std::vector<X>& deflationSpace () const
+    {
+      return _W;
+    }
+
+    /*!
+       \brief Set the deflation space used by the next solve, the vectors have to be linearly independent.
+
+       For real field types a space of more than k vectors is reduced to
+       its k best Ritz vectors at the start of the next solve.
+     */
+    void setDeflationSpace (const std::vector<X>& W)
+    {
+      _W = W;
+    }
+
+    //! \brief Forget the deflation space, e.g. if the next system is unrelated to the previous ones.
+    void clearDeflationSpace ()
+    {
+      _W.clear();
+    }
+
+  private:
+    static std::vector<X*> pointers (std::vector<X>& v)
+    {
+      std::vector<X*> p(v.size());
+      for (typename std::vector<X>::size_type j=0; j<v.size(); ++j)
+        p[j] = &v[j];
+      return p;
+    }
+
+    static std::vector<const X*> constPointers (const std::vector<X>& v)
+    {
+      std::vector<const X*> p(v.size());
+      for (typename std::vector<X>::size_type j=0; j<v.size(); ++j)
+        p[j] = &v[j];
+      return p;
+    }
+
+    /* Make the preconditioned defect z A-orthogonal to the deflation
+       space, z -= W (W^H A W)^-1 (AW)^H z, and return z^H b. All
+       scalar products are computed with one reduction. */
+    field_type deflate (X& z, const X& b, const std::vector<X>& AW,
+                        const DynamicMatrix<field_type>& E)
+    {
+      typedef typename std::vector<X>::size_type size_type;
+      const size_type nw = AW.size();
+      std::vector<const X*> left(nw+1), right(nw+1,&z);
+      std::vector<field_type> dots;
+      for (size_type a=0; a<nw; ++a)
+        left[a] = &AW[a];
+      left[nw] = &b;
+      _sp.idots(left,right,dots);
+      _sp.wait();
+      std::vector<field_type> coeff(nw,field_type(0));
+      for (size_type a=0; a<nw; ++a)
+        for (size_type c=0; c<nw; ++c)
+          coeff[a] -= E[a][c]*dots[c];
+      fusedAxpy(z,coeff,constPointers(_W));
+      return conjugate(dots[nw]);
+    }
+
+    /* Replace the first n vectors of Y by the Ritz vectors of the
+       smallest Ritz values of A in their span and AY by their images.
+       Returns the number of Ritz vectors. */
+    typename std::vector<X>::size_type compress (std::vector<X>& Y, std::vector<X>& AY,
+                                                 typename std::vector<X>::size_type n)
+    {
+      typedef typename std::vector<X>::size_type size_type;
+
+      std::vector<const X*> left, right;
+      std::vector<field_type> dots;
+      for (size_type a=0; a<n; ++a)
+        for (size_type c=a; c<n; ++c)
+        {
+          left.push_back(&Y[a]); right.push_back(&AY[c]);
+          left.push_back(&Y[a]); right.push_back(&Y[c]);
+        }
+      _sp.idots(left,right,dots);
+      _sp.wait();
+      DynamicMatrix<real_type> G(n,n), F(n,n);
+      for (size_type a=0, l=0; a<n; ++a)
+        for (size_type c=a; c<n; ++c)
+        {
+          // Y^H A Y is only symmetric up to round-off
+          G[a][c] = G[c][a] = std::real(dots[l++]);
+          F[a][c] = F[c][a] = std::real(dots[l++]);
+        }
+
+      std::vector<real_type> values;
+      DynamicMatrix<real_type> vectors;
+      if (!symmetricEigenpairs(G,F,values,vectors))
+        // the vectors are linearly dependent, restart from the newest ones
+        return 0;
+
+      const size_type k = std::min(n,static_cast<size_type>(_k));
+      std::vector<X> W(k,Y[0]), AW(k,Y[0]);
+      std::vector<field_type> coeff(n);
+      left.resize(n);
+      right.resize(n);
+      for (size_type a=0; a<n; ++a) {
+        left[a] = &Y[a]; right[a] = &AY[a];
+      }
+      for (size_type j=0; j<k; ++j)
+      {
+        W[j] = 0;
+        AW[j] = 0;
+        for (size_type a=0; a<n; ++a)
+          coeff[a] = vectors[a][j];
+        fusedAxpy(W[j],coeff,left);
+        fusedAxpy(AW[j],coeff,right);
+      }
+      for (size_type j=0; j<k; ++j)
+      {
+        Y[j] = W[j];
+        AY[j] = AW[j];
+      }
+      return k;
+    }
+
+    template<typename T>
+    typename enable_if<is_same<field_type,real_type>::value,T>::type conjugate(const T& t) {
+      return t;
+    }
+
+    template<typename T>
+    typename enable_if<!is_same<field_type,real_type>::value,T>::type conjugate(const T& t) {
+      return conj(t);
+    }
+
+    SeqScalarProduct<X> ssp;
+    TimedLinearOperator<X,X> _op;
+    TimedPreconditioner<X,X> _prec;
+    TimedScalarProduct<X> _sp;
+    real_type _reduction;
+    int _maxit;
+    int _verbose;
+    int _k;
+    int _l;
+    std::vector<X> _W;
+  };
+
+
+  // Ronald Kriemanns BiCG-STAB implementation from Sumo
+  //! \brief Bi-conjugate Gradient Stabilized (BiCG-STAB)
+  template<class X>
+  class BiCGSTABSolver : public InverseOperator<X,X> {
+  public:
+    //! \brief The domain type of the operator to be inverted.
+    typedef X domain_type;
+    //! \brief The range type of the operator to be inverted.
+    typedef X range_type;
+    //! \brief The field type of the operator to be inverted
+    typedef typename X::field_type field_type;
+    //! \brief The real type of the field type (is the same if using real numbers, but differs for std::complex)
+    typedef typename FieldTraits<field_type>::real_type real_type;
+
+    /*!
+       \brief Set up solver.
+
+       \copydoc LoopSolver::LoopSolver(L&,P&,double,int,int)
+     */
+    template<class L, class P>
+    BiCGSTABSolver (L& op, P& prec,
+                    real_type reduction, int maxit, int verbose) :
+      ssp(), _op(op,this->_phaseTimes), _prec(prec,this->_phaseTimes), _sp(ssp,this->_phaseTimes), _reduction(reduction), _maxit(maxit), _verbose(verbose)
+    {
+      static_assert(static_cast<int>(L::category) == static_cast<int>(P::category),
+                    "L and P must be of the same category!");
+      static_assert(static_cast<int>(L::category) == static_cast<int>(SolverCategory::sequential),
+                    "L must be sequential!");
+    }
+    /*!
+       \brief Set up solver.
+
+       \copydoc LoopSolver::LoopSolver(L&,S&,P&,double,int,int)
+     */
+    template<class L, class S, class P>
+    BiCGSTABSolver (L& op, S& sp, P& prec,
+                    real_type reduction, int maxit, int verbose) :
+      _op(op,this->_phaseTimes), _prec(prec,this->_phaseTimes), _sp(sp,this->_phaseTimes), _reduction(reduction), _maxit(maxit), _verbose(verbose)
+    {
+      static_assert(static_cast<int>(L::category) == static_cast<int>(P::category),
+                    "L and P must have the same category!");
+      static_assert(static_cast<int>(L::category) == static_cast<int>(S::category),
+                    "L and S must have the same category!");
+    }
+
+    /*!
+       \brief Apply inverse operator.
+
+       \copydoc InverseOperator::apply(X&,Y&,InverseOperatorResult&)
+     */
+    virtual void apply (X& x, X& b, InverseOperatorResult& res)
+    {
+      const real_type EPSILON=1e-80;
+      double it;
+      field_type rho, rho_new, alpha, beta, h, omega;
+      real_type norm, norm_old, norm_0;
+
+      //
+      // get vectors and matrix
+      //
+      X& r=b;
+      X p(x);
+      X v(x);
+      X t(x);
+      X y(x);
+      X rt(x);
+
+      // operands of the fused update of the search direction
+      std::vector<field_type> coefficients(2);
+      std::vector<const X*> directions(2);
+      directions[0] = &r;
+      directions[1] = &v;
+
+      // operands of the combined reductions
+      std::vector<const X*> shadow(1,&rt), defect(1,&r), tt(2,&t), tr(2,&r);
+      tr[1] = &t;
+      std::vector<field_type> dots;
+      std::vector<double> norms;
+
+      //
+      // begin iteration
+      //
+
+      // r = r - Ax; rt = r
+      res.clear();                // clear solver statistics
+      this->startObservation();
+      Timer watch;                // start a timer
+      _prec.pre(x,r);             // prepare preconditioner
+      _op.applyscaleadd(-1,x,r);  // overwrite b with defect
+
+      rt=r;
+
+      // rho_new = < rt , r > and the norm with one reduction
+      _sp.dotsAndNorms(shadow,defect,dots,defect,norms);
+      rho_new = dots[0];
+      norm = norm_old = norm_0 = norms[0];
+
+      p=0;
+      v=0;
+
+      rho   = 1;
+      alpha = 1;
+      omega = 1;
+
+      if (_verbose>0)             // printing
+      {
+        std::cout << "=== BiCGSTABSolver" << std::endl;
+        if (_verbose>1)
+        {
+          this->printHeader(std::cout);
+          this->printOutput(std::cout,real_type(0),norm_0);
+          //std::cout << " Iter       Defect         Rate" << std::endl;
+          //std::cout << "    0" << std::setw(14) << norm_0 << std::endl;
+        }
+      }
+
+      if ( norm < (_reduction * norm_0)  || norm<1E-30)
+      {
+        res.converged = 1;
+        _prec.post(x);                  // postprocess preconditioner
+        res.iterations = 0;             // fill statistics
+        res.reduction = 0;
+        res.conv_rate  = 0;
+        res.elapsed = watch.elapsed();
+        return;
+      }
+
+      //
+      // iteration
+      //
+
+      for (it = 0.5; it < _maxit; it+=.5)
+      {
+        //
+        // preprocess, set vecsizes etc.
+        //
+
+        // rho_new = < rt , r > was computed together with the last norm
+
+        // look if breakdown occured
+        if (std::abs(rho) <= EPSILON)
+          DUNE_THROW(ISTLError,"breakdown in BiCGSTAB - rho "
+                     << rho << " <= EPSILON " << EPSILON
+                     << " after " << it << " iterations");
+        if (std::abs(omega) <= EPSILON)
+          DUNE_THROW(ISTLError,"breakdown in BiCGSTAB - omega "
+                     << omega << " <= EPSILON " << EPSILON
+                     << " after " << it << " iterations");
+
+
+        if (it<1)
+          p = r;
+        else
+        {
+          beta = ( rho_new / rho ) * ( alpha / omega );
+          // p = r + beta (p - omega*v)
+          coefficients[0] = 1.0;
+          coefficients[1] = -beta*omega;
+          fusedAxpby(p,beta,coefficients,directions);
+        }
+
+        // y = W^-1 * p
+        y = 0;
+        _prec.apply(y,p);           // apply preconditioner
+
+        // v = A * y
+        _op.apply(y,v);
+
+        // alpha = rho_new / < rt, v >
+        h = _sp.dot(rt,v);
+
+        if ( std::abs(h) < EPSILON )
+          DUNE_THROW(ISTLError,"h=0 in BiCGSTAB");
+
+        alpha = rho_new / h;
+
+        // apply first correction to x
+        // x <- x + alpha y
+        x.axpy(alpha,y);
+
+        // r = r - alpha*v
+        norm = _sp.axpyNorm(r,-alpha,v);
+
+        //
+        // test stop criteria
+        //
+
+        if (_verbose>1) // print
+        {
+          this->printOutput(std::cout,real_type(it),norm,norm_old);
+        }
+
+        bool proceed = this->observeIteration(it,norm,norm_0);
+        if ( norm < (_reduction * norm_0) )
+        {
+          res.converged = 1;
+          break;
+        }
+        if (!proceed)               // stopped by the observer
+          break;
+        it+=.5;
+
+        norm_old = norm;
+
+        // y = W^-1 * r
+        y = 0;
+        _prec.apply(y,r);
+
+        // t = A * y
+        _op.apply(y,t);
+
+        // omega = < t, r > / < t, t > with one reduction
+        _sp.idots(tt,tr,dots);
+        _sp.wait();
+        omega = dots[0]/dots[1];
+
+        // apply second correction to x
+        // x <- x + omega y
+        x.axpy(omega,y);
+
+        // r = s - omega*t (remember : r = s)
+        r.axpy(-omega,t);
+
+        rho = rho_new;
+
+        //
+        // test stop criteria
+        //
+
+        // the norm and rho_new = < rt , r > for the next step with one reduction
+        _sp.dotsAndNorms(shadow,defect,dots,defect,norms);
+        rho_new = dots[0];
+        norm = norms[0];
+
+        if (_verbose > 1)             // print
+        {
+          this->printOutput(std::cout,real_type(it),norm,norm_old);
+        }
+
+        proceed = this->observeIteration(it,norm,norm_0);
+        if ( norm < (_reduction * norm_0)  || norm<1E-30)
+        {
+          res.converged = 1;
+          break;
+        }
+        if (!proceed)               // stopped by the observer
+          break;
+
+        norm_old = norm;
+      } // end for
+
+      //correct i which is wrong if convergence was not achieved.
+      it=std::min(static_cast<double>(_maxit),it);
+
+      if (_verbose==1)                // printing for non verbose
+        this->printOutput(std::cout,real_type(it),norm);
+
+      _prec.post(x);                  // postprocess preconditioner
+      res.iterations = static_cast<int>(std::ceil(it));              // fill statistics
+      res.reduction = static_cast<double>(norm/norm_0);
+      res.conv_rate  = static_cast<double>(pow(res.reduction,1.0/it));
+      res.elapsed = watch.elapsed();
+      if (_verbose>0)                 // final print
+        std::cout << "=== rate=" << res.conv_rate
+                  << ", T=" << res.elapsed
+                  << ", TIT=" << res.elapsed/it
+                  << ", IT=" << it << std::endl;
+    }
+
+    /*!
+       \brief Apply inverse operator with given reduction factor.
+
+       \copydoc InverseOperator::apply(X&,Y&,double,InverseOperatorResult&)
+     */
+    virtual void apply (X& x, X& b, double reduction, InverseOperatorResult& res)
+    {
+      real_type saved_reduction = _reduction;
+      _reduction = reduction;
+      (*this).apply(x,b,res);
+      _reduction = saved_reduction;
+    }
+
+  private:
+    SeqScalarProduct<X> ssp;
+    TimedLinearOperator<X,X> _op;
+    TimedPreconditioner<X,X> _prec;
+    TimedScalarProduct<X> _sp;
+    real_type _reduction;
+    int _maxit;
+    int _verbose;
+  };
+
+  /*!
+     \brief Induced Dimension Reduction method IDR(s)
+
+     Implements IDR(s) with biorthogonalization as described in
+     M. B. van Gijzen, P. Sonneveld, Algorithm 913: An Elegant IDR(s)
+     Variant that Efficiently Exploits Biorthogonality Properties, ACM
+     TOMS 38(1), 2011, with right preconditioning and the "maintaining
+     the convergence" choice of the relaxation parameter.
+
+     IDR(s) is a short recurrence method for nonsymmetric systems. It
+     needs s+1 operator applications per cycle and 3s+2 auxiliary
+     vectors independent of the number of iterations. IDR(1) is
+     mathematically equivalent to BiCGSTAB, larger s approach the
+     robustness of full GMRes. The iteration count is the number of
+     operator applications.
+   */
+  template<class X>
+  class IDRSolver : public InverseOperator<X,X> {
+  public:
+    //! \brief The domain type of the operator to be inverted.
+    typedef X domain_type;
+    //! \brief The range type of the operator to be inverted.
+    typedef X range_type;
+    //! \brief The field type of the operator to be inverted
+    typedef typename X::field_type field_type;
+    //! \brief The real type of the field type (is the same if using real numbers, but differs for std::complex)
+    typedef typename FieldTraits<field_type>::real_type real_type;
+
+    /*!
+       \brief Set up solver.
+
+       \copydoc LoopSolver::LoopSolver(L&,P&,double,int,int)
+       \param s The dimension of the shadow space.
+     */
+    template<class L, class P>
+    IDRSolver (L& op, P& prec,
+               real_type reduction, int maxit, int verbose, int s=4) :
+      ssp(), _op(op,this->_phaseTimes), _prec(prec,this->_phaseTimes), _sp(ssp,this->_phaseTimes), _reduction(reduction), _maxit(maxit), _verbose(verbose),
+      _s(s)
+    {
+      static_assert(static_cast<int>(L::category) == static_cast<int>(P::category),
+                    "L and P must be of the same category!");
+      static_assert(static_cast<int>(L::category) == static_cast<int>(SolverCategory::sequential),
+                    "L must be sequential!");
+    }
+    /*!
+       \brief Set up solver.
+
+       \copydoc LoopSolver::LoopSolver(L&,S&,P&,double,int,int)
+       \param s The dimension of the shadow space.
+     */
+    template<class L, class S, class P>
+    IDRSolver (L& op, S& sp, P& prec,
+               real_type reduction, int maxit, int verbose, int s=4) :
+      _op(op,this->_phaseTimes), _prec(prec,this->_phaseTimes), _sp(sp,this->_phaseTimes), _reduction(reduction), _maxit(maxit), _verbose(verbose),
+      _s(s)
+    {
+      static_assert(static_cast<int>(L::category) == static_cast<int>(P::category),
+                    "L and P must have the same category!");
+      static_assert(static_cast<int>(L::category) == static_cast<int>(S::category),
+                    "L and S must have the same category!");
+    }
+
+    /*!
+       \brief Apply inverse operator.
+
+       \copydoc InverseOperator::apply(X&,Y&,InverseOperatorResult&)
+     */
+    virtual void apply (X& x, X& b, InverseOperatorResult& res)
+    {
+      const real_type EPSILON=1e-80;
+      const real_type angle=0.7;
+      const int s = _s;
+      real_type norm, norm_old, norm_0;
+
+      //
+      // get vectors and matrix
+      //
+      X& r=b;
+      X v(x);
+      X t(x);
+      std::vector<X> P(s,x);      // shadow space
+      std::vector<X> G(s,x);      // G = A U
+      std::vector<X> U(s,x);
+      std::vector<std::vector<field_type> > M(s,std::vector<field_type>(s,0.0));
+      std::vector<field_type> f(s), c(s);
+
+      //
+      // begin iteration
+      //
+
+      // r = r - Ax
+      res.clear();                // clear solver statistics
+      this->startObservation();
+      Timer watch;                // start a timer
+      _prec.pre(x,r);             // prepare preconditioner
+      _op.applyscaleadd(-1,x,r);  // overwrite b with defect
+
+      norm = norm_old = norm_0 = _sp.norm(r);
+
+      if (_verbose>0)             // printing
+      {
+        std::cout << "=== IDRSolver" << std::endl;
+        if (_verbose>1)
+        {
+          this->printHeader(std::cout);
+          this->printOutput(std::cout,real_type(0),norm_0);
+        }
+      }
+
+      if ( norm<1E-30 )
+      {
+        res.converged = 1;
+        _prec.post(x);                  // postprocess preconditioner
+        res.iterations = 0;             // fill statistics
+        res.reduction = 0;
+        res.conv_rate  = 0;
+        res.elapsed = watch.elapsed();
+        return;
+      }
+
+      // the shadow space is spanned by orthonormalized pseudo random vectors
+      unsigned int seed = 4711;
+      for (int i=0; i<s; ++i)
+      {
+        for (typename X::size_type j=0; j<P[i].N(); ++j)
+        {
+          seed = 1664525u*seed+1013904223u;
+          P[i][j] = real_type(seed)/real_type(4294967296.0) - real_type(0.5);
+        }
+        for (int k=0; k<i; ++k)
+          P[i].axpy(-_sp.dot(P[k],P[i]),P[k]);
+        P[i] *= 1.0/_sp.norm(P[i]);
+        G[i] = 0;
+        U[i] = 0;
+        M[i][i] = 1.0;
+      }
+      field_type omega = 1.0;
+
+      //
+      // iteration
+      //
+
+      int it = 0;
+      bool stopped = false;   // set if the observer stops the iteration
+      while (it < _maxit && !res.converged && !stopped)
+      {
+        // f = P^H r
+        for (int i=0; i<s; ++i)
+          f[i] = _sp.dot(P[i],r);
+
+        for (int k=0; k<s && it<_maxit; ++k)
+        {
+          // solve the lower triangular system M(k:s,k:s) c = f(k:s)
+          for (int i=k; i<s; ++i)
+          {
+            c[i] = f[i];
+            for (int j=k; j<i; ++j)
+              c[i] -= M[i][j]*c[j];
+            c[i] /= M[i][i];
+          }
+
+          // v = r - G(:,k:s) c, preconditioned
+          t = r;
+          for (int i=k; i<s; ++i)
+            t.axpy(-c[i],G[i]);
+          v = 0;
+          _prec.apply(v,t);
+
+          // new direction U(:,k) = U(:,k:s) c + omega v and its image
+          v *= omega;
+          for (int i=k; i<s; ++i)
+            v.axpy(c[i],U[i]);
+          U[k] = v;
+          _op.apply(U[k],G[k]);
+
+          // make G(:,k) orthogonal to P(:,0:k-1)
+          for (int i=0; i<k; ++i)
+          {
+            field_type alpha = _sp.dot(P[i],G[k])/M[i][i];
+            G[k].axpy(-alpha,G[i]);
+            U[k].axpy(-alpha,U[i]);
+          }
+
+          // new column of M = P^H G
+          for (int i=k; i<s; ++i)
+            M[i][k] = _sp.dot(P[i],G[k]);
+          if (std::abs(M[k][k]) <= EPSILON)
+            DUNE_THROW(ISTLError,"breakdown in IDR(s) - M(k,k) "
+                       << M[k][k] << " <= EPSILON " << EPSILON
+                       << " after " << it << " iterations");
+
+          // make r orthogonal to P(:,0:k)
+          field_type beta = f[k]/M[k][k];
+          r.axpy(-beta,G[k]);
+          x.axpy(beta,U[k]);
+          ++it;
+
+          norm = _sp.norm(r);
+          if (_verbose>1) // print
+            this->printOutput(std::cout,real_type(it),norm,norm_old);
+          norm_old = norm;
+
+          stopped = !this->observeIteration(it,norm,norm_0);
+          if ( norm < (_reduction * norm_0) || norm<1E-30)
+          {
+            res.converged = 1;
+            break;
+          }
+          if (stopped)
+            break;
+
+          for (int i=k+1; i<s; ++i)
+            f[i] -= beta*M[i][k];
+        }
+
+        if (res.converged || stopped || it >= _maxit)
+          break;
+
+        // dimension reduction step
+        v = 0;
+        _prec.apply(v,r);
+        _op.apply(v,t);
+
+        // omega minimizes the defect, but is increased if the
+        // angle between t and r gets too small
+        field_type tr = _sp.dot(t,r);
+        real_type nt = _sp.norm(t);
+        if (nt <= EPSILON)
+          DUNE_THROW(ISTLError,"breakdown in IDR(s) - |t| "
+                     << nt << " <= EPSILON " << EPSILON
+                     << " after " << it << " iterations");
+        omega = tr/(nt*nt);
+        real_type rho = std::abs(tr)/(nt*norm);
+        if (rho < angle)
+          omega *= angle/rho;
+        if (std::abs(omega) <= EPSILON)
+          DUNE_THROW(ISTLError,"breakdown in IDR(s) - omega "
+                     << omega << " <= EPSILON " << EPSILON
+                     << " after " << it << " iterations");
+
+        x.axpy(omega,v);
+        r.axpy(-omega,t);
+        ++it;
+
+        norm = _sp.norm(r);
+        if (_verbose>1) // print
+          this->printOutput(std::cout,real_type(it),norm,norm_old);
+        norm_old = norm;
+
+        stopped = !this->observeIteration(it,norm,norm_0);
+        if ( norm < (_reduction * norm_0) || norm<1E-30)
+          res.converged = 1;
+      }
+
+      if (_verbose==1)                // printing for non verbose
+        this->printOutput(std::cout,real_type(it),norm);
+
+      _prec.post(x);                  // postprocess preconditioner
+      res.iterations = it;            // fill statistics
+      res.reduction = static_cast<double>(norm/norm_0);
+      res.conv_rate  = static_cast<double>(pow(res.reduction,1.0/it));
+      res.elapsed = watch.elapsed();
+      if (_verbose>0)                 // final print
+        std::cout << "=== rate=" << res.conv_rate
+                  << ", T=" << res.elapsed
+                  << ", TIT=" << res.elapsed/it
+                  << ", IT=" << it << std::endl;
+    }
+
+    /*!
+       \brief Apply inverse operator with given reduction factor.
+
+       \copydoc InverseOperator::apply(X&,Y&,double,InverseOperatorResult&)
+     */
+    virtual void apply (X& x, X& b, double reduction, InverseOperatorResult& res)
+    {
+      real_type saved_reduction = _reduction;
+      _reduction = reduction;
+      (*this).apply(x,b,res);
+      _reduction = saved_reduction;
+    }
+
+  private:
+    SeqScalarProduct<X> ssp;
+    TimedLinearOperator<X,X> _op;
+    TimedPreconditioner<X,X> _prec;
+    TimedScalarProduct<X> _sp;
+    real_type _reduction;
+    int _maxit;
+    int _verbose;
+    int _s;
+  };
+
+  /*!
+     \brief BiCGSTAB(l)
+
+     Implements BiCGSTAB(l) as described in G. L. G. Sleijpen,
+     D. R. Fokkema, BiCGstab(l) for linear equations involving unsymmetric
+     matrices with complex spectrum, ETNA 1, 1993, with right
+     preconditioning.
+
+     Each cycle does l BiCG steps followed by a minimal residual
+     polynomial of degree l, which is computed with modified Gram-Schmidt.
+     For convection dominated problems with eigenvalues close to the
+     imaginary axis this avoids the stagnation of BiCGSTAB, which is the
+     case l=1. One iteration consists of two operator applications like
+     in BiCGSTABSolver, so the iteration count is a multiple of l. The
+     method needs 2l+5 auxiliary vectors.
+   */
+  template<class X>
+  class BiCGSTABLSolver : public InverseOperator<X,X> {
+  public:
+    //! \brief The domain type of the operator to be inverted.
+    typedef X domain_type;
+    //! \brief The range type of the operator to be inverted.
+    typedef X range_type;
+    //! \brief The field type of the operator to be inverted
+    typedef typename X::field_type field_type;
+    //! \brief The real type of the field type (is the same if using real numbers, but differs for std::complex)
+    typedef typename FieldTraits<field_type>::real_type real_type;
+
+    /*!
+       \brief Set up solver.
+
+       \copydoc LoopSolver::LoopSolver(L&,P&,double,int,int)
+       \param l The degree of the minimal residual polynomial.
+     */
+    template<class L, class P>
+    BiCGSTABLSolver (L& op, P& prec,
+                     real_type reduction, int maxit, int verbose, int l=2) :
+      ssp(), _op(op,this->_phaseTimes), _prec(prec,this->_phaseTimes), _sp(ssp,this->_phaseTimes), _reduction(reduction), _maxit(maxit), _verbose(verbose),
+      _l(l)
+    {
+      static_assert(static_cast<int>(L::category) == static_cast<int>(P::category),
+                    "L and P must be of the same category!");
+      static_assert(static_cast<int>(L::category) == static_cast<int>(SolverCategory::sequential),
+                    "L must be sequential!");
+    }
+    /*!
+       \brief Set up solver.
+
+       \copydoc LoopSolver::LoopSolver(L&,S&,P&,double,int,int)
+       \param l The degree of the minimal residual polynomial.
+     */
+    template<class L, class S, class P>
+    BiCGSTABLSolver (L& op, S& sp, P& prec,
+                     real_type reduction, int maxit, int verbose, int l=2) :
+      _op(op,this->_phaseTimes), _prec(prec,this->_phaseTimes), _sp(sp,this->_phaseTimes), _reduction(reduction), _maxit(maxit), _verbose(verbose),
+      _l(l)
+    {
+      static_assert(static_cast<int>(L::category) == static_cast<int>(P::category),
+                    "L and P must have the same category!");
+      static_assert(static_cast<int>(L::category) == static_cast<int>(S::category),
+                    "L and S must have the same category!");
+    }
+
+    /*!
+       \brief Apply inverse operator.
+
+       \copydoc InverseOperator::apply(X&,Y&,InverseOperatorResult&)
+     */
+    virtual void apply (X& x, X& b, InverseOperatorResult& res)
+    {
+      const real_type EPSILON=1e-80;
+      const int l = _l;
+      real_type norm, norm_old, norm_0;
+
+      //
+      // get vectors and matrix
+      //
+      std::vector<X> r(l+1,x);   // defect and its images
+      std::vector<X> u(l+1,x);   // search directions and their images
+      X rt(x);                    // shadow defect
+      X xh(x);                    // correction before preconditioning
+      X t(x);
+      std::vector<std::vector<field_type> > tau(l+1,std::vector<field_type>(l+1,0.0));
+      std::vector<real_type> sigma(l+1);
+      std::vector<field_type> gamma(l+1), gamma1(l+1), gamma2(l+1);
+
+      //
+      // begin iteration
+      //
+
+      // r = b - Ax; rt = r
+      res.clear();                // clear solver statistics
+      this->startObservation();
+      Timer watch;                // start a timer
+      _prec.pre(x,b);             // prepare preconditioner
+      _op.applyscaleadd(-1,x,b);  // overwrite b with defect
+      r[0] = b;
+      rt = b;
+
+      norm = norm_old = norm_0 = _sp.norm(r[0]);
+
+      if (_verbose>0)             // printing
+      {
+        std::cout << "=== BiCGSTABLSolver" << std::endl;
+        if (_verbose>1)
+        {
+          this->printHeader(std::cout);
+          this->printOutput(std::cout,real_type(0),norm_0);
+        }
+      }
+
+      if ( norm<1E-30 )
+      {
+        res.converged = 1;
+        _prec.post(x);                  // postprocess preconditioner
+        res.iterations = 0;             // fill statistics
+        res.reduction = 0;
+        res.conv_rate  = 0;
+        res.elapsed = watch.elapsed();
+        return;
+      }
+
+      u[0] = 0;
+      xh = 0;
+      field_type rho0 = 1.0, alpha = 0.0, omega = 1.0;
+
+      //
+      // iteration
+      //
+
+      int it = 0;
+      while (it < _maxit)
+      {
+        rho0 *= -omega;
+
+        // BiCG part
+        for (int j=0; j<l; ++j)
+        {
+          field_type rho1 = _sp.dot(rt,r[j]);
+          if (std::abs(rho0) <= EPSILON)
+            DUNE_THROW(ISTLError,"breakdown in BiCGSTAB(l) - rho "
+                       << rho0 << " <= EPSILON " << EPSILON
+                       << " after " << it << " iterations");
+          field_type beta = alpha*rho1/rho0;
+          rho0 = rho1;
+          for (int i=0; i<=j; ++i)
+          {
+            u[i] *= -beta;
+            u[i] += r[i];
+          }
+
+          // u[j+1] = A W^-1 u[j]
+          t = 0;
+          _prec.apply(t,u[j]);
+          _op.apply(t,u[j+1]);
+
+          field_type h = _sp.dot(rt,u[j+1]);
+          if (std::abs(h) <= EPSILON)
+            DUNE_THROW(ISTLError,"breakdown in BiCGSTAB(l) - <rt,Au> "
+                       << h << " <= EPSILON " << EPSILON
+                       << " after " << it << " iterations");
+          alpha = rho0/h;
+          for (int i=0; i<=j; ++i)
+            r[i].axpy(-alpha,u[i+1]);
+
+          // r[j+1] = A W^-1 r[j]
+          t = 0;
+          _prec.apply(t,r[j]);
+          _op.apply(t,r[j+1]);
+
+          xh.axpy(alpha,u[0]);
+        }
+
+        // MR part, modified Gram-Schmidt
+        for (int j=1; j<=l; ++j)
+        {
+          for (int i=1; i<j; ++i)
+          {
+            tau[i][j] = _sp.dot(r[i],r[j])/sigma[i];
+            r[j].axpy(-tau[i][j],r[i]);
+          }
+          sigma[j] = _sp.norm(r[j]);
+          sigma[j] *= sigma[j];
+          if (sigma[j] <= EPSILON)
+            DUNE_THROW(ISTLError,"breakdown in BiCGSTAB(l) - sigma "
+                       << sigma[j] << " <= EPSILON " << EPSILON
+                       << " after " << it << " iterations");
+          gamma1[j] = _sp.dot(r[j],r[0])/sigma[j];
+        }
+
+        gamma[l] = gamma1[l];
+        omega = gamma[l];
+        for (int j=l-1; j>=1; --j)
+        {
+          gamma[j] = gamma1[j];
+          for (int i=j+1; i<=l; ++i)
+            gamma[j] -= tau[j][i]*gamma[i];
+        }
+        for (int j=1; j<l; ++j)
+        {
+          gamma2[j] = gamma[j+1];
+          for (int i=j+1; i<l; ++i)
+            gamma2[j] += tau[j][i]*gamma[i+1];
+        }
+
+        // update
+        xh.axpy(gamma[1],r[0]);
+        r[0].axpy(-gamma1[l],r[l]);
+        u[0].axpy(-gamma[l],u[l]);
+        for (int j=1; j<l; ++j)
+        {
+          u[0].axpy(-gamma[j],u[j]);
+          xh.axpy(gamma2[j],r[j]);
+          r[0].axpy(-gamma1[j],r[j]);
+        }
+        it += l;
+
+        //
+        // test stop criteria
+        //
+
+        norm = _sp.norm(r[0]);
+
+        if (_verbose>1) // print
+          this->printOutput(std::cout,real_type(it),norm,norm_old);
+        norm_old = norm;
+
+        bool proceed = this->observeIteration(it,norm,norm_0);
+        if ( norm < (_reduction * norm_0) || norm<1E-30)
+        {
+          res.converged = 1;
+          break;
+        }
+        if (!proceed)               // stopped by the observer
+          break;
+      }
+
+      // x = x + W^-1 xh
+      t = 0;
+      _prec.apply(t,xh);
+      x += t;
+
+      if (_verbose==1)                // printing for non verbose
+        this->printOutput(std::cout,real_type(it),norm);
+
+      _prec.post(x);                  // postprocess preconditioner
+      res.iterations = it;            // fill statistics
+      res.reduction = static_cast<double>(norm/norm_0);
+      res.conv_rate  = static_cast<double>(pow(res.reduction,1.0/it));
+      res.elapsed = watch.elapsed();
+      if (_verbose>0)                 // final print
+        std::cout << "=== rate=" << res.conv_rate
+                  << ", T=" << res.elapsed
+                  << ", TIT=" << res.elapsed/it
+                  << ", IT=" << it << std::endl;
+    }
+
+    /*!
+       \brief Apply inverse operator with given reduction factor.
+
+       \copydoc InverseOperator::apply(X&,Y&,double,InverseOperatorResult&)
+     */
+    virtual void apply (X& x, X& b, double reduction, InverseOperatorResult& res)
+    {
+      real_type saved_reduction = _reduction;
+      _reduction = reduction;
+      (*this).apply(x,b,res);
+      _reduction = saved_reduction;
+    }
+
+  private:
+    SeqScalarProduct<X> ssp;
+    TimedLinearOperator<X,X> _op;
+    TimedPreconditioner<X,X> _prec;
+    TimedScalarProduct<X> _sp;
+    real_type _reduction;
+    int _maxit;
+    int _verbose;
+    int _l;
+  };
+
+  /*! \brief Minimal Residual Method (MINRES)
+
+     Symmetrically Preconditioned MINRES as in A. Greenbaum, 'Iterative Methods for Solving Linear Systems', pp. 121
+     Iterative solver for symmetric indefinite operators.
+     Note that in order to ensure the (symmetrically) preconditioned system to remain symmetric, the preconditioner has to be spd.
+   */
+  template<class X>
+  class MINRESSolver : public InverseOperator<X,X> {
+  public:
+    //! \brief The domain type of the operator to be inverted.
+    typedef X domain_type;
+    //! \brief The range type of the operator to be inverted.
+    typedef X range_type;
+    //! \brief The field type of the operator to be inverted.
+    typedef typename X::field_type field_type;
+    //! \brief The real type of the field type (is the same if using real numbers, but differs for std::complex)
+    typedef typename FieldTraits<field_type>::real_type real_type;
+
+    /*!
+       \brief Set up MINRES solver.
+
+       \copydoc LoopSolver::LoopSolver(L&,P&,double,int,int)
+     */
+    template<class L, class P>
+    MINRESSolver (L& op, P& prec, real_type reduction, int maxit, int verbose) :
+      ssp(), _op(op,this->_phaseTimes), _prec(prec,this->_phaseTimes), _sp(ssp,this->_phaseTimes), _reduction(reduction), _maxit(maxit), _verbose(verbose)
+    {
+      static_assert(static_cast<int>(L::category) == static_cast<int>(P::category),
+                    "L and P must have the same category!");
+      static_assert(static_cast<int>(L::category) == static_cast<int>(SolverCategory::sequential),
+                    "L must be sequential!");
+    }
+    /*!
+       \brief Set up MINRES solver.
+
+       \copydoc LoopSolver::LoopSolver(L&,S&,P&,double,int,int)
+     */
+    template<class L, class S, class P>
+    MINRESSolver (L& op, S& sp, P& prec, real_type reduction, int maxit, int verbose) :
+      _op(op,this->_phaseTimes), _prec(prec,this->_phaseTimes), _sp(sp,this->_phaseTimes), _reduction(reduction), _maxit(maxit), _verbose(verbose)
+    {
+      static_assert(static_cast<int>(L::category) == static_cast<int>(P::category),
+                    "L and P must have the same category!");
+      static_assert(static_cast<int>(L::category) == static_cast<int>(S::category),
+                    "L and S must have the same category!");
+    }
+
+    /*!
+       \brief Apply inverse operator.
+
+       \copydoc InverseOperator::apply(X&,Y&,InverseOperatorResult&)
+     */
+    virtual void apply (X& x, X& b, InverseOperatorResult& res)
+    {
+      // clear solver statistics
+      res.clear();
+      this->startObservation();
+      // start a timer
+      Dune::Timer watch;
+      watch.reset();
+      // prepare preconditioner
+      _prec.pre(x,b);
+      // overwrite rhs with defect
+      _op.applyscaleadd(-1,x,b);
+
+      // compute residual norm
+      real_type def0 = _sp.norm(b);
+
+      // printing
+      if(_verbose > 0) {
+        std::cout << "=== MINRESSolver" << std::endl;
+        if(_verbose > 1) {
+          this->printHeader(std::cout);
+          this->printOutput(std::cout,real_type(0),def0);
+        }
+      }
+
+      // check for convergence
+      if(def0 < 1e-30 ) {
+        res.converged = true;
+        res.iterations = 0;
+        res.reduction = 0;
+        res.conv_rate = 0;
+        res.elapsed = 0.0;
+        // final print
+        if(_verbose > 0)
+          std::cout << "=== rate=" << res.conv_rate
+                    << ", T=" << res.elapsed
+                    << ", TIT=" << res.elapsed
+                    << ", IT=" << res.iterations
+                    << std::endl;
+        return;
+      }
+
+      // the defect norm
+      real_type def = def0;
+      // recurrence coefficients as computed in Lanczos algorithm
+      field_type alpha, beta;
+        // diagonal entries of givens rotation
+      Dune::array<real_type,2> c{{0.0,0.0}};
+        // off-diagonal entries of givens rotation
+      Dune::array<field_type,2> s{{0.0,0.0}};
+
+      // recurrence coefficients (column k of tridiag matrix T_k)
+      Dune::array<field_type,3> T{{0.0,0.0,0.0}};
+
+      // the rhs vector of the min problem
+      Dune::array<field_type,2> xi{{1.0,0.0}};
+
+      // some temporary vectors
+      X z(b), dummy(b);
+
+      // initialize and clear correction
+      z = 0.0;
+      _prec.apply(z,b);
+
+      // beta is real and positive in exact arithmetic
+      // since it is the norm of the basis vectors (in unpreconditioned case)
+      beta = std::sqrt(_sp.dot(b,z));
+      field_type beta0 = beta;
+
+      // the search directions
+      Dune::array<X,3> p{{b,b,b}};
+      p[0] = 0.0;
+      p[1] = 0.0;
+      p[2] = 0.0;
+
+      // orthonormal basis vectors (in unpreconditioned case)
+      Dune::array<X,3> q{{b,b,b}};
+      q[0] = 0.0;
+      q[1] *= 1.0/beta;
+      q[2] = 0.0;
+
+      z *= 1.0/beta;
+
+      // the loop
+      int i = 1;
+      for( ; i<=_maxit; i++) {
+
+        dummy = z;
+        int i1 = i%3,
+          i0 = (i1+2)%3,
+          i2 = (i1+1)%3;
+
+        // symmetrically preconditioned Lanczos algorithm (see Greenbaum p.121)
+        _op.apply(z,q[i2]); // q[i2] = Az
+        q[i2].axpy(-beta,q[i0]);
+        // alpha is real since it is the diagonal entry of the hermitian tridiagonal matrix
+        // from the Lanczos Algorithm
+        // so the order in the scalar product doesn't matter even for the complex case
+        alpha = _sp.dot(z,q[i2]);
+        q[i2].axpy(-alpha,q[i1]);
+
+        z = 0.0;
+        _prec.apply(z,q[i2]);
+
+        // beta is real and positive in exact arithmetic
+        // since it is the norm of the basis vectors (in unpreconditioned case)
+        beta = std::sqrt(_sp.dot(q[i2],z));
+
+        q[i2] *= 1.0/beta;
+        z *= 1.0/beta;
+
+        // QR Factorization of recurrence coefficient matrix
+        // apply previous givens rotations to last column of T
+        T[1] = T[2];
+        if(i>2) {
+          T[0] = s[i%2]*T[1];
+          T[1] = c[i%2]*T[1];
+        }
+        if(i>1) {
+          T[2] = c[(i+1)%2]*alpha - s[(i+1)%2]*T[1];
+          T[1] = c[(i+1)%2]*T[1] + s[(i+1)%2]*alpha;
+        }
+        else
+          T[2] = alpha;
+
+        // update QR factorization
+        generateGivensRotation(T[2],beta,c[i%2],s[i%2]);
+        // to last column of T_k
+        T[2] = c[i%2]*T[2] + s[i%2]*beta;
+        // and to the rhs xi of the min problem
+        xi[i%2] = -s[i%2]*xi[(i+1)%2];
+        xi[(i+1)%2] *= c[i%2];
+
+        // compute correction direction
+        p[i2] = dummy;
+        p[i2].axpy(-T[1],p[i1]);
+        p[i2].axpy(-T[0],p[i0]);
+        p[i2] *= 1.0/T[2];
+
+        // apply correction/update solution
+        x.axpy(beta0*xi[(i+1)%2],p[i2]);
+
+        // remember beta_old
+        T[2] = beta;
+
+        // check for convergence
+        // the last entry in the rhs of the min-problem is the residual
+        real_type defnew = std::abs(beta0*xi[i%2]);
+
+          if(_verbose > 1)
+            this->printOutput(std::cout,real_type(i),defnew,def);
+
+          def = defnew;
+          bool proceed = this->observeIteration(i,def,def0);
+          if(def < def0*_reduction || def < 1e-30 || i == _maxit ) {
+            res.converged = true;
+            break;
+          }
+          if (!proceed)               // stopped by the observer
+            break;
+        } // end for
+
+        if(_verbose == 1)
+          this->printOutput(std::cout,real_type(i),def);
+
+        // postprocess preconditioner
+        _prec.post(x);
+        // fill statistics
+        res.iterations = i;
+        res.reduction = static_cast<double>(def/def0);
+        res.conv_rate = static_cast<double>(pow(res.reduction,1.0/i));
+        res.elapsed = watch.elapsed();
+
+        // final print
+        if(_verbose > 0) {
+          std::cout << "=== rate=" << res.conv_rate
+                    << ", T=" << res.elapsed
+                    << ", TIT=" << res.elapsed/i
+                    << ", IT=" << i << std::endl;
+        }
+    }
+
+    /*!
+       \brief Apply inverse operator with given reduction factor.
+
+       \copydoc InverseOperator::apply(X&,Y&,double,InverseOperatorResult&)
+     */
+    virtual void apply (X& x, X& b, double reduction, InverseOperatorResult& res)
+    {
+      real_type saved_reduction = _reduction;
+      _reduction = reduction;
+      (*this).apply(x,b,res);
+      _reduction = saved_reduction;
+    }
+
+  private:
+
+    void generateGivensRotation(field_type &dx, field_type &dy, real_type &cs, field_type &sn)
+    {
+      real_type norm_dx = std::abs(dx);
+      real_type norm_dy = std::abs(dy);
+      if(norm_dy < 1e-15) {
+        cs = 1.0;
+        sn = 0.0;
+      } else if(norm_dx < 1e-15) {
+        cs = 0.0;
+        sn = 1.0;
+      } else if(norm_dy > norm_dx) {
+        real_type temp = norm_dx/norm_dy;
+        cs = 1.0/std::sqrt(1.0 + temp*temp);
+        sn = cs;
+        cs *= temp;
+        sn *= dx/norm_dx;
+        // dy is real in exact arithmetic
+        // so we don't need to conjugate here
+        sn *= dy/norm_dy;
+      } else {
+        real_type temp = norm_dy/norm_dx;
+        cs = 1.0/std::sqrt(1.0 + temp*temp);
+        sn = cs;
+        sn *= dy/dx;
+        // dy and dx is real in exact arithmetic
+        // so we don't have to conjugate both of them
+      }
+    }
+
+    SeqScalarProduct<X> ssp;
+    TimedLinearOperator<X,X> _op;
+    TimedPreconditioner<X,X> _prec;
+    TimedScalarProduct<X> _sp;
+    real_type _reduction;
+    int _maxit;
+    int _verbose;
+  };
+
+  /**
+     \brief The orthogonalization used by RestartedGMResSolver.
+   */
+  struct GMResOrthogonalization
+  {
+    enum Type {
+      //! \brief modified Gram-Schmidt, one global reduction per basis vector
+      modifiedGramSchmidt,
+      //! \brief classical Gram-Schmidt with selective reorthogonalization (CGS2), one or two global reductions per iteration
+      classicalGramSchmidt2
+    };
+  };
+
+  /**
+     \brief implements the Generalized Minimal Residual (GMRes) method
+
+     GMRes solves the unsymmetric linear system Ax = b using the
+     Generalized Minimal Residual method as described the SIAM Templates
+     book (http://www.netlib.org/templates/templates.pdf).
+
+     The Krylov basis is orthogonalized with modified Gram-Schmidt by
+     default. With GMResOrthogonalization::classicalGramSchmidt2 all
+     scalar products of an iteration are computed with one call to
+     ScalarProduct::idots() and the basis update is a single fused
+     sweep; a second pass is only done if cancellation is detected.
+
+     \tparam X trial vector, vector type of the solution
+     \tparam Y test vector, vector type of the RHS
+     \tparam F vector type for orthonormal basis of Krylov space
+
+   */
+
+  template<class X, class Y=X, class F = Y>
+  class RestartedGMResSolver : public InverseOperator<X,Y>
+  {
+  public:
+    //! \brief The domain type of the operator to be inverted.
+    typedef X domain_type;
+    //! \brief The range type of the operator to be inverted.
+    typedef Y range_type;
+    //! \brief The field type of the operator to be inverted
+    typedef typename X::field_type field_type;
+    //! \brief The real type of the field type (is the same if using real numbers, but differs for std::complex)
+    typedef typename FieldTraits<field_type>::real_type real_type;
+    //! \brief The field type of the basis vectors
+    typedef F basis_type;
+
+    template<class L, class P>
+    DUNE_DEPRECATED_MSG("recalc_defect is a unused parameter! Use RestartedGMResSolver(L& op, P& prec, real_type reduction, int restart, int maxit, int verbose) instead")
+    RestartedGMResSolver (L& op, P& prec, real_type reduction, int restart, int maxit, int verbose, bool recalc_defect)
+      : _A(op,this->_phaseTimes)
+      , _W(prec,this->_phaseTimes)
+      , ssp()
+      , _sp(ssp,this->_phaseTimes)
+      , _restart(restart)
+      , _reduction(reduction)
+      , _maxit(maxit)
+      , _verbose(verbose)
+      , _orthogonalization(GMResOrthogonalization::modifiedGramSchmidt)
+    {
+      static_assert(static_cast<int>(P::category) == static_cast<int>(L::category),
+                    "P and L must be the same category!");
+      static_assert(static_cast<int>(L::category) == static_cast<int>(SolverCategory::sequential),
+                    "L must be sequential!");
+    }
+
+
+    /*!
+       \brief Set up solver.
+
+       \copydoc LoopSolver::LoopSolver(L&,P&,double,int,int)
+       \param restart number of GMRes cycles before restart
+       \param orthogonalization the orthogonalization of the Krylov basis
+     */
+    template<class L, class P>
+    RestartedGMResSolver (L& op, P& prec, real_type reduction, int restart, int maxit, int verbose,
+                          GMResOrthogonalization::Type orthogonalization = GMResOrthogonalization::modifiedGramSchmidt) :
+      _A(op,this->_phaseTimes), _W(prec,this->_phaseTimes),
+      ssp(), _sp(ssp,this->_phaseTimes), _restart(restart),
+      _reduction(reduction), _maxit(maxit), _verbose(verbose),
+      _orthogonalization(orthogonalization)
+    {
+      static_assert(static_cast<int>(P::category) == static_cast<int>(L::category),
+                    "P and L must be the same category!");
+      static_assert(static_cast<int>(L::category) == static_cast<int>(SolverCategory::sequential),
+                    "L must be sequential!");
+    }
+
+    template<class L, class S, class P>
+    DUNE_DEPRECATED_MSG("recalc_defect is a unused parameter! Use RestartedGMResSolver(L& op, S& sp, P& prec, real_type reduction, int restart, int maxit, int verbose) instead")
+    RestartedGMResSolver(L& op, S& sp, P& prec, real_type reduction, int restart, int maxit, int verbose, bool recalc_defect)
+      : _A(op,this->_phaseTimes)
+      , _W(prec,this->_phaseTimes)
+      , _sp(sp,this->_phaseTimes)
+      , _restart(restart)
+      , _reduction(reduction)
+      , _maxit(maxit)
+      , _verbose(verbose)
+      , _orthogonalization(GMResOrthogonalization::modifiedGramSchmidt)
+    {
+      static_assert(static_cast<int>(P::category) == static_cast<int>(L::category),
+                    " P and L must have the same category!");
+      static_assert(static_cast<int>(P::category) == static_cast<int>(S::category),
+                    "P and S must have the same category!");
+    }
+
+    /*!
+       \brief Set up solver.
+
+       \copydoc LoopSolver::LoopSolver(L&,S&,P&,double,int,int)
+       \param restart number of GMRes cycles before restart
+       \param orthogonalization the orthogonalization of the Krylov basis
+     */
+    template<class L, class S, class P>
+    RestartedGMResSolver (L& op, S& sp, P& prec, real_type reduction, int restart, int maxit, int verbose,
+                          GMResOrthogonalization::Type orthogonalization = GMResOrthogonalization::modifiedGramSchmidt) :
+      _A(op,this->_phaseTimes), _W(prec,this->_phaseTimes),
+      _sp(sp,this->_phaseTimes), _restart(restart),
+      _reduction(reduction), _maxit(maxit), _verbose(verbose),
+      _orthogonalization(orthogonalization)
+    {
+      static_assert(static_cast<int>(P::category) == static_cast<int>(L::category),
+                    "P and L must have the same category!");
+      static_assert(static_cast<int>(P::category) == static_cast<int>(S::category),
+                    "P and S must have the same category!");
+    }
+
+    //! \copydoc InverseOperator::apply(X&,Y&,InverseOperatorResult&)
+    virtual void apply (X& x, Y& b, InverseOperatorResult& res)
+    {
+      apply(x,b,_reduction,res);
+    }
+
+    /*!
+       \brief Apply inverse operator.
+
+       \copydoc InverseOperator::apply(X&,Y&,double,InverseOperatorResult&)
+     */
+    virtual void apply (X& x, Y& b, real_type reduction, InverseOperatorResult& res)
+    {
+      const real_type EPSILON = 1e-80;
+      const int m = _restart;
+      real_type norm, norm_old = 0.0, norm_0;
+      int j = 1;
+      std::vector<field_type> s(m+1), sn(m);
+      std::vector<real_type> cs(m);
+      // need copy of rhs if GMRes has to be restarted
+      Y b2(b);
+      // helper vector
+      Y w(b);
+      std::vector< std::vector<field_type> > H(m+1,s);
+      std::vector<F> v(m+1,b);
+
+      // start timer
+      Dune::Timer watch;
+      watch.reset();
+
+      // clear solver statistics and set res.converged to false
+      res.clear();
+      this->startObservation();
+      _W.pre(x,b);
+
+      // calculate defect and overwrite rhs with it
+      _A.applyscaleadd(-1.0,x,b); // b -= Ax
+      // calculate preconditioned defect
+      v[0] = 0.0; _W.apply(v[0],b); // r = W^-1 b
+      norm_0 = _sp.norm(v[0]);
+      norm = norm_0;
+      norm_old = norm;
+
+      // print header
+      if(_verbose > 0)
+        {
+          std::cout << "=== RestartedGMResSolver" << std::endl;
+          if(_verbose > 1) {
+            this->printHeader(std::cout);
+            this->printOutput(std::cout,real_type(0),norm_0);
+          }
+        }
+
+      if(norm_0 < EPSILON) {
+        _W.post(x);
+        res.converged = true;
+        if(_verbose > 0) // final print
+          print_result(res);
+      }
+
+      bool stopped = false; // set if the observer stops the iteration
+      while(j <= _maxit && res.converged != true && !stopped) {
+
+        int i = 0;
+        v[0] *= 1.0/norm;
+        s[0] = norm;
+        for(i=1; i<m+1; i++)
+          s[i] = 0.0;
+
+        for(i=0; i < m && j <= _maxit && res.converged != true && !stopped; i++, j++) {
+          w = 0.0;
+          // use v[i+1] as temporary vector
+          v[i+1] = 0.0;
+          // do Arnoldi algorithm
+          _A.apply(v[i],v[i+1]);
+          _W.apply(w,v[i+1]);
+          H[i+1][i] = orthogonalize(w,v,H,i);
+          if(std::abs(H[i+1][i]) < EPSILON)
+            DUNE_THROW(ISTLError,
+                       "breakdown in GMRes - |w| == 0.0 after " << j << " iterations");
+
+          // normalize new vector
+          v[i+1] = w; v[i+1] *= 1.0/H[i+1][i];
+
+          // update QR factorization
+          for(int k=0; k<i; k++)
+            applyPlaneRotation(H[k][i],H[k+1][i],cs[k],sn[k]);
+
+          // compute new givens rotation
+          generatePlaneRotation(H[i][i],H[i+1][i],cs[i],sn[i]);
+          // finish updating QR factorization
+          applyPlaneRotation(H[i][i],H[i+1][i],cs[i],sn[i]);
+          applyPlaneRotation(s[i],s[i+1],cs[i],sn[i]);
+
+          // norm of the defect is the last component the vector s
+          norm = std::abs(s[i+1]);
+
+          // print current iteration statistics
+          if(_verbose > 1) {
+            this->printOutput(std::cout,real_type(j),norm,norm_old);
+          }
+
+          norm_old = norm;
+
+          // check convergence
+          stopped = !this->observeIteration(j,norm,norm_0);
+          if(norm < reduction * norm_0)
+            res.converged = true;
+
+        } // end for
+
+        // calculate update vector
+        w = 0.0;
+        update(w,i,H,s,v);
+        // and current iterate
+        x += w;
+
+        // restart GMRes if convergence was not achieved,
+        // i.e. linear defect has not reached desired reduction
+        // and if j < _maxit
+        if( res.converged != true && !stopped && j <= _maxit ) {
+
+          if(_verbose > 0)
+            std::cout << "=== GMRes::restart" << std::endl;
+          // get saved rhs
+          b = b2;
+          // calculate new defect
+          _A.applyscaleadd(-1.0,x,b); // b -= Ax;
+          // calculate preconditioned defect
+          v[0] = 0.0;
+          _W.apply(v[0],b);
+          norm = _sp.norm(v[0]);
+          norm_old = norm;
+        }
+
+      } //end while
+
+      // postprocess preconditioner
+      _W.post(x);
+
+      // save solver statistics
+      res.iterations = j-1; // it has to be j-1!!!
+      res.reduction = static_cast<double>(norm/norm_0);
+      res.conv_rate = static_cast<double>(pow(res.reduction,1.0/(j-1)));
+      res.elapsed = watch.elapsed();
+
+      if(_verbose>0)
+        print_result(res);
+
+    }
+
+  protected :
+
+    void print_result(const InverseOperatorResult& res) const {
+      int k = res.iterations>0 ? res.iterations : 1;
+      std::cout << "=== rate=" << res.conv_rate
+                << ", T=" << res.elapsed
+                << ", TIT=" << res.elapsed/k
+                << ", IT=" << res.iterations
+                << std::endl;
+    }
+
+    void update(X& w, int i,
+                const std::vector<std::vector<field_type> >& H,
+                const std::vector<field_type>& s,
+                const std::vector<X>& v) {
+      // solution vector of the upper triangular system
+      std::vector<field_type> y(s);
+
+      // backsolve
+      for(int a=i-1; a>=0; a--) {
+        field_type rhs(s[a]);
+        for(int b=a+1; b<i; b++)
+          rhs -= H[a][b]*y[b];
+        y[a] = rhs/H[a][a];
+
+        // compute update on the fly
+        // w += y[a]*v[a]
+        w.axpy(y[a],v[a]);
+      }
+    }
+
+    template<typename T>
+    typename enable_if<is_same<field_type,real_type>::value,T>::type conjugate(const T& t) {
+      return t;
+    }
+
+    template<typename T>
+    typename enable_if<!is_same<field_type,real_type>::value,T>::type conjugate(const T& t) {
+      return conj(t);
+    }
+
+    void
+    generatePlaneRotation(field_type &dx, field_type &dy, real_type &cs, field_type &sn)
+    {
+      real_type norm_dx = std::abs(dx);
+      real_type norm_dy = std::abs(dy);
+      if(norm_dy < 1e-15) {
+        cs = 1.0;
+        sn = 0.0;
+      } else if(norm_dx < 1e-15) {
+        cs = 0.0;
+        sn = 1.0;
+      } else if(norm_dy > norm_dx) {
+        real_type temp = norm_dx/norm_dy;
+        cs = 1.0/std::sqrt(1.0 + temp*temp);
+        sn = cs;
+        cs *= temp;
+        sn *= dx/norm_dx;
+        sn *= conjugate(dy)/norm_dy;
+      } else {
+        real_type temp = norm_dy/norm_dx;
+        cs = 1.0/std::sqrt(1.0 + temp*temp);
+        sn = cs;
+        sn *= conjugate(dy/dx);
+      }
+    }
+
+
+    void
+    applyPlaneRotation(field_type &dx, field_type &dy, real_type &cs, field_type &sn)
+    {
+      field_type temp  =  cs * dx + sn * dy;
+      dy = -conjugate(sn) * dx + cs * dy;
+      dx = temp;
+    }
+
+    /**
+       \brief Orthogonalize w against v[0],...,v[i] with the chosen method.
+
+       The coefficients are stored in column i of H.
+       \return the norm of the orthogonalized vector w
+     */
+    real_type orthogonalize(Y& w, const std::vector<F>& v,
+                            std::vector<std::vector<field_type> >& H, int i)
+    {
+      if(_orthogonalization == GMResOrthogonalization::classicalGramSchmidt2)
+        return orthogonalizeCGS2(w,v,H,i);
+
+      for(int k=0; k<i+1; k++) {
+        // notice that _sp.dot(v[k],w) = v[k]\adjoint w
+        // so one has to pay attention to the order
+        // the in scalar product for the complex case
+        // doing the modified Gram-Schmidt algorithm
+        H[k][i] = _sp.dot(v[k],w);
+        // w -= H[k][i] * v[k]
+        w.axpy(-H[k][i],v[k]);
+      }
+      return _sp.norm(w);
+    }
+
+    /**
+       \brief Orthogonalize w against v[0],...,v[i] by classical
+       Gram-Schmidt with selective reorthogonalization.
+
+       The coefficients are stored in column i of H. The scalar products
+       of a pass, including the squared norm of w, are computed with a
+       single reduction and the norm of the result follows from
+       Pythagoras. A second pass is done if the norm dropped by more than
+       a factor \f$ 1/\sqrt{2} \f$.
+
+       \return the norm of the orthogonalized vector w
+     */
+    real_type orthogonalizeCGS2(Y& w, const std::vector<F>& v,
+                                std::vector<std::vector<field_type> >& H, int i)
+    {
+      std::vector<const X*> left(i+2), right(i+2,&w);
+      std::vector<const F*> basis(i+1);
+      std::vector<field_type> h, coeff(i+1);
+      for(int k=0; k<i+1; k++) {
+        left[k] = &v[k];
+        basis[k] = &v[k];
+        H[k][i] = 0.0;
+      }
+      left[i+1] = &w;
+
+      real_type norm2 = 0.0;
+      for(int pass=0; pass<2; pass++) {
+        _sp.idots(left,right,h);
+        _sp.wait();
+        real_type ww = std::real(h[i+1]);
+        norm2 = ww;
+        for(int k=0; k<i+1; k++) {
+          H[k][i] += h[k];
+          coeff[k] = -h[k];
+          norm2 -= std::norm(h[k]);
+        }
+        // w -= sum_k h[k] * v[k]
+        fusedAxpy(w,coeff,basis);
+        if(norm2 > 0.5*ww)
+          break;
+      }
+      if(!(norm2 > 0.0))
+        return _sp.norm(w);
+      return std::sqrt(norm2);
+    }
+
+    TimedLinearOperator<X,Y> _A;
+    TimedPreconditioner<X,Y> _W;
+    SeqScalarProduct<X> ssp;
+    TimedScalarProduct<X> _sp;
+    int _restart;
+    real_type _reduction;
+    int _maxit;
+    int _verbose;
+    GMResOrthogonalization::Type _orthogonalization;
+  };
+
+
+  /**
+     \brief implements the Flexible Generalized Minimal Residual (FGMRes) method
+
+     FGMRes (Y. Saad, A flexible inner-outer preconditioned GMRES
+     algorithm, 1993) is a right preconditioned GMRes that stores the
+     preconditioned vectors \f$ z_i = W^{-1} v_i \f$ and builds the update
+     from them. Therefore the preconditioner may change in every
+     iteration, e.g. AMG with an iterative coarse solver, KAMG or an
+     InverseOperator2Preconditioner with a loosely converged inner solver.
+     This costs one additional vector per iteration compared to
+     RestartedGMResSolver.
+
+     In contrast to RestartedGMResSolver the norm of the unpreconditioned
+     defect is monitored.
+
+     \tparam X trial vector, vector type of the solution
+     \tparam Y test vector, vector type of the RHS
+     \tparam F vector type for orthonormal basis of Krylov space
+   */
+  template<class X, class Y=X, class F = Y>
+  class RestartedFlexibleGMResSolver : public RestartedGMResSolver<X,Y,F>
+  {
+    typedef RestartedGMResSolver<X,Y,F> Base;
+  public:
+    //! \brief The domain type of the operator to be inverted.
+    typedef X domain_type;
+    //! \brief The range type of the operator to be inverted.
+    typedef Y range_type;
+    //! \brief The field type of the operator to be inverted
+    typedef typename X::field_type field_type;
+    //! \brief The real type of the field type (is the same if using real numbers, but differs for std::complex)
+    typedef typename FieldTraits<field_type>::real_type real_type;
+    //! \brief The field type of the basis vectors
+    typedef F basis_type;
+
+    /*!
+       \brief Set up solver.
+
+       \copydoc LoopSolver::LoopSolver(L&,P&,double,int,int)
+       \param restart number of GMRes cycles before restart
+       \param orthogonalization the orthogonalization of the Krylov basis
+     */
+    template<class L, class P>
+    RestartedFlexibleGMResSolver (L& op, P& prec, real_type reduction, int restart, int maxit, int verbose,
+                                  GMResOrthogonalization::Type orthogonalization = GMResOrthogonalization::modifiedGramSchmidt) :
+      Base(op,prec,reduction,restart,maxit,verbose,orthogonalization)
+    {}
+
+    /*!
+       \brief Set up solver.
+
+       \copydoc LoopSolver::LoopSolver(L&,S&,P&,double,int,int)
+       \param restart number of GMRes cycles before restart
+       \param orthogonalization the orthogonalization of the Krylov basis
+     */
+    template<class L, class S, class P>
+    RestartedFlexibleGMResSolver (L& op, S& sp, P& prec, real_type reduction, int restart, int maxit, int verbose,
+                                  GMResOrthogonalization::Type orthogonalization = GMResOrthogonalization::modifiedGramSchmidt) :
+      Base(op,sp,prec,reduction,restart,maxit,verbose,orthogonalization)
+    {}
+
+    //! \copydoc InverseOperator::apply(X&,Y&,InverseOperatorResult&)
+    virtual void apply (X& x, Y& b, InverseOperatorResult& res)
+    {
+      apply(x,b,this->_reduction,res);
+    }
+
+    /*!
+       \brief Apply inverse operator.
+
+       \copydoc InverseOperator::apply(X&,Y&,double,InverseOperatorResult&)
+     */
+    virtual void apply (X& x, Y& b, real_type reduction, InverseOperatorResult& res)
+    {
+      const real_type EPSILON = 1e-80;
+      const int m = this->_restart;
+      real_type norm, norm_old = 0.0, norm_0;
+      int j = 1;
+      std::vector<field_type> s(m+1), sn(m);
+      std::vector<real_type> cs(m);
+      // need copy of rhs if GMRes has to be restarted
+      Y b2(b);
+      // helper vectors
+      Y w(b);
+      X u(x);
+      std::vector< std::vector<field_type> > H(m+1,s);
+      std::vector<F> v(m+1,b);
+      // the preconditioned basis vectors
+      std::vector<X> z(m,x);
+
+      // start timer
+      Dune::Timer watch;
+      watch.reset();
+
+      // clear solver statistics and set res.converged to false
+      res.clear();
+      this->startObservation();
+      this->_W.pre(x,b);
+
+      // calculate defect and overwrite rhs with it
+      this->_A.applyscaleadd(-1.0,x,b); // b -= Ax
+      v[0] = b;
+      norm_0 = this->_sp.norm(v[0]);
+      norm = norm_0;
+      norm_old = norm;
+
+      // print header
+      if(this->_verbose > 0)
+        {
+          std::cout << "=== RestartedFlexibleGMResSolver" << std::endl;
+          if(this->_verbose > 1) {
+            this->printHeader(std::cout);
+            this->printOutput(std::cout,real_type(0),norm_0);
+          }
+        }
+
+      if(norm_0 < EPSILON)
+        res.converged = true;
+
+      bool stopped = false; // set if the observer stops the iteration
+      while(j <= this->_maxit && res.converged != true && !stopped) {
+
+        int i = 0;
+        v[0] *= 1.0/norm;
+        s[0] = norm;
+        for(i=1; i<m+1; i++)
+          s[i] = 0.0;
+
+        for(i=0; i < m && j <= this->_maxit && res.converged != true && !stopped; i++, j++) {
+          // the preconditioner may change in every iteration,
+          // so the preconditioned vectors are stored
+          z[i] = 0.0;
+          this->_W.apply(z[i],v[i]);
+          this->_A.apply(z[i],w);
+          H[i+1][i] = this->orthogonalize(w,v,H,i);
+          if(std::abs(H[i+1][i]) < EPSILON)
+            DUNE_THROW(ISTLError,
+                       "breakdown in FGMRes - |w| == 0.0 after " << j << " iterations");
+
+          // normalize new vector
+          v[i+1] = w; v[i+1] *= 1.0/H[i+1][i];
+
+          // update QR factorization
+          for(int k=0; k<i; k++)
+            this->applyPlaneRotation(H[k][i],H[k+1][i],cs[k],sn[k]);
+
+          // compute new givens rotation
+          this->generatePlaneRotation(H[i][i],H[i+1][i],cs[i],sn[i]);
+          // finish updating QR factorization
+          this->applyPlaneRotation(H[i][i],H[i+1][i],cs[i],sn[i]);
+          this->applyPlaneRotation(s[i],s[i+1],cs[i],sn[i]);
+
+          // norm of the defect is the last component the vector s
+          norm = std::abs(s[i+1]);
+
+          // print current iteration statistics
+          if(this->_verbose > 1) {
+            this->printOutput(std::cout,real_type(j),norm,norm_old);
+          }
+
+          norm_old = norm;
+
+          // check convergence
+          stopped = !this->observeIteration(j,norm,norm_0);
+          if(norm < reduction * norm_0)
+            res.converged = true;
+
+        } // end for
+
+        // calculate update from the preconditioned vectors
+        u = 0.0;
+        this->update(u,i,H,s,z);
+        // and current iterate
+        x += u;
+
+        // restart FGMRes if convergence was not achieved,
+        // i.e. linear defect has not reached desired reduction
+        // and if j < _maxit
+        if( res.converged != true && !stopped && j <= this->_maxit ) {
+
+          if(this->_verbose > 0)
+            std::cout << "=== FGMRes::restart" << std::endl;
+          // get saved rhs
+          b = b2;
+          // calculate new defect
+          this->_A.applyscaleadd(-1.0,x,b); // b -= Ax;
+          v[0] = b;
+          norm = this->_sp.norm(v[0]);
+          norm_old = norm;
+        }
+
+      } //end while
+
+      // postprocess preconditioner
+      this->_W.post(x);
+
+      // save solver statistics
+      res.iterations = j-1; // it has to be j-1!!!
+      res.reduction = static_cast<double>(norm/norm_0);
+      res.conv_rate = static_cast<double>(pow(res.reduction,1.0/(j-1)));
+      res.elapsed = watch.elapsed();
+
+      if(this->_verbose>0)
+        this->print_result(res);
+    }
+  };
+
+
+  /**
+     \brief s-step (communication avoiding) restarted GMRes.
+
+     Each restart cycle builds s vectors \f$ v_{k+1} = (WA-\theta_k)v_k \f$
+     of the preconditioned Krylov space at once and computes their Gram
+     matrix with one block reduction started with ScalarProduct::idots().
+     The basis is orthogonalized implicitly by a Cholesky QR
+     factorization of the Gram matrix, so each cycle of s iterations
+     needs a single global synchronization. The preconditioned defect
+     for the next cycle is updated from the basis without another
+     operator application.
+
+     For the Newton basis the shifts are Chebyshev points of the real
+     interval spanned by the Ritz values of the first cycle, which uses
+     the monomial basis. If the basis gets numerically rank deficient the
+     cycle is truncated.
+
+     \tparam X trial vector, vector type of the solution
+     \tparam Y test vector, vector type of the RHS
+     \tparam F vector type for the basis of the Krylov space
+   */
+  template<class X, class Y=X, class F = Y>
+  class SStepGMResSolver : public RestartedGMResSolver<X,Y,F>
+  {
+    typedef RestartedGMResSolver<X,Y,F> Base;
+  public:
+    //! \brief The domain type of the operator to be inverted.
+    typedef X domain_type;
+    //! \brief The range type of the operator to be inverted.
+    typedef Y range_type;
+    //! \brief The field type of the operator to be inverted
+    typedef typename X::field_type field_type;
+    //! \brief The real type of the field type (is the same if using real numbers, but differs for std::complex)
+    typedef typename FieldTraits<field_type>::real_type real_type;
+    //! \brief The field type of the basis vectors
+    typedef F basis_type;
+
+    /*!
+       \brief Set up solver.
+
+       \copydoc LoopSolver::LoopSolver(L&,P&,double,int,int)
+       \param s The number of Krylov vectors per cycle, i.e. the restart length.
+       \param basis The type of the Krylov basis.
+     */
+    template<class L, class P>
+    SStepGMResSolver (L& op, P& prec, real_type reduction, int s, int maxit, int verbose,
+                      SStepBasis::Type basis=SStepBasis::newton) :
+      Base(op,prec,reduction,s,maxit,verbose), _basis(basis)
+    {}
 
-      // initialize and clear correction
-      z = 0.0;
-      _prec.apply(z,b);
+    /*!
+       \brief Set up solver.
 
-      // beta is real and positive in exact arithmetic
-      // since it is the norm of the basis vectors (in unpreconditioned case)
-      beta = std::sqrt(_sp.dot(b,z));
-      field_type beta0 = beta;
+       \copydoc LoopSolver::LoopSolver(L&,S&,P&,double,int,int)
+       \param s The number of Krylov vectors per cycle, i.e. the restart length.
+       \param basis The type of the Krylov basis.
+     */
+    template<class L, class S, class P>
+    SStepGMResSolver (L& op, S& sp, P& prec, real_type reduction, int s, int maxit, int verbose,
+                      SStepBasis::Type basis=SStepBasis::newton) :
+      Base(op,sp,prec,reduction,s,maxit,verbose), _basis(basis)
+    {}
 
-      // the search directions
-      Dune::array<X,3> p{{b,b,b}};
-      p[0] = 0.0;
-      p[1] = 0.0;
-      p[2] = 0.0;
+    //! \copydoc InverseOperator::apply(X&,Y&,InverseOperatorResult&)
+    virtual void apply (X& x, Y& b, InverseOperatorResult& res)
+    {
+      apply(x,b,this->_reduction,res);
+    }
 
-      // orthonormal basis vectors (in unpreconditioned case)
-      Dune::array<X,3> q{{b,b,b}};
-      q[0] = 0.0;
-      q[1] *= 1.0/beta;
-      q[2] = 0.0;
+    /*!
+       \brief Apply inverse operator.
 
-      z *= 1.0/beta;
+       \copydoc InverseOperator::apply(X&,Y&,double,InverseOperatorResult&)
+     */
+    virtual void apply (X& x, Y& b, real_type reduction, InverseOperatorResult& res)
+    {
+      const real_type EPSILON = 1e-80;
+      const int s = this->_restart;
+      real_type norm, norm_old = 0.0, norm_0;
+      int j = 0;
+      std::vector<field_type> z(s+1), sn(s), y(s);
+      std::vector<real_type> cs(s);
+      std::vector< std::vector<field_type> > G(s+1,z), R(s+1,z), H(s+1,z);
+      std::vector<F> v(s+1,b);
+      // helper vectors
+      Y t(b);
+      F r(b);
+      X w(x);
+
+      // shifts of the Newton basis, the first cycle always uses the monomial basis
+      std::vector<real_type> shifts(s,0.0);
+      bool estimateShifts = (_basis==SStepBasis::newton);
+
+      std::vector<const X*> left, right;
+      std::vector<field_type> dots;
 
-      // the loop
-      int i = 1;
-      for( ; i<=_maxit; i++) {
+      // start timer
+      Dune::Timer watch;
+      watch.reset();
 
-        dummy = z;
-        int i1 = i%3,
-          i0 = (i1+2)%3,
-          i2 = (i1+1)%3;
+      // clear solver statistics and set res.converged to false
+      res.clear();
+      this->startObservation();
+      this->_W.pre(x,b);
 
-        // symmetrically preconditioned Lanczos algorithm (see Greenbaum p.121)
-        _op.apply(z,q[i2]); // q[i2] = Az
-        q[i2].axpy(-beta,q[i0]);
-        // alpha is real since it is the diagonal entry of the hermitian tridiagonal matrix
-        // from the Lanczos Algorithm
-        // so the order in the scalar product doesn't matter even for the complex case
-        alpha = _sp.dot(z,q[i2]);
-        q[i2].axpy(-alpha,q[i1]);
+      // calculate defect and overwrite rhs with it
+      this->_A.applyscaleadd(-1.0,x,b); // b -= Ax
+      // calculate preconditioned defect
+      v[0] = 0.0; this->_W.apply(v[0],b); // r = W^-1 b
+      norm_0 = this->_sp.norm(v[0]);
+      norm = norm_0;
+      norm_old = norm;
 
-        z = 0.0;
-        _prec.apply(z,q[i2]);
+      // print header
+      if(this->_verbose > 0)
+        {
+          std::cout << "=== SStepGMResSolver" << std::endl;
+          if(this->_verbose > 1) {
+            this->printHeader(std::cout);
+            this->printOutput(std::cout,real_type(0),norm_0);
+          }
+        }
 
-        // beta is real and positive in exact arithmetic
-        // since it is the norm of the basis vectors (in unpreconditioned case)
-        beta = std::sqrt(_sp.dot(q[i2],z));
+      if(norm_0 < EPSILON)
+        res.converged = true;
 
-        q[i2] *= 1.0/beta;
-        z *= 1.0/beta;
+      bool stopped = false; // set if the observer stops the iteration
+      while(j < this->_maxit && res.converged != true && !stopped) {
 
-        // QR Factorization of recurrence coefficient matrix
-        // apply previous givens rotations to last column of T
-        T[1] = T[2];
-        if(i>2) {
-          T[0] = s[i%2]*T[1];
-          T[1] = c[i%2]*T[1];
-        }
-        if(i>1) {
-          T[2] = c[(i+1)%2]*alpha - s[(i+1)%2]*T[1];
-          T[1] = c[(i+1)%2]*T[1] + s[(i+1)%2]*alpha;
+        // build the Krylov basis
+        const int n = std::min(s,this->_maxit-j);
+        for(int k=0; k<n; k++) {
+          this->_A.apply(v[k],t);
+          v[k+1] = 0.0;
+          this->_W.apply(v[k+1],t);
+          v[k+1].axpy(-shifts[k],v[k]);
         }
-        else
-          T[2] = alpha;
 
-        // update QR factorization
-        generateGivensRotation(T[2],beta,c[i%2],s[i%2]);
-        // to last column of T_k
-        T[2] = c[i%2]*T[2] + s[i%2]*beta;
-        // and to the rhs xi of the min problem
-        xi[i%2] = -s[i%2]*xi[(i+1)%2];
-        xi[(i+1)%2] *= c[i%2];
+        // Gram matrix of the basis with one reduction
+        left.clear(); right.clear();
+        for(int k=0; k<=n; k++)
+          for(int l=k; l<=n; l++) {
+            left.push_back(&v[k]); right.push_back(&v[l]);
+          }
+        this->_sp.idots(left,right,dots);
+        this->_sp.wait();
+        int c = 0;
+        for(int k=0; k<=n; k++)
+          for(int l=k; l<=n; l++) {
+            G[k][l] = dots[c++];
+            G[l][k] = this->conjugate(G[k][l]);
+          }
 
-        // compute correction direction
-        p[i2] = dummy;
-        p[i2].axpy(-T[1],p[i1]);
-        p[i2].axpy(-T[0],p[i0]);
-        p[i2] *= 1.0/T[2];
+        // Cholesky QR, G = R^H R, stop at the first numerically dependent vector
+        int q = 0;
+        for(; q<=n; q++) {
+          real_type d = std::real(G[q][q]);
+          for(int k=0; k<q; k++)
+            d -= std::norm(R[k][q]);
+          if(!(d > 100*std::numeric_limits<real_type>::epsilon()*std::real(G[q][q])))
+            break;
+          R[q][q] = std::sqrt(d);
+          for(int l=q+1; l<=n; l++) {
+            field_type sum = G[q][l];
+            for(int k=0; k<q; k++)
+              sum -= this->conjugate(R[k][q])*R[k][l];
+            R[q][l] = sum/R[q][q];
+          }
+        }
+        // the basis v_0,...,v_{q-1} allows q-1 steps
+        const int m = q-1;
+        if(m < 1)
+          DUNE_THROW(ISTLError,
+                     "breakdown in s-step GMRes - dependent Krylov basis after " << j << " iterations");
+
+        // least squares problem min |R(e_0 - B y)| with the upper
+        // Hessenberg matrix H = R B, where W A v_k = v_{k+1} + theta_k v_k
+        for(int k=0; k<=m; k++) {
+          z[k] = 0.0;
+          for(int l=0; l<m; l++)
+            H[k][l] = 0.0;
+        }
+        z[0] = R[0][0];
+        for(int l=0; l<m; l++)
+          for(int k=0; k<=l+1; k++)
+            H[k][l] = (k<=l ? shifts[l]*R[k][l] : field_type(0.0)) + R[k][l+1];
 
-        // apply correction/update solution
-        x.axpy(beta0*xi[(i+1)%2],p[i2]);
+        int i = 0;
+        for(; i<m; i++) {
+          // update QR factorization
+          for(int k=0; k<i; k++)
+            this->applyPlaneRotation(H[k][i],H[k+1][i],cs[k],sn[k]);
+          this->generatePlaneRotation(H[i][i],H[i+1][i],cs[i],sn[i]);
+          this->applyPlaneRotation(H[i][i],H[i+1][i],cs[i],sn[i]);
+          this->applyPlaneRotation(z[i],z[i+1],cs[i],sn[i]);
 
-        // remember beta_old
-        T[2] = beta;
+          // norm of the defect is the last component the vector z
+          norm = std::abs(z[i+1]);
+          j++;
 
-        // check for convergence
-        // the last entry in the rhs of the min-problem is the residual
-        real_type defnew = std::abs(beta0*xi[i%2]);
+          // print current iteration statistics
+          if(this->_verbose > 1)
+            this->printOutput(std::cout,real_type(j),norm,norm_old);
 
-          if(_verbose > 1)
-            this->printOutput(std::cout,real_type(i),defnew,def);
+          norm_old = norm;
 
-          def = defnew;
-          if(def < def0*_reduction || def < 1e-30 || i == _maxit ) {
+          // check convergence
+          stopped = !this->observeIteration(j,norm,norm_0);
+          if(norm < reduction * norm_0) {
             res.converged = true;
+            i++;
             break;
           }
-        } // end for
-
-        if(_verbose == 1)
-          this->printOutput(std::cout,real_type(i),def);
-
-        // postprocess preconditioner
-        _prec.post(x);
-        // fill statistics
-        res.iterations = i;
-        res.reduction = static_cast<double>(def/def0);
-        res.conv_rate = static_cast<double>(pow(res.reduction,1.0/i));
-        res.elapsed = watch.elapsed();
+          if(stopped) {
+            i++;
+            break;
+          }
+        }
 
-        // final print
-        if(_verbose > 0) {
-          std::cout << "=== rate=" << res.conv_rate
-                    << ", T=" << res.elapsed
-                    << ", TIT=" << res.elapsed/i
-                    << ", IT=" << i << std::endl;
+        // backsolve
+        for(int a=i-1; a>=0; a--) {
+          field_type rhs(z[a]);
+          for(int k=a+1; k<i; k++)
+            rhs -= H[a][k]*y[k];
+          y[a] = rhs/H[a][a];
         }
-    }
 
-    /*!
-       \brief Apply inverse operator with given reduction factor.
+        // update the iterate and the preconditioned defect
+        w = 0.0;
+        r = v[0];
+        for(int k=0; k<i; k++) {
+          w.axpy(y[k],v[k]);
+          r.axpy(-y[k],v[k+1]);
+          r.axpy(-y[k]*shifts[k],v[k]);
+        }
+        x += w;
+        v[0] = r;
+
+        if(estimateShifts && n==s) {
+          // Ritz values of the monomial basis, for which V^H W A V = G[0:s,1:s+1]
+          DynamicMatrix<real_type> Ap(s,s), Mp(s,s);
+          for(int k=0; k<s; k++)
+            for(int l=0; l<s; l++) {
+              Ap[k][l] = std::real(G[k][l+1]);
+              Mp[k][l] = std::real(G[k][l]);
+            }
+          sstepNewtonShifts(Ap,Mp,s,shifts);
+          estimateShifts = false;
+        }
+      }
 
-       \copydoc InverseOperator::apply(X&,Y&,double,InverseOperatorResult&)
-     */
-    virtual void apply (X& x, X& b, double reduction, InverseOperatorResult& res)
-    {
-      real_type saved_reduction = _reduction;
-      _reduction = reduction;
-      (*this).apply(x,b,res);
-      _reduction = saved_reduction;
-    }
+      // postprocess preconditioner
+      this->_W.post(x);
 
-  private:
+      // save solver statistics
+      res.iterations = j;
+      res.reduction = static_cast<double>(norm/norm_0);
+      res.conv_rate = static_cast<double>(pow(res.reduction,1.0/j));
+      res.elapsed = watch.elapsed();
 
-    void generateGivensRotation(field_type &dx, field_type &dy, real_type &cs, field_type &sn)
-    {
-      real_type norm_dx = std::abs(dx);
-      real_type norm_dy = std::abs(dy);
-      if(norm_dy < 1e-15) {
-        cs = 1.0;
-        sn = 0.0;
-      } else if(norm_dx < 1e-15) {
-        cs = 0.0;
-        sn = 1.0;
-      } else if(norm_dy > norm_dx) {
-        real_type temp = norm_dx/norm_dy;
-        cs = 1.0/std::sqrt(1.0 + temp*temp);
-        sn = cs;
-        cs *= temp;
-        sn *= dx/norm_dx;
-        // dy is real in exact arithmetic
-        // so we don't need to conjugate here
-        sn *= dy/norm_dy;
-      } else {
-        real_type temp = norm_dy/norm_dx;
-        cs = 1.0/std::sqrt(1.0 + temp*temp);
-        sn = cs;
-        sn *= dy/dx;
-        // dy and dx is real in exact arithmetic
-        // so we don't have to conjugate both of them
-      }
+      if(this->_verbose>0)
+        this->print_result(res);
     }
 
-    SeqScalarProduct<X> ssp;
-    LinearOperator<X,X>& _op;
-    Preconditioner<X,X>& _prec;
-    ScalarProduct<X>& _sp;
-    real_type _reduction;
-    int _maxit;
-    int _verbose;
+  private:
+    SStepBasis::Type _basis;
   };
 
-  /**
-     \brief implements the Generalized Minimal Residual (GMRes) method
 
-     GMRes solves the unsymmetric linear system Ax = b using the
-     Generalized Minimal Residual method as described the SIAM Templates
-     book (http://www.netlib.org/templates/templates.pdf).
+  /**
+     \brief GMRes with a recycled subspace for sequences of systems (GCRO-DR).
+
+     Implements the GCRO-DR method (M. Parks, E. de Sturler, G. Mackey,
+     D. Johnson, S. Maiti, Recycling Krylov subspaces for sequences of
+     linear systems, 2006). The solver keeps a recycle space U with
+     \f$ AU = C \f$, \f$ C^H C = I \f$. At the start of each cycle the
+     defect is made orthogonal to C by the correction \f$ x += UC^Hr \f$
+     and the Arnoldi process runs with the projected operator
+     \f$ (I-CC^H)AW^{-1} \f$, so the restart length includes the recycled
+     vectors. The preconditioner is applied from the right and the norm
+     of the unpreconditioned defect is monitored.
+
+     After each cycle the recycle space is replaced by the approximate
+     right singular vectors of A belonging to the smallest singular values
+     in the space spanned by U and the new search directions. They are
+     the solutions of a symmetric eigenvalue problem, which is solved
+     instead of the nonsymmetric harmonic Ritz problem of the original
+     method. The recycle space is kept by the solver object, so the next
+     call of apply() starts with it. C is recomputed at the start of
+     every solve, hence the operator may change between the solves.
+     The update of the recycle space is only done for real field types.
 
      \tparam X trial vector, vector type of the solution
      \tparam Y test vector, vector type of the RHS
      \tparam F vector type for orthonormal basis of Krylov space
-
    */
-
   template<class X, class Y=X, class F = Y>
-  class RestartedGMResSolver : public InverseOperator<X,Y>
+  class GCRODRSolver : public RestartedGMResSolver<X,Y,F>
   {
+    typedef RestartedGMResSolver<X,Y,F> Base;
   public:
     //! \brief The domain type of the operator to be inverted.
     typedef X domain_type;
@@ -1112,82 +4398,40 @@ namespace Dune {
     //! \brief The field type of the basis vectors
     typedef F basis_type;
 
-    template<class L, class P>
-    DUNE_DEPRECATED_MSG("recalc_defect is a unused parameter! Use RestartedGMResSolver(L& op, P& prec, real_type reduction, int restart, int maxit, int verbose) instead")
-    RestartedGMResSolver (L& op, P& prec, real_type reduction, int restart, int maxit, int verbose, bool recalc_defect)
-      : _A(op)
-      , _W(prec)
-      , ssp()
-      , _sp(ssp)
-      , _restart(restart)
-      , _reduction(reduction)
-      , _maxit(maxit)
-      , _verbose(verbose)
-    {
-      static_assert(static_cast<int>(P::category) == static_cast<int>(L::category),
-                    "P and L must be the same category!");
-      static_assert(static_cast<int>(L::category) == static_cast<int>(SolverCategory::sequential),
-                    "L must be sequential!");
-    }
-
-
     /*!
        \brief Set up solver.
 
        \copydoc LoopSolver::LoopSolver(L&,P&,double,int,int)
-       \param restart number of GMRes cycles before restart
+       \param restart number of GMRes cycles before restart, including the recycled vectors
+       \param recycle dimension of the recycle space, smaller than restart
+       \param orthogonalization the orthogonalization of the Krylov basis
      */
     template<class L, class P>
-    RestartedGMResSolver (L& op, P& prec, real_type reduction, int restart, int maxit, int verbose) :
-      _A(op), _W(prec),
-      ssp(), _sp(ssp), _restart(restart),
-      _reduction(reduction), _maxit(maxit), _verbose(verbose)
-    {
-      static_assert(static_cast<int>(P::category) == static_cast<int>(L::category),
-                    "P and L must be the same category!");
-      static_assert(static_cast<int>(L::category) == static_cast<int>(SolverCategory::sequential),
-                    "L must be sequential!");
-    }
-
-    template<class L, class S, class P>
-    DUNE_DEPRECATED_MSG("recalc_defect is a unused parameter! Use RestartedGMResSolver(L& op, S& sp, P& prec, real_type reduction, int restart, int maxit, int verbose) instead")
-    RestartedGMResSolver(L& op, S& sp, P& prec, real_type reduction, int restart, int maxit, int verbose, bool recalc_defect)
-      : _A(op)
-      , _W(prec)
-      , _sp(sp)
-      , _restart(restart)
-      , _reduction(reduction)
-      , _maxit(maxit)
-      , _verbose(verbose)
-    {
-      static_assert(static_cast<int>(P::category) == static_cast<int>(L::category),
-                    " P and L must have the same category!");
-      static_assert(static_cast<int>(P::category) == static_cast<int>(S::category),
-                    "P and S must have the same category!");
-    }
+    GCRODRSolver (L& op, P& prec, real_type reduction, int restart, int recycle, int maxit, int verbose,
+                  GMResOrthogonalization::Type orthogonalization = GMResOrthogonalization::modifiedGramSchmidt) :
+      Base(op,prec,reduction,restart,maxit,verbose,orthogonalization),
+      _recycle(std::max(0,std::min(recycle,restart-1)))
+    {}
 
     /*!
        \brief Set up solver.
 
        \copydoc LoopSolver::LoopSolver(L&,S&,P&,double,int,int)
-       \param restart number of GMRes cycles before restart
-     */
-    template<class L, class S, class P>
-    RestartedGMResSolver (L& op, S& sp, P& prec, real_type reduction, int restart, int maxit, int verbose) :
-      _A(op), _W(prec),
-      _sp(sp), _restart(restart),
-      _reduction(reduction), _maxit(maxit), _verbose(verbose)
-    {
-      static_assert(static_cast<int>(P::category) == static_cast<int>(L::category),
-                    "P and L must have the same category!");
-      static_assert(static_cast<int>(P::category) == static_cast<int>(S::category),
-                    "P and S must have the same category!");
-    }
+       \param restart number of GMRes cycles before restart, including the recycled vectors
+       \param recycle dimension of the recycle space, smaller than restart
+       \param orthogonalization the orthogonalization of the Krylov basis
+     */
+    template<class L, class S, class P>
+    GCRODRSolver (L& op, S& sp, P& prec, real_type reduction, int restart, int recycle, int maxit, int verbose,
+                  GMResOrthogonalization::Type orthogonalization = GMResOrthogonalization::modifiedGramSchmidt) :
+      Base(op,sp,prec,reduction,restart,maxit,verbose,orthogonalization),
+      _recycle(std::max(0,std::min(recycle,restart-1)))
+    {}
 
     //! \copydoc InverseOperator::apply(X&,Y&,InverseOperatorResult&)
     virtual void apply (X& x, Y& b, InverseOperatorResult& res)
     {
-      apply(x,b,_reduction,res);
+      apply(x,b,this->_reduction,res);
     }
 
     /*!
@@ -1198,17 +4442,27 @@ namespace Dune {
     virtual void apply (X& x, Y& b, real_type reduction, InverseOperatorResult& res)
     {
       const real_type EPSILON = 1e-80;
-      const int m = _restart;
+      const int m = this->_restart;
       real_type norm, norm_old = 0.0, norm_0;
       int j = 1;
       std::vector<field_type> s(m+1), sn(m);
       std::vector<real_type> cs(m);
       // need copy of rhs if GMRes has to be restarted
       Y b2(b);
-      // helper vector
+      // helper vectors
       Y w(b);
-      std::vector< std::vector<field_type> > H(m+1,s);
+      X u(x);
+      std::vector< std::vector<field_type> > H(m+1,s), Hbar(m+1,s);
+      // the coefficients C^H A z_i of the projection
+      std::vector< std::vector<field_type> > B(_recycle,sn);
       std::vector<F> v(m+1,b);
+      // the preconditioned basis vectors
+      std::vector<X> z(m,x);
+      // the image of the recycle space
+      std::vector<F> C;
+
+      std::vector<const X*> left, right;
+      std::vector<field_type> dots, coeff;
 
       // start timer
       Dune::Timer watch;
@@ -1216,119 +4470,175 @@ namespace Dune {
 
       // clear solver statistics and set res.converged to false
       res.clear();
-      _W.pre(x,b);
+      this->startObservation();
+      this->_W.pre(x,b);
 
       // calculate defect and overwrite rhs with it
-      _A.applyscaleadd(-1.0,x,b); // b -= Ax
-      // calculate preconditioned defect
-      v[0] = 0.0; _W.apply(v[0],b); // r = W^-1 b
-      norm_0 = _sp.norm(v[0]);
+      this->_A.applyscaleadd(-1.0,x,b); // b -= Ax
+      norm_0 = this->_sp.norm(b);
       norm = norm_0;
       norm_old = norm;
 
       // print header
-      if(_verbose > 0)
+      if(this->_verbose > 0)
         {
-          std::cout << "=== RestartedGMResSolver" << std::endl;
-          if(_verbose > 1) {
+          std::cout << "=== GCRODRSolver" << std::endl;
+          if(this->_verbose > 1) {
             this->printHeader(std::cout);
             this->printOutput(std::cout,real_type(0),norm_0);
           }
         }
 
-      if(norm_0 < EPSILON) {
-        _W.post(x);
+      if(norm_0 < EPSILON)
         res.converged = true;
-        if(_verbose > 0) // final print
-          print_result(res);
+
+      // the image of the recycle space for the current operator
+      if(res.converged != true && !_U.empty()) {
+        C.assign(_U.size(),b);
+        std::vector<const X*> pu(_U.size());
+        std::vector<F*> pc(_U.size());
+        for(std::size_t a=0; a<_U.size(); a++) {
+          pu[a] = &_U[a];
+          pc[a] = &C[a];
+        }
+        this->_A.applyMultiple(pu,pc);
+        orthonormalize(C);
       }
 
-      while(j <= _maxit && res.converged != true) {
+      bool stopped = false; // set if the observer stops the iteration
+      while(j <= this->_maxit && res.converged != true && !stopped) {
+
+        const int k = C.size();
+        if(k > 0) {
+          // remove the components of the defect in the range of C,
+          // x += U C^H b, b -= C C^H b
+          left.resize(k+1);
+          right.assign(k+1,&b);
+          for(int a=0; a<k; a++)
+            left[a] = &C[a];
+          left[k] = &b;
+          this->_sp.idots(left,right,dots);
+          this->_sp.wait();
+          real_type norm2 = std::real(dots[k]);
+          coeff.resize(k);
+          for(int a=0; a<k; a++) {
+            coeff[a] = dots[a];
+            norm2 -= std::norm(dots[a]);
+          }
+          fusedAxpy(x,coeff,pointers(_U));
+          for(int a=0; a<k; a++)
+            coeff[a] = -coeff[a];
+          fusedAxpy(b,coeff,pointers(C));
+          norm = (norm2 > 0.0) ? std::sqrt(norm2) : this->_sp.norm(b);
+          if(norm < reduction * norm_0) {
+            res.converged = true;
+            break;
+          }
+        }
 
         int i = 0;
+        v[0] = b;
         v[0] *= 1.0/norm;
         s[0] = norm;
         for(i=1; i<m+1; i++)
           s[i] = 0.0;
 
-        for(i=0; i < m && j <= _maxit && res.converged != true; i++, j++) {
-          w = 0.0;
-          // use v[i+1] as temporary vector
-          v[i+1] = 0.0;
-          // do Arnoldi algorithm
-          _A.apply(v[i],v[i+1]);
-          _W.apply(w,v[i+1]);
-          for(int k=0; k<i+1; k++) {
-            // notice that _sp.dot(v[k],w) = v[k]\adjoint w
-            // so one has to pay attention to the order
-            // the in scalar product for the complex case
-            // doing the modified Gram-Schmidt algorithm
-            H[k][i] = _sp.dot(v[k],w);
-            // w -= H[k][i] * v[k]
-            w.axpy(-H[k][i],v[k]);
+        for(i=0; i < m-k && j <= this->_maxit && res.converged != true && !stopped; i++, j++) {
+          z[i] = 0.0;
+          this->_W.apply(z[i],v[i]);
+          this->_A.apply(z[i],w);
+          if(k > 0) {
+            // w -= C C^H w
+            left.resize(k);
+            right.assign(k,&w);
+            this->_sp.idots(left,right,dots);
+            this->_sp.wait();
+            for(int a=0; a<k; a++) {
+              B[a][i] = dots[a];
+              coeff[a] = -dots[a];
+            }
+            fusedAxpy(w,coeff,pointers(C));
           }
-          H[i+1][i] = _sp.norm(w);
+          H[i+1][i] = this->orthogonalize(w,v,H,i);
           if(std::abs(H[i+1][i]) < EPSILON)
             DUNE_THROW(ISTLError,
-                       "breakdown in GMRes - |w| == 0.0 after " << j << " iterations");
+                       "breakdown in GCRODR - |w| == 0.0 after " << j << " iterations");
+          for(int l=0; l<i+2; l++)
+            Hbar[l][i] = H[l][i];
 
           // normalize new vector
           v[i+1] = w; v[i+1] *= 1.0/H[i+1][i];
 
           // update QR factorization
-          for(int k=0; k<i; k++)
-            applyPlaneRotation(H[k][i],H[k+1][i],cs[k],sn[k]);
+          for(int l=0; l<i; l++)
+            this->applyPlaneRotation(H[l][i],H[l+1][i],cs[l],sn[l]);
 
           // compute new givens rotation
-          generatePlaneRotation(H[i][i],H[i+1][i],cs[i],sn[i]);
+          this->generatePlaneRotation(H[i][i],H[i+1][i],cs[i],sn[i]);
           // finish updating QR factorization
-          applyPlaneRotation(H[i][i],H[i+1][i],cs[i],sn[i]);
-          applyPlaneRotation(s[i],s[i+1],cs[i],sn[i]);
+          this->applyPlaneRotation(H[i][i],H[i+1][i],cs[i],sn[i]);
+          this->applyPlaneRotation(s[i],s[i+1],cs[i],sn[i]);
 
           // norm of the defect is the last component the vector s
           norm = std::abs(s[i+1]);
 
           // print current iteration statistics
-          if(_verbose > 1) {
+          if(this->_verbose > 1) {
             this->printOutput(std::cout,real_type(j),norm,norm_old);
           }
 
           norm_old = norm;
 
           // check convergence
+          stopped = !this->observeIteration(j,norm,norm_0);
           if(norm < reduction * norm_0)
             res.converged = true;
 
         } // end for
 
-        // calculate update vector
-        w = 0.0;
-        update(w,i,H,s,v);
+        // solve the triangular system, the update is
+        // u = sum_a y_a z_a - sum_c U_c sum_a B_ca y_a
+        std::vector<field_type> y(i);
+        for(int a=i-1; a>=0; a--) {
+          field_type rhs(s[a]);
+          for(int l=a+1; l<i; l++)
+            rhs -= H[a][l]*y[l];
+          y[a] = rhs/H[a][a];
+        }
+        u = 0.0;
+        fusedAxpy(u,y,pointers(z,i));
+        coeff.resize(k);
+        for(int c=0; c<k; c++) {
+          coeff[c] = 0.0;
+          for(int a=0; a<i; a++)
+            coeff[c] -= B[c][a]*y[a];
+        }
+        fusedAxpy(u,coeff,pointers(_U));
         // and current iterate
-        x += w;
+        x += u;
 
-        // restart GMRes if convergence was not achieved,
+        if(i > 0)
+          updateRecycleSpace(C,z,v,B,Hbar,i);
+
+        // restart if convergence was not achieved,
         // i.e. linear defect has not reached desired reduction
         // and if j < _maxit
-        if( res.converged != true && j <= _maxit ) {
+        if( res.converged != true && !stopped && j <= this->_maxit ) {
 
-          if(_verbose > 0)
-            std::cout << "=== GMRes::restart" << std::endl;
+          if(this->_verbose > 0)
+            std::cout << "=== GCRODR::restart" << std::endl;
           // get saved rhs
           b = b2;
           // calculate new defect
-          _A.applyscaleadd(-1.0,x,b); // b -= Ax;
-          // calculate preconditioned defect
-          v[0] = 0.0;
-          _W.apply(v[0],b);
-          norm = _sp.norm(v[0]);
+          this->_A.applyscaleadd(-1.0,x,b); // b -= Ax;
+          norm = this->_sp.norm(b);
           norm_old = norm;
         }
 
       } //end while
 
       // postprocess preconditioner
-      _W.post(x);
+      this->_W.post(x);
 
       // save solver statistics
       res.iterations = j-1; // it has to be j-1!!!
@@ -1336,95 +4646,175 @@ namespace Dune {
       res.conv_rate = static_cast<double>(pow(res.reduction,1.0/(j-1)));
       res.elapsed = watch.elapsed();
 
-      if(_verbose>0)
-        print_result(res);
-
+      if(this->_verbose>0)
+        this->print_result(res);
     }
 
-  private :
-
-    void print_result(const InverseOperatorResult& res) const {
-      int k = res.iterations>0 ? res.iterations : 1;
-      std::cout << "=== rate=" << res.conv_rate
-                << ", T=" << res.elapsed
-                << ", TIT=" << res.elapsed/k
-                << ", IT=" << res.iterations
-                << std::endl;
+    //! \brief The current recycle space.
+    const std::vector<X>& recycleSpace () const
+    {
+      return _U;
     }
 
-    void update(X& w, int i,
-                const std::vector<std::vector<field_type> >& H,
-                const std::vector<field_type>& s,
-                const std::vector<X>& v) {
-      // solution vector of the upper triangular system
-      std::vector<field_type> y(s);
-
-      // backsolve
-      for(int a=i-1; a>=0; a--) {
-        field_type rhs(s[a]);
-        for(int b=a+1; b<i; b++)
-          rhs -= H[a][b]*y[b];
-        y[a] = rhs/H[a][a];
-
-        // compute update on the fly
-        // w += y[a]*v[a]
-        w.axpy(y[a],v[a]);
-      }
+    //! \brief Forget the recycle space, e.g. if the next system is unrelated to the previous ones.
+    void clearRecycleSpace ()
+    {
+      _U.clear();
     }
 
-    template<typename T>
-    typename enable_if<is_same<field_type,real_type>::value,T>::type conjugate(const T& t) {
-      return t;
+  private:
+    template<class V>
+    static std::vector<const V*> pointers (const std::vector<V>& v, std::size_t n)
+    {
+      std::vector<const V*> p(n);
+      for(std::size_t a=0; a<n; a++)
+        p[a] = &v[a];
+      return p;
     }
 
-    template<typename T>
-    typename enable_if<!is_same<field_type,real_type>::value,T>::type conjugate(const T& t) {
-      return conj(t);
+    template<class V>
+    static std::vector<const V*> pointers (const std::vector<V>& v)
+    {
+      return pointers(v,v.size());
     }
 
-    void
-    generatePlaneRotation(field_type &dx, field_type &dy, real_type &cs, field_type &sn)
+    /* Orthonormalize C by a Cholesky decomposition of its Gram matrix
+       and apply the same transformation to U, so AU = C still holds.
+       Numerically linearly dependent vectors are dropped. */
+    void orthonormalize (std::vector<F>& C)
     {
-      real_type norm_dx = std::abs(dx);
-      real_type norm_dy = std::abs(dy);
-      if(norm_dy < 1e-15) {
-        cs = 1.0;
-        sn = 0.0;
-      } else if(norm_dx < 1e-15) {
-        cs = 0.0;
-        sn = 1.0;
-      } else if(norm_dy > norm_dx) {
-        real_type temp = norm_dx/norm_dy;
-        cs = 1.0/std::sqrt(1.0 + temp*temp);
-        sn = cs;
-        cs *= temp;
-        sn *= dx/norm_dx;
-        sn *= conjugate(dy)/norm_dy;
-      } else {
-        real_type temp = norm_dy/norm_dx;
-        cs = 1.0/std::sqrt(1.0 + temp*temp);
-        sn = cs;
-        sn *= conjugate(dy/dx);
+      const std::size_t n = C.size();
+      std::vector<const X*> left, right;
+      std::vector<field_type> dots;
+      for(std::size_t a=0; a<n; a++)
+        for(std::size_t c=a; c<n; c++) {
+          left.push_back(&C[a]); right.push_back(&C[c]);
+        }
+      this->_sp.idots(left,right,dots);
+      this->_sp.wait();
+      DynamicMatrix<field_type> G(n,n), R(n,n,field_type(0));
+      for(std::size_t a=0, l=0; a<n; a++)
+        for(std::size_t c=a; c<n; c++)
+          G[a][c] = dots[l++];
+
+      const real_type tolerance = std::sqrt(std::numeric_limits<real_type>::epsilon());
+      std::vector<std::size_t> kept;
+      std::vector<field_type> coeff;
+      for(std::size_t c=0; c<n; c++) {
+        for(std::size_t a=0; a<kept.size(); a++) {
+          field_type sum = G[kept[a]][c];
+          for(std::size_t t=0; t<a; t++)
+            sum -= this->conjugate(R[kept[t]][kept[a]])*R[kept[t]][c];
+          R[kept[a]][c] = sum/R[kept[a]][kept[a]];
+        }
+        real_type d = std::real(G[c][c]);
+        for(std::size_t a=0; a<kept.size(); a++)
+          d -= std::norm(R[kept[a]][c]);
+        if(d <= tolerance*std::real(G[c][c]) || !(d > 0.0))
+          continue;
+        R[c][c] = std::sqrt(d);
+
+        const std::size_t slot = kept.size();
+        coeff.resize(slot);
+        for(std::size_t a=0; a<slot; a++)
+          coeff[a] = -R[kept[a]][c];
+        if(slot != c) {
+          C[slot] = C[c];
+          _U[slot] = _U[c];
+        }
+        fusedAxpy(C[slot],coeff,pointers(C,slot));
+        fusedAxpy(_U[slot],coeff,pointers(_U,slot));
+        C[slot] *= 1.0/R[c][c];
+        _U[slot] *= 1.0/R[c][c];
+        kept.push_back(c);
       }
+      C.resize(kept.size(),C[0]);
+      _U.resize(kept.size(),_U[0]);
     }
 
-
-    void
-    applyPlaneRotation(field_type &dx, field_type &dy, real_type &cs, field_type &sn)
+    /* Replace U by the approximate right singular vectors of the
+       smallest singular values of A in the span of [U,z_0,...,z_{i-1}]
+       and C by their images, where A [U,z] = [C,v] G with
+       G = [I B; 0 Hbar]. */
+    void updateRecycleSpace (std::vector<F>& C, const std::vector<X>& z, const std::vector<F>& v,
+                             const std::vector< std::vector<field_type> >& B,
+                             const std::vector< std::vector<field_type> >& Hbar, int i)
     {
-      field_type temp  =  cs * dx + sn * dy;
-      dy = -conjugate(sn) * dx + cs * dy;
-      dx = temp;
+      if(!is_same<field_type,real_type>::value || _recycle == 0)
+        return;
+
+      const int k = C.size();
+      const int n = k+i;
+
+      DynamicMatrix<real_type> G(n+1,n,0.0);
+      for(int a=0; a<k; a++) {
+        G[a][a] = 1.0;
+        for(int c=0; c<i; c++)
+          G[a][k+c] = std::real(B[a][c]);
+      }
+      for(int c=0; c<i; c++)
+        for(int l=0; l<c+2; l++)
+          G[k+l][k+c] = std::real(Hbar[l][c]);
+
+      // the normal equations G^T G and the Gram matrix of [U,z]
+      std::vector<const X*> Vhat(pointers(_U)), What(pointers(C));
+      for(int c=0; c<i; c++)
+        Vhat.push_back(&z[c]);
+      for(int c=0; c<i+1; c++)
+        What.push_back(&v[c]);
+      std::vector<const X*> left, right;
+      std::vector<field_type> dots;
+      for(int a=0; a<n; a++)
+        for(int c=a; c<n; c++) {
+          left.push_back(Vhat[a]); right.push_back(Vhat[c]);
+        }
+      this->_sp.idots(left,right,dots);
+      this->_sp.wait();
+      DynamicMatrix<real_type> N(n,n,0.0), M(n,n);
+      for(int a=0, l=0; a<n; a++)
+        for(int c=a; c<n; c++) {
+          M[a][c] = M[c][a] = std::real(dots[l++]);
+          for(int q=0; q<n+1; q++)
+            N[a][c] += G[q][a]*G[q][c];
+          N[c][a] = N[a][c];
+        }
+
+      std::vector<real_type> values;
+      DynamicMatrix<real_type> vectors;
+      if(!symmetricEigenpairs(N,M,values,vectors))
+        return;               // the basis is degenerated, keep the old space
+
+      // U = [U,z] c / sigma and C = [C,v] G c / sigma, then C^H C = I
+      const int r = std::min(n,_recycle);
+      std::vector<X> U(r,*Vhat[0]);
+      std::vector<F> Cnew(r,*What[0]);
+      std::vector<field_type> cu(n), cc(n+1);
+      int kept = 0;
+      for(int l=0; l<r; l++) {
+        if(!(values[l] > 0.0))
+          continue;
+        const real_type sigma = std::sqrt(values[l]);
+        for(int a=0; a<n; a++)
+          cu[a] = vectors[a][l]/sigma;
+        for(int q=0; q<n+1; q++) {
+          cc[q] = 0.0;
+          for(int a=0; a<n; a++)
+            cc[q] += G[q][a]*cu[a];
+        }
+        U[kept] = 0.0;
+        Cnew[kept] = 0.0;
+        fusedAxpy(U[kept],cu,Vhat);
+        fusedAxpy(Cnew[kept],cc,What);
+        kept++;
+      }
+      U.resize(kept,*Vhat[0]);
+      Cnew.resize(kept,*What[0]);
+      _U.swap(U);
+      C.swap(Cnew);
     }
 
-    LinearOperator<X,Y>& _A;
-    Preconditioner<X,Y>& _W;
-    SeqScalarProduct<X> ssp;
-    ScalarProduct<X>& _sp;
-    int _restart;
-    real_type _reduction;
-    int _maxit;
-    int _verbose;
+    int _recycle;
+    std::vector<X> _U;
   };
 
 
@@ -1464,7 +4854,7 @@ namespace Dune {
     template<class L, class P>
     GeneralizedPCGSolver (L& op, P& prec, real_type reduction, int maxit, int verbose,
                           int restart=10) :
-      ssp(), _op(op), _prec(prec), _sp(ssp), _reduction(reduction), _maxit(maxit),
+      ssp(), _op(op,this->_phaseTimes), _prec(prec,this->_phaseTimes), _sp(ssp,this->_phaseTimes), _reduction(reduction), _maxit(maxit),
       _verbose(verbose), _restart(std::min(maxit,restart))
     {
       static_assert(static_cast<int>(L::category) == static_cast<int>(P::category),
@@ -1483,7 +4873,7 @@ namespace Dune {
     template<class L, class P, class S>
     GeneralizedPCGSolver (L& op, S& sp, P& prec,
                           real_type reduction, int maxit, int verbose, int restart=10) :
-      _op(op), _prec(prec), _sp(sp), _reduction(reduction), _maxit(maxit), _verbose(verbose),
+      _op(op,this->_phaseTimes), _prec(prec,this->_phaseTimes), _sp(sp,this->_phaseTimes), _reduction(reduction), _maxit(maxit), _verbose(verbose),
       _restart(std::min(maxit,restart))
     {
       static_assert(static_cast<int>(L::category) == static_cast<int>(P::category),
@@ -1499,6 +4889,7 @@ namespace Dune {
     virtual void apply (X& x, X& b, InverseOperatorResult& res)
     {
       res.clear();                      // clear solver statistics
+      this->startObservation();
       Timer watch;                    // start a timer
       _prec.pre(x,b);                 // prepare preconditioner
       _op.applyscaleadd(-1,x,b);      // overwrite b with defect
@@ -1507,6 +4898,8 @@ namespace Dune {
       std::vector<typename X::field_type> pp(_restart);
       X q(x);                  // a temporary vector
       X prec_res(x);           // a temporary vector for preconditioner output
+      std::vector<const X*> left, right;
+      std::vector<field_type> dots;
 
       p[0].reset(new X(x));
 
@@ -1551,9 +4944,11 @@ namespace Dune {
 
       // convergence test
       real_type defnew=_sp.norm(b);    // comp defect norm
+      ++i;
       if (_verbose>1)                 // print
-        this->printOutput(std::cout,real_type(++i),defnew,def);
+        this->printOutput(std::cout,real_type(i),defnew,def);
       def = defnew;                   // update norm
+      bool stopped = !this->observeIteration(i,def,def0);
       if (def<def0*_reduction || def<1E-30)        // convergence check
       {
         res.converged  = true;
@@ -1567,7 +4962,7 @@ namespace Dune {
         return;
       }
 
-      while(i<_maxit) {
+      while(i<_maxit && !stopped) {
         // the loop
         int end=std::min(_restart, _maxit-i+1);
         for (ii=1; ii<end; ++ii )
@@ -1580,33 +4975,51 @@ namespace Dune {
           p[ii].reset(new X(prec_res));
           _op.apply(prec_res, q);
 
+          // A-orthogonalize against all previous directions,
+          // the products are independent and use one reduction
+          left.assign(ii,&q);
+          right.resize(ii);
+          for(int j=0; j<ii; ++j)
+            right[j] = p[j].get();
+          _sp.idots(left,right,dots);
+          _sp.wait();
           for(int j=0; j<ii; ++j) {
-            rho =_sp.dot(q,*(p[j]))/pp[j];
+            rho = dots[j]/pp[j];
             p[ii]->axpy(-rho, *(p[j]));
           }
 
           // minimize in given search direction
           _op.apply(*(p[ii]),q);                     // q=Ap
-          pp[ii] = _sp.dot(*(p[ii]),q);               // scalar product
-          rho = _sp.dot(*(p[ii]),b);                 // orthogonalization
+          left.assign(2,p[ii].get());
+          right.resize(2);
+          right[0] = &q;
+          right[1] = &b;
+          _sp.idots(left,right,dots);                // scalar product and
+          _sp.wait();                                // orthogonalization
+          pp[ii] = dots[0];
+          rho = dots[1];
           lambda = rho/pp[ii];             // minimization
           x.axpy(lambda,*(p[ii]));                   // update solution
           b.axpy(-lambda,q);                  // update defect
 
           // convergence test
           real_type defnew=_sp.norm(b);        // comp defect norm
+          ++i;
 
           if (_verbose>1)                     // print
-            this->printOutput(std::cout,real_type(++i),defnew,def);
+            this->printOutput(std::cout,real_type(i),defnew,def);
 
           def = defnew;                       // update norm
+          stopped = !this->observeIteration(i,def,def0);
           if (def<def0*_reduction || def<1E-30)            // convergence check
           {
             res.converged  = true;
             break;
           }
+          if (stopped)                        // stopped by the observer
+            break;
         }
-        if(res.converged)
+        if(res.converged || stopped)
           break;
         if(end==_restart) {
           *(p[0])=*(p[_restart-1]);
@@ -1647,15 +5060,206 @@ namespace Dune {
     }
   private:
     SeqScalarProduct<X> ssp;
-    LinearOperator<X,X>& _op;
-    Preconditioner<X,X>& _prec;
-    ScalarProduct<X>& _sp;
+    TimedLinearOperator<X,X> _op;
+    TimedPreconditioner<X,X> _prec;
+    TimedScalarProduct<X> _sp;
     real_type _reduction;
     int _maxit;
     int _verbose;
     int _restart;
   };
 
+  /**
+     \brief Mixed precision iterative refinement.
+
+     The corrections are computed by an inner solver that works with
+     vectors of lower precision, e.g. a CGSolver with an ILU or AMG
+     preconditioner for a single precision copy of the matrix. The
+     defects are computed with the operator in the precision of X, so the
+     achievable accuracy is that of X as long as the inner solver reduces
+     the defect in each step. The defect is scaled to unit norm before it
+     is converted to avoid underflow in the low precision.
+
+     A single precision inner solver for a double precision matrix A can
+     be set up like this:
+
+     \code
+     typedef BCRSMatrix<FieldMatrix<float,1,1> > MatrixF;
+     typedef BlockVector<FieldVector<float,1> > VectorF;
+     MatrixF Af;
+     convertMatrix(Af,A);
+     MatrixAdapter<MatrixF,VectorF,VectorF> opf(Af);
+     SeqILU0<MatrixF,VectorF,VectorF> precf(Af,1.0);
+     CGSolver<VectorF> inner(opf,precf,1e-2,100,0);
+     IterativeRefinementSolver<Vector,VectorF> solver(op,inner,1e-10,20,1);
+     \endcode
+
+     \tparam X The vector type of the operator.
+     \tparam XL The vector type of the inner solver.
+   */
+  template<class X, class XL>
+  class IterativeRefinementSolver : public InverseOperator<X,X>
+  {
+  public:
+    //! \brief The domain type of the operator to be inverted.
+    typedef X domain_type;
+    //! \brief The range type of the operator to be inverted.
+    typedef X range_type;
+    //! \brief The field type of the operator to be inverted.
+    typedef typename X::field_type field_type;
+    //! \brief The real type of the field type (is the same if using real numbers, but differs for std::complex)
+    typedef typename FieldTraits<field_type>::real_type real_type;
+
+    /*!
+       \brief Set up iterative refinement.
+
+       \param op The operator we solve, it is used to compute the defects.
+       \param inner The solver for the corrections in low precision.
+       Its own reduction and iteration limit are used in each step.
+       \param reduction The relative defect reduction to achieve when applying
+       the operator.
+       \param maxit The maximum number of refinement steps.
+       \param verbose The verbosity level.
+     */
+    template<class L>
+    IterativeRefinementSolver (L& op, InverseOperator<XL,XL>& inner,
+                               real_type reduction, int maxit, int verbose) :
+      ssp(), _op(op,this->_phaseTimes), _sp(ssp,this->_phaseTimes), _inner(inner),
+      _reduction(reduction), _maxit(maxit), _verbose(verbose)
+    {
+      static_assert(static_cast<int>(L::category) ==
+                    static_cast<int>(SolverCategory::sequential),
+                    "L has to be sequential!");
+    }
+
+    /*!
+       \brief Set up iterative refinement.
+
+       \param op The operator we solve, it is used to compute the defects.
+       \param sp The scalar product to use, e. g. SeqScalarproduct.
+       \param inner The solver for the corrections in low precision.
+       Its own reduction and iteration limit are used in each step.
+       \param reduction The relative defect reduction to achieve when applying
+       the operator.
+       \param maxit The maximum number of refinement steps.
+       \param verbose The verbosity level.
+     */
+    template<class L, class S>
+    IterativeRefinementSolver (L& op, S& sp, InverseOperator<XL,XL>& inner,
+                               real_type reduction, int maxit, int verbose) :
+      _op(op,this->_phaseTimes), _sp(sp,this->_phaseTimes), _inner(inner),
+      _reduction(reduction), _maxit(maxit), _verbose(verbose)
+    {
+      static_assert(static_cast<int>(L::category) == static_cast<int>(S::category),
+                    "L and S must have the same category!");
+    }
+
+    //! \copydoc InverseOperator::apply(X&,Y&,InverseOperatorResult&)
+    virtual void apply (X& x, X& b, InverseOperatorResult& res)
+    {
+      res.clear();
+      this->startObservation();
+      Timer watch;
+
+      _op.applyscaleadd(-1,x,b);      // overwrite b with defect
+      real_type def0 = _sp.norm(b);
+      if (def0<1E-30)                 // convergence check
+      {
+        res.converged  = true;
+        res.elapsed = watch.elapsed();
+        if (_verbose>0)
+          std::cout << "=== IterativeRefinementSolver: initial defect is zero" << std::endl;
+        return;
+      }
+
+      if (_verbose>0)
+      {
+        std::cout << "=== IterativeRefinementSolver" << std::endl;
+        if (_verbose>1)
+        {
+          this->printHeader(std::cout);
+          this->printOutput(std::cout,real_type(0),def0);
+        }
+      }
+
+      X v(x);                         // correction in high precision
+      XL dl, vl;                      // defect and correction in low precision
+      InverseOperatorResult innerRes;
+
+      int i=1; real_type def=def0;
+      for ( ; i<=_maxit; i++ )
+      {
+        // scaled defect in low precision
+        v = b;
+        v *= 1.0/def;
+        convertVector(dl,v);
+        vl = dl;
+        vl = 0;
+
+        // solve for the correction
+        Timer innerWatch;
+        _inner.apply(vl,dl,innerRes);
+        if (this->_phaseTimes.enabled)
+          this->_phaseTimes.preconditionerTime += innerWatch.elapsed();
+        convertVector(v,vl);
+        v *= def;
+
+        x += v;                       // update solution
+        _op.applyscaleadd(-1,v,b);    // update defect
+        real_type defnew=_sp.norm(b);
+        if (_verbose>1)
+          this->printOutput(std::cout,real_type(i),defnew,def);
+        def = defnew;
+        bool proceed = this->observeIteration(i,def,def0);
+        if (def<def0*_reduction || def<1E-30)    // convergence check
+        {
+          res.converged  = true;
+          break;
+        }
+        if (!proceed)                 // stopped by the observer
+          break;
+      }
+
+      //correct i which is wrong if convergence was not achieved.
+      i=std::min(_maxit,i);
+
+      if (_verbose==1)
+        this->printOutput(std::cout,real_type(i),def);
+
+      // fill statistics
+      res.iterations = i;
+      res.reduction = def/def0;
+      res.conv_rate  = pow(res.reduction,1.0/i);
+      res.elapsed = watch.elapsed();
+
+      if (_verbose>0)
+      {
+        std::cout << "=== rate=" << res.conv_rate
+                  << ", T=" << res.elapsed
+                  << ", TIT=" << res.elapsed/i
+                  << ", IT=" << i << std::endl;
+      }
+    }
+
+    //! \copydoc InverseOperator::apply(X&,Y&,double,InverseOperatorResult&)
+    virtual void apply (X& x, X& b, double reduction, InverseOperatorResult& res)
+    {
+      real_type saved_reduction = _reduction;
+      _reduction = reduction;
+      (*this).apply(x,b,res);
+      _reduction = saved_reduction;
+    }
+
+  private:
+    SeqScalarProduct<X> ssp;
+    TimedLinearOperator<X,X> _op;
+    TimedScalarProduct<X> _sp;
+    InverseOperator<XL,XL>& _inner;
+    real_type _reduction;
+    int _maxit;
+    int _verbose;
+  };
+
   /** @} end documentation */
 
 } // end namespace
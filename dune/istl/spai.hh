@@ -0,0 +1,349 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+#ifndef DUNE_ISTL_SPAI_HH
+#define DUNE_ISTL_SPAI_HH
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <vector>
+
+#include <dune/common/dynmatrix.hh>
+#include <dune/common/fmatrix.hh>
+#include "istlexception.hh"
+
+/** \file
+ * \brief Sparse approximate inverses of BCRSMatrix.
+ *
+ * The sparsity pattern of the approximate inverses is taken from a
+ * power of the sparsity pattern of the matrix. Each row of the
+ * approximate inverse is computed independently from the others by
+ * solving a small dense problem. If the code is compiled with OpenMP
+ * support these problems are distributed over the threads.
+ */
+
+namespace Dune {
+
+  /** @addtogroup ISTL_Kernel
+          @{
+   */
+
+  /**
+   * @brief Compute the sparsity pattern of \f$ A^{level} \f$.
+   *
+   * Row i of the pattern contains all column indices that can be reached
+   * from i by at most level edges of the matrix graph. The indices in
+   * each row are sorted.
+   * @param A The matrix.
+   * @param level The power of the matrix pattern (at least one).
+   * @param pattern The vector to store the row patterns in.
+   * @param lower If true only the lower triangle (including the diagonal)
+   * is stored.
+   */
+  template<class M>
+  void matrix_power_pattern (const M& A, int level,
+                             std::vector<std::vector<typename M::size_type> >& pattern,
+                             bool lower=false)
+  {
+    typedef typename M::ConstColIterator ccoliterator;
+    typedef typename M::size_type size_type;
+    typedef typename std::vector<size_type>::const_iterator iterator;
+
+    pattern.resize(A.N());
+    const long rows = A.N();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic,64)
+#endif
+    for (long r=0; r<rows; ++r)
+    {
+      const size_type i = r;
+      // row and front are kept sorted, front holds the indices first
+      // reached in the previous step
+      std::vector<size_type> row(1,i), front(1,i), reached, next, merged;
+      for (int k=0; k<level && !front.empty(); ++k)
+      {
+        reached.clear();
+        for (iterator j=front.begin(); j!=front.end(); ++j)
+          for (ccoliterator jk=A[*j].begin(); jk!=A[*j].end(); ++jk)
+            reached.push_back(jk.index());
+        std::sort(reached.begin(),reached.end());
+        reached.erase(std::unique(reached.begin(),reached.end()),reached.end());
+        next.clear();
+        std::set_difference(reached.begin(),reached.end(),row.begin(),row.end(),
+                            std::back_inserter(next));
+        merged.clear();
+        std::merge(row.begin(),row.end(),next.begin(),next.end(),
+                   std::back_inserter(merged));
+        row.swap(merged);
+        front.swap(next);
+      }
+      if (lower)
+        row.erase(std::upper_bound(row.begin(),row.end(),i),row.end());
+      pattern[i].swap(row);
+    }
+  }
+
+  //! create the row wise sparsity pattern of B from pattern
+  template<class M>
+  void matrix_pattern_create (M& B, const std::vector<std::vector<typename M::size_type> >& pattern)
+  {
+    typedef typename M::CreateIterator createiterator;
+    typedef typename M::size_type size_type;
+
+    createiterator ci=B.createbegin();
+    for (size_type i=0; i<pattern.size(); ++i, ++ci)
+      for (size_type j=0; j<pattern[i].size(); ++j)
+        ci.insert(pattern[i][j]);
+  }
+
+  /**
+   * @brief Store the transpose of A in T.
+   *
+   * T should be an empty matrix in row_wise creation mode with the
+   * transposed dimensions of A. Only square blocks are supported.
+   */
+  template<class M>
+  void matrix_transpose (const M& A, M& T)
+  {
+    typedef typename M::ConstRowIterator crowiterator;
+    typedef typename M::ConstColIterator ccoliterator;
+    typedef typename M::size_type size_type;
+    typedef typename M::block_type block;
+    const int n = block::rows;
+
+    // visiting the rows in order keeps the transposed rows sorted
+    std::vector<std::vector<size_type> > pattern(A.M());
+    for (crowiterator i=A.begin(); i!=A.end(); ++i)
+      for (ccoliterator j=i->begin(); j!=i->end(); ++j)
+        pattern[j.index()].push_back(i.index());
+    matrix_pattern_create(T,pattern);
+
+    for (crowiterator i=A.begin(); i!=A.end(); ++i)
+      for (ccoliterator j=i->begin(); j!=i->end(); ++j)
+      {
+        block& t = T[j.index()][i.index()];
+        for (int s=0; s<n; ++s)
+          for (int r=0; r<n; ++r)
+            t[s][r] = (*j)[r][s];
+      }
+  }
+
+  /**
+   * @brief Factorized sparse approximate inverse (FSAI) of a symmetric
+   * positive definite matrix.
+   *
+   * Computes a lower triangular matrix G with the pattern of the lower
+   * triangle of \f$ A^{level} \f$ such that \f$ G^T G \approx A^{-1} \f$
+   * and \f$ G A G^T \f$ has identity blocks on its diagonal.
+   * The matrix G should be an empty matrix in row_wise creation mode.
+   */
+  template<class M>
+  void fsai_decomposition (const M& A, int level, M& G)
+  {
+    typedef typename M::size_type size_type;
+    typedef typename M::ConstColIterator ccoliterator;
+    typedef typename M::ColIterator coliterator;
+    typedef typename M::block_type block;
+    typedef typename M::field_type K;
+    const int n = block::rows;
+
+    std::vector<std::vector<size_type> > pattern;
+    matrix_power_pattern(A,level,pattern,true);
+    matrix_pattern_create(G,pattern);
+
+    bool failed = false;
+    long failedRow = 0;
+    const long rows = A.N();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic,64)
+#endif
+    for (long r=0; r<rows; ++r)
+    {
+      const size_type i = r;
+      const std::vector<size_type>& P = pattern[i];
+      const size_type p = P.size();
+
+      // gather the dense submatrix A(P,P)
+      DynamicMatrix<K> S(p*n, p*n, K(0));
+      for (size_type a=0; a<p; ++a)
+      {
+        size_type b=0;
+        ccoliterator endj=A[P[a]].end();
+        for (ccoliterator j=A[P[a]].begin(); j!=endj && b<p; )
+          if (j.index()==P[b])
+          {
+            for (int s=0; s<n; ++s)
+              for (int t=0; t<n; ++t)
+                S[a*n+s][b*n+t] = (*j)[s][t];
+            ++j; ++b;
+          }
+          else
+          {
+            if (j.index()<P[b])
+              ++j;
+            else
+              ++b;
+          }
+      }
+
+      // the last block column of A(P,P)^-1, i.e. the solution of
+      // A(P,P) Y = E_i, the diagonal index i is the last one in P.
+      FieldMatrix<K,n,n> L(K(0));
+      try {
+        S.invert();
+        // Cholesky decomposition Y_ii = L L^T
+        for (int s=0; s<n; ++s)
+          for (int t=0; t<=s; ++t)
+          {
+            K sum = S[(p-1)*n+s][(p-1)*n+t];
+            for (int k=0; k<t; ++k)
+              sum -= L[s][k]*L[t][k];
+            if (s==t)
+            {
+              if (sum<=0)
+                DUNE_THROW(FMatrixError,"matrix is not positive definite");
+              L[s][s] = std::sqrt(sum);
+            }
+            else
+              L[s][t] = sum/L[t][t];
+          }
+      }
+      catch (Dune::FMatrixError&) {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+        {
+          failed = true;
+          failedRow = r;
+        }
+        continue;
+      }
+
+      // G_ij = L^-1 Y_j^T
+      size_type a=0;
+      coliterator endj=G[i].end();
+      for (coliterator j=G[i].begin(); j!=endj; ++j, ++a)
+        for (int t=0; t<n; ++t)
+          for (int s=0; s<n; ++s)
+          {
+            K sum = S[a*n+t][(p-1)*n+s];
+            for (int k=0; k<s; ++k)
+              sum -= L[s][k]*(*j)[k][t];
+            (*j)[s][t] = sum/L[s][s];
+          }
+    }
+    if (failed)
+      DUNE_THROW(ISTLError,"FSAI failed in row " << failedRow
+                 << ", the matrix has to be symmetric positive definite");
+  }
+
+  /**
+   * @brief Sparse approximate inverse (SPAI) of a general matrix.
+   *
+   * Computes an approximate inverse MI with the pattern of \f$ A^{level} \f$
+   * that minimizes the Frobenius norm \f$ \|MI\,A-I\|_F \f$. Each row is
+   * computed independently by solving the normal equations of its least
+   * squares problem.
+   * The matrix MI should be an empty matrix in row_wise creation mode.
+   */
+  template<class M>
+  void spai_decomposition (const M& A, int level, M& MI)
+  {
+    typedef typename M::size_type size_type;
+    typedef typename M::ConstColIterator ccoliterator;
+    typedef typename M::ColIterator coliterator;
+    typedef typename M::block_type block;
+    typedef typename M::field_type K;
+    const int n = block::rows;
+
+    std::vector<std::vector<size_type> > pattern;
+    matrix_power_pattern(A,level,pattern);
+    matrix_pattern_create(MI,pattern);
+
+    bool failed = false;
+    long failedRow = 0;
+    const long rows = A.N();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic,64)
+#endif
+    for (long r=0; r<rows; ++r)
+    {
+      const size_type i = r;
+      const std::vector<size_type>& J = pattern[i];
+      const size_type p = J.size();
+
+      // normal equations N = A(J,:) A(J,:)^T and rhs A(J,i)
+      DynamicMatrix<K> N(p*n, p*n, K(0));
+      DynamicMatrix<K> R(p*n, n, K(0));
+      for (size_type a=0; a<p; ++a)
+      {
+        ccoliterator enda=A[J[a]].end();
+        ccoliterator ai=A[J[a]].find(i);
+        if (ai!=enda)
+          for (int s=0; s<n; ++s)
+            for (int t=0; t<n; ++t)
+              R[a*n+s][t] = (*ai)[s][t];
+
+        for (size_type b=a; b<p; ++b)
+        {
+          ccoliterator endb=A[J[b]].end();
+          ccoliterator ja=A[J[a]].begin(), jb=A[J[b]].begin();
+          while (ja!=enda && jb!=endb)
+            if (ja.index()==jb.index())
+            {
+              for (int s=0; s<n; ++s)
+                for (int t=0; t<n; ++t)
+                  for (int k=0; k<n; ++k)
+                    N[a*n+s][b*n+t] += (*ja)[s][k]*(*jb)[t][k];
+              ++ja; ++jb;
+            }
+            else
+            {
+              if (ja.index()<jb.index())
+                ++ja;
+              else
+                ++jb;
+            }
+          for (int s=0; s<n; ++s)
+            for (int t=0; t<n; ++t)
+              N[b*n+t][a*n+s] = N[a*n+s][b*n+t];
+        }
+      }
+
+      try {
+        N.invert();
+      }
+      catch (Dune::FMatrixError&) {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+        {
+          failed = true;
+          failedRow = r;
+        }
+        continue;
+      }
+
+      // MI_ij = (N^-1 R)_j^T
+      size_type a=0;
+      coliterator endj=MI[i].end();
+      for (coliterator j=MI[i].begin(); j!=endj; ++j, ++a)
+        for (int s=0; s<n; ++s)
+          for (int t=0; t<n; ++t)
+          {
+            K sum = 0;
+            for (size_type k=0; k<p*n; ++k)
+              sum += N[a*n+t][k]*R[k][s];
+            (*j)[s][t] = sum;
+          }
+    }
+    if (failed)
+      DUNE_THROW(ISTLError,"SPAI failed in row " << failedRow
+                 << ", the local least squares problem is singular");
+  }
+
+  /** @} end documentation */
+
+} // end namespace
+
+#endif
@@ -0,0 +1,181 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+#include "config.h"
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+
+#include <dune/istl/bcrsmatrix.hh>
+#include <dune/istl/bvector.hh>
+#include <dune/istl/binaryio.hh>
+#include "laplacian.hh"
+
+/*  Stores a block Laplacian and a vector in the binary format, loads them
+ *  again and compares the matrix-vector products with the original and the
+ *  loaded and the memory mapped matrix.
+ */
+template<int BS>
+int testBinaryIO(int N)
+{
+  typedef Dune::FieldMatrix<double,BS,BS> MatrixBlock;
+  typedef Dune::BCRSMatrix<MatrixBlock> BCRSMat;
+  typedef Dune::FieldVector<double,BS> VectorBlock;
+  typedef Dune::BlockVector<VectorBlock> BVector;
+
+  BCRSMat mat;
+  setupLaplacian(mat, N);
+  // make the blocks unsymmetric
+  mat[0][0][0][BS-1] += 1.0;
+
+  BVector bv(mat.N());
+  for(std::size_t i=0; i<bv.N(); ++i)
+    for(int k=0; k<BS; ++k)
+      bv[i][k] = i*BS+k;
+
+  Dune::storeBinary(mat, "testmat.bin");
+  Dune::storeBinary(bv, "testvec.bin");
+
+  BCRSMat mat1;
+  BVector bv1;
+  Dune::loadBinary(mat1, "testmat.bin");
+  Dune::loadBinary(bv1, "testvec.bin");
+
+  int ret=0;
+  if(mat.N()!=mat1.N() || mat.M()!=mat1.M() || mat.nonzeroes()!=mat1.nonzeroes())
+  {
+    std::cerr<<"matrix sizes do not match"<<std::endl;
+    return 1;
+  }
+
+  typedef typename BCRSMat::ConstRowIterator RowIterator;
+  typedef typename BCRSMat::ConstColIterator ColIterator;
+  for(RowIterator row=mat.begin(), row1=mat1.begin(); row!=mat.end(); ++row, ++row1)
+    for(ColIterator col=row->begin(), col1=row1->begin(); col!=row->end(); ++col, ++col1)
+    {
+      if(col.index()!=col1.index()) {
+        std::cerr<<"Column indices do not match"<<std::endl;
+        ++ret;
+      }
+      MatrixBlock diff(*col);
+      diff -= *col1;
+      if(diff.frobenius_norm()!=0) {
+        std::cerr<<"Matrix entries do not match"<<std::endl;
+        ++ret;
+      }
+    }
+
+  bv1 -= bv;
+  if(bv1.two_norm()!=0) {
+    std::cerr<<"written and read vector do not match"<<std::endl;
+    ++ret;
+  }
+
+  BVector cv(mat.N()), cv1(mat.N());
+  cv = 0;
+  cv1 = 0;
+  mat.umv(bv, cv);
+  Dune::MappedBinaryMatrix<BCRSMat> mapped("testmat.bin");
+  mapped.umv(bv, cv1);
+  cv1 -= cv;
+  if(cv1.two_norm()!=0) {
+    std::cerr<<"product with the mapped matrix does not match"<<std::endl;
+    ++ret;
+  }
+
+  try {
+    Dune::loadBinary(mat1, "testvec.bin");
+    std::cerr<<"loading a vector as a matrix did not fail"<<std::endl;
+    ++ret;
+  }
+  catch(Dune::BinaryFormatError&) {}
+
+  return ret;
+}
+
+//! Write the given bytes to a file.
+void writeFile(const std::string& filename, const std::string& bytes)
+{
+  std::ofstream file(filename.c_str(), std::ios::out | std::ios::binary);
+  file.write(bytes.data(), bytes.size());
+}
+
+//! Check that loading a corrupt matrix file fails.
+template<class Matrix>
+int expectFormatError(const std::string& bytes, const char* what)
+{
+  writeFile("testcorrupt.bin", bytes);
+  try {
+    Matrix mat;
+    Dune::loadBinary(mat, "testcorrupt.bin");
+    std::cerr<<"loading a matrix with "<<what<<" did not fail"<<std::endl;
+    return 1;
+  }
+  catch(Dune::BinaryFormatError&) {}
+  return 0;
+}
+
+/*  Damages a stored matrix in several ways and checks that loading it
+ *  fails instead of reading past the end of the file.
+ */
+int testCorruptFiles(int N)
+{
+  typedef Dune::BCRSMatrix<Dune::FieldMatrix<double,1,1> > BCRSMat;
+  BCRSMat mat;
+  setupLaplacian(mat, N);
+  Dune::storeBinary(mat, "testmat.bin");
+
+  std::ifstream file("testmat.bin", std::ios::in | std::ios::binary);
+  const std::string bytes((std::istreambuf_iterator<char>(file)),
+                          std::istreambuf_iterator<char>());
+  Dune::BinaryHeader header;
+  std::memcpy(&header, bytes.data(), sizeof(header));
+  const std::size_t rowPointers = sizeof(Dune::BinaryHeader);
+  const std::size_t columnIndices = rowPointers+(header.rows+1)*sizeof(uint64_t);
+
+  int ret=0;
+  ret += expectFormatError<BCRSMat>(bytes.substr(0, bytes.size()/2), "truncated values");
+  ret += expectFormatError<BCRSMat>(bytes.substr(0, columnIndices), "truncated indices");
+
+  Dune::BinaryHeader bad = header;
+  bad.rows = header.valueOffset;
+  std::string corrupt = bytes;
+  std::memcpy(&corrupt[0], &bad, sizeof(bad));
+  ret += expectFormatError<BCRSMat>(corrupt, "too many rows");
+
+  bad = header;
+  bad.nonzeroes = header.valueOffset/sizeof(uint64_t);
+  corrupt = bytes;
+  std::memcpy(&corrupt[0], &bad, sizeof(bad));
+  ret += expectFormatError<BCRSMat>(corrupt, "too many nonzeroes");
+
+  const uint64_t large = header.nonzeroes+1;
+  corrupt = bytes;
+  std::memcpy(&corrupt[rowPointers+sizeof(uint64_t)], &large, sizeof(uint64_t));
+  ret += expectFormatError<BCRSMat>(corrupt, "decreasing row pointers");
+
+  const uint64_t column = header.cols;
+  corrupt = bytes;
+  std::memcpy(&corrupt[columnIndices], &column, sizeof(uint64_t));
+  ret += expectFormatError<BCRSMat>(corrupt, "a column index out of range");
+
+  return ret;
+}
+
+int main(int argc, char** argv)
+{
+  int N=20;
+  if(argc>1)
+    N = atoi(argv[1]);
+
+  int ret=0;
+  ret += testBinaryIO<1>(N);
+  ret += testBinaryIO<2>(N);
+  ret += testCorruptFiles(N);
+  return ret;
+}
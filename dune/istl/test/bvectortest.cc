@@ -6,6 +6,10 @@
 #include <dune/common/poolallocator.hh>
 #include <dune/common/debugallocator.hh>
 
+#include <cmath>
+#include <iostream>
+#include <vector>
+
 template<typename T, int BS>
 void assign(Dune::FieldVector<T,BS>& b, const T& i)
 {
@@ -120,6 +124,86 @@ void testCapacity()
   vec1.reserve(0, false);
 }
 
+int testFusedUpdates()
+{
+  typedef Dune::FieldVector<double,2> VectorBlock;
+  typedef Dune::BlockVector<VectorBlock> Vector;
+
+  // long enough for several chunks of the fused kernels
+  Vector x(1000), y(1000), z(1000);
+  for(Vector::size_type i=0; i < x.N(); ++i)
+    for(int j=0; j < 2; ++j) {
+      x[i][j] = std::sin(1.0*i+j);
+      y[i][j] = std::cos(2.0*i-j);
+      z[i][j] = 1.0/(i+j+1);
+    }
+
+  int ret = 0;
+
+  // y = 3y + 2x - z
+  std::vector<double> a(2);
+  a[0] = 2.0; a[1] = -1.0;
+  std::vector<const Vector*> v(2);
+  v[0] = &x; v[1] = &z;
+  Vector fused(y), reference(y);
+  Dune::fusedAxpby(fused,3.0,a,v);
+  reference *= 3.0;
+  reference.axpy(2.0,x);
+  reference.axpy(-1.0,z);
+  reference -= fused;
+  if (reference.two_norm() > 1e-12) {
+    std::cerr << "fusedAxpby differs from axpy" << std::endl;
+    ret++;
+  }
+
+  // y = y - 0.5 x and its squared norm
+  fused = y;
+  reference = y;
+  double norm2 = Dune::fusedAxpyNorm2(fused,-0.5,x);
+  reference.axpy(-0.5,x);
+  if (std::abs(norm2-reference.two_norm2()) > 1e-12*norm2) {
+    std::cerr << "fusedAxpyNorm2 computes the wrong norm" << std::endl;
+    ret++;
+  }
+  reference -= fused;
+  if (reference.two_norm() > 1e-12) {
+    std::cerr << "fusedAxpyNorm2 differs from axpy" << std::endl;
+    ret++;
+  }
+
+  return ret;
+}
+
+int testConvertVector()
+{
+  typedef Dune::FieldVector<double,2> VectorBlock;
+  typedef Dune::BlockVector<VectorBlock> Vector;
+
+  Vector x(1000);
+  for(Vector::size_type i=0; i < x.N(); ++i)
+    for(int j=0; j < 2; ++j)
+      x[i][j] = std::sin(1.0*i+j);
+
+  int ret = 0;
+
+  // conversion to single precision and back
+  Dune::BlockVector<Dune::FieldVector<float,2> > xf;
+  Dune::convertVector(xf,x);
+  Vector xd;
+  Dune::convertVector(xd,xf);
+  if (xf.N() != x.N() || xd.N() != x.N()) {
+    std::cerr << "convertVector does not resize" << std::endl;
+    ret++;
+  }
+  xd -= x;
+  if (xd.infinity_norm() > 1e-6) {
+    std::cerr << "convertVector changes the entries" << std::endl;
+    ret++;
+  }
+
+  return ret;
+}
+
 int main()
 {
   typedef std::complex<double> value_type;
@@ -145,5 +229,9 @@ int main()
 
   testCapacity();
 
+  ret += testFusedUpdates();
+
+  ret += testConvertVector();
+
   return ret;
 }
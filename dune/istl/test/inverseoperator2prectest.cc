@@ -57,5 +57,29 @@ int main(int argc, char** argv)
     std::cerr<<"Convergence rates do not match!"<<std::endl;
     return 1;
   }
+
+  // a loosely converged inner CG solve changes with the right hand side,
+  // which requires a flexible outer Krylov method
+  x=1;
+  mat.mv(x, b);
+  x=0;
+  std::cout<<"solver2"<<std::endl;
+  Dune::CGSolver<BVector> solver3(fop, prec0, 1e-1,5,0);
+  Dune::InverseOperator2Preconditioner<Dune::CGSolver<BVector>,category >
+    prec3(solver3);
+  Dune::RestartedFlexibleGMResSolver<BVector> solver2(fop, prec3, 1e-8,20,500,2);
+  Dune::InverseOperatorResult res2;
+  solver2.apply(x,b,res2);
+
+  BVector xe(N*N), b0(N*N), r(N*N);
+  xe=1;
+  mat.mv(xe, b0);
+  r=b0;
+  mat.mmv(x, r);
+  if(!res2.converged || r.two_norm()>1e-6*b0.two_norm())
+  {
+    std::cerr<<"Flexible GMRes did not converge!"<<std::endl;
+    return 1;
+  }
   return 0;
 }
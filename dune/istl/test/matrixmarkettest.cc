@@ -2,7 +2,9 @@
 // vi: set et ts=4 sw=2 sts=2:
 #include "config.h"
 
+#include <complex>
 #include <iterator>
+#include <sstream>
 
 #include <dune/common/fmatrix.hh>
 #include <dune/common/fvector.hh>
@@ -16,6 +18,7 @@
 #include <dune/istl/paamg/test/anisotropic.hh>
 #include "mpi.h"
 #include <dune/istl/schwarz.hh>
+#include <dune/istl/binaryio.hh>
 #else
 #include <dune/istl/operators.hh>
 #include "laplacian.hh"
@@ -147,9 +150,82 @@ int main(int argc, char** argv)
       ++ret;
     }
 
+#if HAVE_MPI
+  // the binary format repartitions on load, compare the global norms
+  storeBinary(mat, std::string("testmat"), comm);
+  storeBinary(bv, std::string("testvec"), comm);
+
+  BCRSMat mat2;
+  BVector bv2;
+  Communication comm2(MPI_COMM_WORLD);
+  loadBinary(mat2, std::string("testmat"), comm2);
+  loadBinary(bv2, std::string("testvec"), comm2);
+
+  BVector cv2(mat2.N());
+  Dune::OverlappingSchwarzOperator<BCRSMat,BVector,BVector,Communication> op2(mat2, comm2);
+  op2.apply(bv2, cv2);
+  if(!Dune::FloatCmp::eq(comm.norm(bv), comm2.norm(bv2))
+     || !Dune::FloatCmp::eq(comm.norm(cv), comm2.norm(cv2)))
+  {
+    std::cerr<<"vectors stored and loaded in the binary format do not match"<<std::endl;
+    ++ret;
+  }
+#endif
+
+  // only the lower triangle of a symmetric matrix is stored
+  std::istringstream symmetric("%%MatrixMarket matrix coordinate real symmetric\n"
+                               "3 3 4\n1 1 2\n2 1 -1\n2 2 2\n3 2 -1\n");
+  BCRSMat smat;
+  Dune::readMatrixMarket(smat, symmetric);
+  if(smat.N()!=3 || smat.nonzeroes()!=6 || smat[0][1][0][0]!=-1.0
+     || smat[1][0][0][0]!=-1.0 || smat[1][2][0][0]!=-1.0 || smat[2][1][0][0]!=-1.0)
+  {
+    std::cerr<<"symmetric matrix was not read correctly"<<std::endl;
+    ++ret;
+  }
+
+  // the mirrored entries of a skew symmetric matrix change their sign
+  std::istringstream skew("%%MatrixMarket matrix coordinate real skew-symmetric\n"
+                          "3 3 2\n2 1 1\n3 2 -2\n");
+  BCRSMat kmat;
+  Dune::readMatrixMarket(kmat, skew);
+  if(kmat.N()!=3 || kmat.nonzeroes()!=4 || kmat[1][0][0][0]!=1.0
+     || kmat[0][1][0][0]!=-1.0 || kmat[2][1][0][0]!=-2.0 || kmat[1][2][0][0]!=2.0)
+  {
+    std::cerr<<"skew symmetric matrix was not read correctly"<<std::endl;
+    ++ret;
+  }
+
+  // and those of a hermitian matrix are conjugated
+  typedef Dune::BCRSMatrix<Dune::FieldMatrix<std::complex<double>,1,1> > ComplexMat;
+  std::istringstream hermitian("%%MatrixMarket matrix coordinate complex hermitian\n"
+                               "2 2 3\n1 1 2 0\n2 1 1 -3\n2 2 4 0\n");
+  ComplexMat hmat;
+  Dune::readMatrixMarket(hmat, hermitian);
+  if(hmat.N()!=2 || hmat.nonzeroes()!=4 || hmat[0][0][0][0]!=std::complex<double>(2,0)
+     || hmat[1][0][0][0]!=std::complex<double>(1,-3) || hmat[0][1][0][0]!=std::complex<double>(1,3)
+     || hmat[1][1][0][0]!=std::complex<double>(4,0))
+  {
+    std::cerr<<"hermitian matrix was not read correctly"<<std::endl;
+    ++ret;
+  }
+
+  // a missing value must not be taken from the next line, which would
+  // be lost then and leave the right number of entries
+  std::istringstream malformed("%%MatrixMarket matrix coordinate real general\n"
+                               "2 2 2\n1 2\n2 1 5.0\n1 1 3.0\n");
+  try {
+    BCRSMat mmat;
+    Dune::readMatrixMarket(mmat, malformed);
+    std::cerr<<"an entry without a value was accepted"<<std::endl;
+    ++ret;
+  }
+  catch(Dune::MatrixMarketFormatError&) {}
+
 #if HAVE_MPI
   if(ret!=0)
     MPI_Abort(MPI_COMM_WORLD, ret);
   MPI_Finalize();
 #endif
+  return ret;
 }
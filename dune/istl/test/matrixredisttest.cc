@@ -110,6 +110,30 @@ int testRepart(int N, int coarsenTarget)
     }
   }
 
+  // Redistribute changed values with the same sparsity pattern
+  BCRSMat oldMat(newMat);
+  double scale=1.0;
+  for(int k=0; k<2; ++k) {
+    mat *= 2.0;
+    scale *= 2.0;
+    redistributeMatrixValues(mat, newMat, comm, *coarseComm, ri);
+    typedef typename Communication::ParallelIndexSet::const_iterator IndexIter;
+    for(IndexIter i=coarseComm->indexSet().begin(); i!=coarseComm->indexSet().end(); ++i)
+      if(i->local().attribute()==Dune::OwnerOverlapCopyAttributeSet::owner) {
+        typedef typename BCRSMat::ConstColIterator CIter;
+        const std::size_t r=i->local();
+        for(CIter col=newMat[r].begin(), cend=newMat[r].end(); col!=cend; ++col) {
+          MatrixBlock diff(*col);
+          diff.axpy(-scale, oldMat[r][col.index()]);
+          if(diff.frobenius_norm()>1e-12) {
+            std::cerr<<coarseComm->communicator().rank()<<": value ("
+                     <<r<<","<<col.index()<<") not redistributed!"<<std::endl;
+            ret=1;
+          }
+        }
+      }
+  }
+
   //if(coarseComm->communicator().rank()==0)
   //Dune::printmatrix(std::cout, newMat, "redist", "row");
   delete coarseComm;
@@ -139,6 +163,7 @@ int main(int argc, char** argv)
     return 1;
   }
 
-  testRepart<1>(N,coarsenTarget);
+  int ret=testRepart<1>(N,coarsenTarget);
   MPI_Finalize();
+  return ret;
 }
@@ -0,0 +1,170 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+#include "config.h"
+
+#include <cmath>
+#include <iostream>
+#include <mpi.h>
+
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+#include <dune/common/parallel/plocalindex.hh>
+#include <dune/istl/bcrsmatrix.hh>
+#include <dune/istl/bvector.hh>
+#include <dune/istl/owneroverlapcopy.hh>
+#include <dune/istl/novlpschwarz.hh>
+
+typedef Dune::OwnerOverlapCopyAttributeSet GridAttributes;
+typedef Dune::ParallelLocalIndex<GridAttributes::AttributeSet> LocalIndex;
+
+/**
+ * @brief Set up the local part of a nonoverlapping 2d Laplacian.
+ *
+ * The N x N grid is split into vertical strips, neighbouring strips
+ * share one column of vertices which is owned by the left process. The
+ * matrix is assembled edge by edge, every edge belongs to exactly one
+ * process, the edges in a shared column to its owner.
+ */
+template<class M, class C>
+void setupNonoverlappingLaplacian(int N, M& mat, C& comm)
+{
+  const int rank = comm.communicator().rank();
+  const int procs = comm.communicator().size();
+  const int start = rank*(N-1)/procs;
+  const int end = (rank+1)*(N-1)/procs+1;
+  const int n = end-start;
+
+  comm.indexSet().beginResize();
+  for(int j=0; j<N; ++j)
+    for(int i=start; i<end; ++i) {
+      const int local = j*n+i-start;
+      const bool copy = i==start && rank>0;
+      const bool border = (i==start && rank>0) || (i==end-1 && rank<procs-1);
+      comm.indexSet().add(j*N+i, LocalIndex(local, copy ? GridAttributes::copy : GridAttributes::owner, border));
+    }
+  comm.indexSet().endResize();
+  comm.remoteIndices().template rebuild<false>();
+
+  mat.setSize(N*n, N*n, 5*N*n);
+  mat.setBuildMode(M::row_wise);
+  for(typename M::CreateIterator row=mat.createbegin(); row!=mat.createend(); ++row) {
+    const int i = row.index()%n, j = row.index()/n;
+    row.insert(row.index());
+    if(i>0)
+      row.insert(row.index()-1);
+    if(i<n-1)
+      row.insert(row.index()+1);
+    if(j>0 && !(i==0 && rank>0))
+      row.insert(row.index()-n);
+    if(j<N-1 && !(i==0 && rank>0))
+      row.insert(row.index()+n);
+  }
+  mat = 0;
+
+  typedef typename M::block_type Block;
+  Block unit(0);
+  for(int b=0; b<Block::rows; ++b)
+    unit[b][b] = 1;
+  for(int j=0; j<N; ++j)
+    for(int i=0; i<n; ++i) {
+      const int v = j*n+i;
+      if(!(i==0 && rank>0))
+        // the owner adds a mass term
+        mat[v][v] += unit;
+      if(i<n-1) {
+        mat[v][v] += unit;
+        mat[v+1][v+1] += unit;
+        mat[v][v+1] -= unit;
+        mat[v+1][v] -= unit;
+      }
+      if(j<N-1 && !(i==0 && rank>0)) {
+        mat[v][v] += unit;
+        mat[v+n][v+n] += unit;
+        mat[v][v+n] -= unit;
+        mat[v+n][v] -= unit;
+      }
+    }
+}
+
+//! A vector with the same values for all processes knowing an index.
+template<class V, class C>
+void fillConsistent(V& v, const C& comm, double shift)
+{
+  typedef typename C::PIS::const_iterator Iterator;
+  for(Iterator i=comm.indexSet().begin(); i!=comm.indexSet().end(); ++i)
+    for(int b=0; b<V::block_type::dimension; ++b)
+      v[i->local().local()][b] = std::sin(i->global()+0.5*b+shift);
+}
+
+template<class V, class C>
+double maxDifference(const V& x, const V& y, const C& comm)
+{
+  double diff = 0;
+  for(typename V::size_type i=0; i<x.N(); ++i)
+    for(int b=0; b<V::block_type::dimension; ++b)
+      diff = std::max(diff, std::abs(x[i][b]-y[i][b]));
+  return comm.communicator().max(diff);
+}
+
+template<int BS>
+int testNonoverlappingOperator(int N)
+{
+  typedef Dune::FieldMatrix<double,BS,BS> MatrixBlock;
+  typedef Dune::BCRSMatrix<MatrixBlock> BCRSMat;
+  typedef Dune::FieldVector<double,BS> VectorBlock;
+  typedef Dune::BlockVector<VectorBlock> Vector;
+  typedef Dune::OwnerOverlapCopyCommunication<int> Communication;
+  typedef Dune::NonoverlappingSchwarzOperator<BCRSMat,Vector,Vector,Communication> Operator;
+
+  Communication comm(MPI_COMM_WORLD, Dune::SolverCategory::nonoverlapping);
+  BCRSMat mat;
+  setupNonoverlappingLaplacian(N, mat, comm);
+  Operator op(mat, comm);
+
+  Vector x(mat.N()), y(mat.N()), reference(mat.N());
+  fillConsistent(x, comm, 0.0);
+
+  int ret = 0;
+  // apply twice to also use the cached setup and communication buffers
+  for(int k=0; k<2; ++k) {
+    reference = 0;
+    op.novlp_op_apply(x, reference, 1.0);
+    comm.addOwnerCopyToOwnerCopy(reference, reference);
+    op.apply(x, y);
+    double diff = maxDifference(y, reference, comm);
+    if(comm.communicator().rank()==0)
+      std::cout<<"BS="<<BS<<" N="<<N<<" apply difference "<<diff<<std::endl;
+    if(diff>1e-12)
+      ret = 1;
+
+    const double alpha = -0.5;
+    fillConsistent(y, comm, 1.0);
+    reference = 0;
+    op.novlp_op_apply(x, reference, alpha);
+    comm.addOwnerCopyToOwnerCopy(reference, reference);
+    reference += y;
+    op.applyscaleadd(alpha, x, y);
+    diff = maxDifference(y, reference, comm);
+    if(comm.communicator().rank()==0)
+      std::cout<<"BS="<<BS<<" N="<<N<<" applyscaleadd difference "<<diff<<std::endl;
+    if(diff>1e-12)
+      ret = 1;
+  }
+  return ret;
+}
+
+int main(int argc, char** argv)
+{
+  MPI_Init(&argc, &argv);
+  int procs;
+  MPI_Comm_size(MPI_COMM_WORLD, &procs);
+
+  int N=4*procs;
+  if(argc>1)
+    N = atoi(argv[1]);
+
+  int ret = testNonoverlappingOperator<1>(N);
+  ret += testNonoverlappingOperator<2>(N);
+  MPI_Finalize();
+  return ret;
+}
@@ -0,0 +1,285 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+#include "config.h"
+
+#include <cmath>
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+#include <dune/istl/bcrsmatrix.hh>
+#include <dune/istl/bvector.hh>
+#include <dune/istl/gsetc.hh>
+#include <dune/istl/matrixmarket.hh>
+#include <dune/istl/operators.hh>
+#include <dune/istl/overlappingschwarz.hh>
+#include <dune/istl/preconditioners.hh>
+#include <dune/istl/schwarz.hh>
+#include <dune/istl/spai.hh>
+#include "laplacian.hh"
+
+/*
+ * Compares the kernels threaded with OpenMP with their results for a
+ * single thread. Without OpenMP support all comparisons are trivial.
+ */
+
+typedef Dune::FieldMatrix<double,1,1> MatrixBlock;
+typedef Dune::BCRSMatrix<MatrixBlock> BCRSMat;
+typedef Dune::BlockVector<Dune::FieldVector<double,1> > BVector;
+
+//! communication object of a single process for ParSSOR
+struct SequentialCommunication
+{
+  template<class T>
+  void copyOwnerToAll (const T&, T&) const
+  {}
+};
+
+void setThreads (int threads)
+{
+#ifdef _OPENMP
+  omp_set_num_threads(threads);
+#endif
+}
+
+double difference (const BVector& x, const BVector& y)
+{
+  BVector d(x);
+  d -= y;
+  return d.infinity_norm();
+}
+
+double difference (const BCRSMat& A, const BCRSMat& B)
+{
+  double diff = 0;
+  if (A.N()!=B.N() || A.nonzeroes()!=B.nonzeroes())
+    return 1;
+  for (BCRSMat::ConstRowIterator i=A.begin(); i!=A.end(); ++i)
+  {
+    BCRSMat::ConstColIterator jb=B[i.index()].begin();
+    for (BCRSMat::ConstColIterator j=i->begin(); j!=i->end(); ++j, ++jb)
+    {
+      if (j.index()!=jb.index())
+        return 1;
+      diff = std::max(diff, std::abs((*j)[0][0]-(*jb)[0][0]));
+    }
+  }
+  return diff;
+}
+
+int check (const char* name, double diff, double tolerance=0)
+{
+  std::cout<<name<<": difference "<<diff<<std::endl;
+  if (diff>tolerance) {
+    std::cerr<<name<<" differs from the result of one thread"<<std::endl;
+    return 1;
+  }
+  return 0;
+}
+
+int testUsmv (const BCRSMat& A, int threads)
+{
+  BVector x(A.M()), y1(A.N()), y2(A.N());
+  for (std::size_t i=0; i<x.N(); ++i)
+    x[i] = std::sin(i);
+  y1 = 1;
+  y2 = 1;
+  setThreads(1);
+  Dune::threadedUsmv(A,-0.5,x,y1);
+  setThreads(threads);
+  Dune::threadedUsmv(A,-0.5,x,y2);
+  return check("threadedUsmv", difference(y1,y2));
+}
+
+int testParSSOR (const BCRSMat& A, int threads)
+{
+  SequentialCommunication comm;
+  BVector d(A.N()), v1(A.N()), v2(A.N()), v3(A.N());
+  for (std::size_t i=0; i<d.N(); ++i)
+    d[i] = std::cos(i);
+
+  // the default sweeps do not depend on the number of threads
+  v1 = 0;
+  Dune::bsorf(A,v1,d,1.2);
+  Dune::bsorb(A,v1,d,1.2);
+  setThreads(threads);
+  Dune::ParSSOR<BCRSMat,BVector,BVector,SequentialCommunication> ssor(A,1,1.2,comm);
+  v2 = 0;
+  ssor.apply(v2,d);
+  int ret = check("ParSSOR", difference(v1,v2));
+
+  // the hybrid sweeps are SSOR for one thread
+  Dune::ParSSOR<BCRSMat,BVector,BVector,SequentialCommunication> hybrid(A,1,1.2,comm,true);
+  setThreads(1);
+  v2 = 0;
+  hybrid.apply(v2,d);
+  ret += check("ParSSOR hybrid, one thread", difference(v1,v2));
+
+  // and still reduce the defect for several threads
+  setThreads(threads);
+  BVector x(A.N()), r(A.N()), b(A.N());
+  b = 0;
+  x = 1;
+  r = b;
+  A.mmv(x,r);
+  const double defect0 = r.two_norm();
+  for (int k=0; k<10; ++k) {
+    v3 = 0;
+    hybrid.apply(v3,r);
+    x += v3;
+    r = b;
+    A.mmv(x,r);
+  }
+  std::cout<<"ParSSOR hybrid: reduction "<<r.two_norm()/defect0<<std::endl;
+  if (!(r.two_norm()<0.5*defect0)) {
+    std::cerr<<"hybrid ParSSOR does not converge"<<std::endl;
+    ++ret;
+  }
+  return ret;
+}
+
+int testApproximateInverses (const BCRSMat& A, int threads)
+{
+  BCRSMat G1(A.N(),A.M(),BCRSMat::row_wise), G2(A.N(),A.M(),BCRSMat::row_wise);
+  setThreads(1);
+  Dune::fsai_decomposition(A,2,G1);
+  setThreads(threads);
+  Dune::fsai_decomposition(A,2,G2);
+  int ret = check("FSAI", difference(G1,G2));
+
+  BCRSMat M1(A.N(),A.M(),BCRSMat::row_wise), M2(A.N(),A.M(),BCRSMat::row_wise);
+  setThreads(1);
+  Dune::spai_decomposition(A,2,M1);
+  setThreads(threads);
+  Dune::spai_decomposition(A,2,M2);
+  ret += check("SPAI", difference(M1,M2));
+  return ret;
+}
+
+//! apply a sequential preconditioner wrapped into a BlockPreconditioner
+template<class Prec>
+void applyBlockPreconditioner (Prec& prec, const BVector& d, BVector& v)
+{
+  SequentialCommunication comm;
+  Dune::BlockPreconditioner<BVector,BVector,SequentialCommunication,Prec> block(prec,comm);
+  v = 0;
+  block.apply(v,d);
+}
+
+int testBlockPreconditioner (const BCRSMat& A, int threads)
+{
+  BVector d(A.N()), v1(A.N()), v2(A.N()), t(A.N()), reference(A.N());
+  for (std::size_t i=0; i<d.N(); ++i)
+    d[i] = std::cos(i);
+
+  setThreads(1);
+  Dune::SeqFSAI<BCRSMat,BVector,BVector> fsai1(A,2,0.8);
+  applyBlockPreconditioner(fsai1,d,v1);
+  setThreads(threads);
+  Dune::SeqFSAI<BCRSMat,BVector,BVector> fsai2(A,2,0.8);
+  applyBlockPreconditioner(fsai2,d,v2);
+  int ret = check("BlockPreconditioner with FSAI", difference(v1,v2));
+
+  // the stored transpose gives the same as the transposed product
+  BCRSMat G(A.N(),A.M(),BCRSMat::row_wise);
+  Dune::fsai_decomposition(A,2,G);
+  G.mv(d,t);
+  G.mtv(t,reference);
+  reference *= 0.8;
+  if (difference(reference,v2)>1e-12) {
+    std::cerr<<"FSAI does not apply the transposed factor"<<std::endl;
+    ++ret;
+  }
+
+  setThreads(1);
+  Dune::SeqSPAI<BCRSMat,BVector,BVector> spai1(A,2,0.8);
+  applyBlockPreconditioner(spai1,d,v1);
+  setThreads(threads);
+  Dune::SeqSPAI<BCRSMat,BVector,BVector> spai2(A,2,0.8);
+  applyBlockPreconditioner(spai2,d,v2);
+  ret += check("BlockPreconditioner with SPAI", difference(v1,v2));
+
+  setThreads(1);
+  Dune::SeqChebyshev<BCRSMat,BVector,BVector> chebyshev1(A,3,1.0);
+  applyBlockPreconditioner(chebyshev1,d,v1);
+  setThreads(threads);
+  Dune::SeqChebyshev<BCRSMat,BVector,BVector> chebyshev2(A,3,1.0);
+  applyBlockPreconditioner(chebyshev2,d,v2);
+  ret += check("BlockPreconditioner with Chebyshev", difference(v1,v2));
+  return ret;
+}
+
+int testMatrixMarket (const BCRSMat& A, int threads)
+{
+  std::ostringstream os;
+  os.precision(17);
+  Dune::writeMatrixMarket(A,os);
+  BCRSMat B;
+  setThreads(threads);
+  std::istringstream is(os.str());
+  Dune::readMatrixMarket(B,is);
+  return check("readMatrixMarket", difference(A,B));
+}
+
+template<class Mode>
+int testOverlappingSchwarz (const BCRSMat& A, int N, int threads, const char* name)
+{
+  typedef Dune::DynamicMatrixSubdomainSolver<BCRSMat,BVector,BVector> Solver;
+  typedef Dune::SeqOverlappingSchwarz<BCRSMat,BVector,Mode,Solver> Schwarz;
+
+  // 4x4 blocks of unknowns with an overlap of one
+  const int size=4, domainsPerDim=(N+size-1)/size;
+  typename Schwarz::subdomain_vector domains(domainsPerDim*domainsPerDim);
+  for (int j=0; j<N; ++j)
+    for (int i=0; i<N; ++i)
+      for (int dj=0; dj<domainsPerDim; ++dj)
+        for (int di=0; di<domainsPerDim; ++di)
+          if (i>=di*size-1 && i<(di+1)*size+1 && j>=dj*size-1 && j<(dj+1)*size+1)
+            domains[dj*domainsPerDim+di].insert(j*N+i);
+
+  BVector d(A.N()), v1(A.N()), v2(A.N());
+  for (std::size_t i=0; i<d.N(); ++i)
+    d[i] = std::cos(i);
+  setThreads(1);
+  Schwarz prec1(A,domains,1.0);
+  v1 = 0;
+  prec1.apply(v1,d);
+  setThreads(threads);
+  Schwarz prec2(A,domains,1.0);
+  v2 = 0;
+  prec2.apply(v2,d);
+  return check(name, difference(v1,v2), 1e-12);
+}
+
+int main(int argc, char** argv)
+{
+  int N=20, threads=4;
+  if (argc>1)
+    N = atoi(argv[1]);
+  if (argc>2)
+    threads = atoi(argv[2]);
+#ifdef _OPENMP
+  std::cout<<"testing for N="<<N<<" with "<<threads<<" threads"<<std::endl;
+#else
+  std::cout<<"testing for N="<<N<<" without OpenMP"<<std::endl;
+#endif
+
+  BCRSMat A;
+  setupLaplacian(A,N);
+
+  int ret = testUsmv(A,threads);
+  ret += testParSSOR(A,threads);
+  ret += testApproximateInverses(A,threads);
+  ret += testBlockPreconditioner(A,threads);
+  ret += testMatrixMarket(A,threads);
+  ret += testOverlappingSchwarz<Dune::AdditiveSchwarzMode>(A,N,threads,"additive Schwarz");
+  ret += testOverlappingSchwarz<Dune::ColoredMultiplicativeSchwarzMode>(A,N,threads,"colored multiplicative Schwarz");
+  return ret;
+}
@@ -196,6 +196,14 @@ int main(int argc, char** argv)
   Dune::LoopSolver<BVector> solver1m(fop, prec1m, 1e-2,100,2);
   solver1m.apply(x,b, res);
 
+  std::cout << "Colored multiplicative Schwarz (domains vector)"<<std::endl;
+
+  b=0;
+  x=100;
+  Dune::SeqOverlappingSchwarz<BCRSMat,BVector,Dune::ColoredMultiplicativeSchwarzMode> prec1c(mat, domains, 1);
+  Dune::LoopSolver<BVector> solver1c(fop, prec1c, 1e-2,100,2);
+  solver1c.apply(x,b, res);
+
   std::cout<<"Additive Schwarz (rowToDomain vector)"<<std::endl;
 
   b=0;
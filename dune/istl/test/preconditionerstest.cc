@@ -0,0 +1,100 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+#include "config.h"
+#include <dune/istl/bvector.hh>
+#include <dune/istl/operators.hh>
+#include <dune/istl/preconditioners.hh>
+#include <dune/istl/solvers.hh>
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+#include "laplacian.hh"
+
+typedef Dune::FieldMatrix<double,1,1> MatrixBlock;
+typedef Dune::BCRSMatrix<MatrixBlock> BCRSMat;
+typedef Dune::FieldVector<double,1> VectorBlock;
+typedef Dune::BlockVector<VectorBlock> BVector;
+typedef Dune::MatrixAdapter<BCRSMat,BVector,BVector> Operator;
+
+template<class P>
+int testPreconditioner(const char* name, const BCRSMat& mat, P& prec)
+{
+  Operator fop(mat);
+  BVector b(mat.N()), x(mat.N());
+  x=1;
+  mat.mv(x, b);
+  x=0;
+
+  Dune::InverseOperatorResult res;
+  Dune::CGSolver<BVector> solver(fop, prec, 1e-8, 500, 1);
+  solver.apply(x, b, res);
+
+  if(!res.converged) {
+    std::cerr<<name<<": CG did not converge!"<<std::endl;
+    return 1;
+  }
+  x-=1;
+  if(x.infinity_norm()>1e-5) {
+    std::cerr<<name<<": wrong solution, error "<<x.infinity_norm()<<std::endl;
+    return 1;
+  }
+  return 0;
+}
+
+int main(int argc, char** argv)
+{
+  int N=40;
+
+  if(argc>1)
+    N = atoi(argv[1]);
+  std::cout<<"testing for N="<<N<<" BS="<<1<<std::endl;
+
+  BCRSMat mat;
+  setupLaplacian(mat,N);
+
+  int ret=0;
+
+  Dune::SeqChebyshev<BCRSMat,BVector,BVector> cheb(mat, 3, 1.0);
+  // the spectrum of the Jacobi preconditioned Laplacian is contained in (0,2)
+  if(cheb.maxEigenvalue()<1.5 || cheb.maxEigenvalue()>2.5) {
+    std::cerr<<"SeqChebyshev: bad eigenvalue estimate "<<cheb.maxEigenvalue()<<std::endl;
+    ret=1;
+  }
+  ret += testPreconditioner("SeqChebyshev", mat, cheb);
+
+  Dune::SeqIC0<BCRSMat,BVector,BVector> ic0(mat, 1.0);
+  ret += testPreconditioner("SeqIC0", mat, ic0);
+
+  // IC(0) and ILU(0) coincide for symmetric matrices
+  Dune::SeqILU0<BCRSMat,BVector,BVector> ilu0(mat, 1.0);
+  BVector d(mat.N()), v0(mat.N()), v1(mat.N());
+  for(BVector::size_type i=0; i<d.size(); ++i)
+    d[i] = static_cast<double>(i%7);
+  v0=0;
+  v1=0;
+  ic0.apply(v0, d);
+  ilu0.apply(v1, d);
+  v0-=v1;
+  if(v0.infinity_norm()>1e-10) {
+    std::cerr<<"SeqIC0 differs from SeqILU0 by "<<v0.infinity_norm()<<std::endl;
+    ret=1;
+  }
+
+  Dune::SeqFSAI<BCRSMat,BVector,BVector> fsai(mat, 2, 1.0);
+  ret += testPreconditioner("SeqFSAI", mat, fsai);
+
+  Dune::SeqSPAI<BCRSMat,BVector,BVector> spai(mat, 1, 1.0);
+  Operator fop(mat);
+  BVector x(mat.N()), b(mat.N());
+  x=1;
+  mat.mv(x, b);
+  x=0;
+  Dune::InverseOperatorResult res;
+  Dune::BiCGSTABSolver<BVector> bicgstab(fop, spai, 1e-8, 500, 1);
+  bicgstab.apply(x, b, res);
+  if(!res.converged) {
+    std::cerr<<"SeqSPAI: BiCGSTAB did not converge!"<<std::endl;
+    ret=1;
+  }
+
+  return ret;
+}
@@ -13,6 +13,29 @@
 
 #include <iterator>
 
+//! observer that stops the solver after a fixed number of iterations
+class IterationLimit : public Dune::SolverObserver
+{
+public:
+  explicit IterationLimit (int limit) : calls(0), _limit(limit) {}
+
+  virtual bool iteration (const Dune::IterationStatistics& stats)
+  {
+    std::cout << "observed iteration " << stats.iteration
+              << " defect " << stats.defect
+              << " reduction " << stats.reduction
+              << " T_op " << stats.times.operatorTime
+              << " T_prec " << stats.times.preconditionerTime
+              << " T_sp " << stats.times.scalarProductTime << std::endl;
+    return ++calls < _limit;
+  }
+
+  int calls;
+
+private:
+  int _limit;
+};
+
 int main(int argc, char** argv)
 {
 
@@ -62,6 +85,75 @@ int main(int argc, char** argv)
   mat.mv(x, b);
   x=99;
 
+  Dune::PipelinedCGSolver<BVector> solver4(fop, prec0, 1e-3,10,2);
+  solver4.apply(x,b, res);
+
+  b=0;
+  x=1;
+  mat.mv(x, b);
+  x=99;
+
+  Dune::SStepCGSolver<BVector> solver5(fop, prec0, 1e-3,12,2,4);
+  solver5.apply(x,b, res);
+
+  b=0;
+  x=1;
+  mat.mv(x, b);
+  x=99;
+
+  {
+    std::vector<BVector> xs(3,x), bs(3,b);
+    for (int k=0; k<3; ++k)
+    {
+      for (std::size_t i=0; i<x.N(); ++i)
+        x[i] = i%(k+2);
+      mat.mv(x, bs[k]);
+      xs[k]=99;
+    }
+    Dune::BlockCGSolver<BVector> solver11(fop, prec0, 1e-3,10,2);
+    solver11.apply(xs,bs, res);
+  }
+
+  b=0;
+  x=1;
+  mat.mv(x, b);
+  x=99;
+
+  // the second solve reuses the deflation space of the first one
+  Dune::DeflatedCGSolver<BVector> solver12(fop, prec0, 1e-3,10,2,4,8);
+  for (int k=0; k<2; ++k)
+  {
+    b=0;
+    x=1;
+    mat.mv(x, b);
+    x=99;
+    solver12.apply(x,b, res);
+  }
+
+  // a deflation space of k+l vectors is reduced to k Ritz vectors
+  {
+    std::vector<BVector> W(12,x);
+    for (int j=0; j<12; ++j)
+      for (int i=0; i<N*N; ++i)
+        W[j][i] = (i%12==j) ? 1.0 : 0.0;
+    solver12.setDeflationSpace(W);
+    b=0;
+    x=1;
+    mat.mv(x, b);
+    x=99;
+    solver12.apply(x,b, res);
+    if (solver12.deflationSpace().size()>4)
+    {
+      std::cerr << "deflation space was not reduced to 4 vectors" << std::endl;
+      return 1;
+    }
+  }
+
+  b=0;
+  x=1;
+  mat.mv(x, b);
+  x=99;
+
   Dune::BiCGSTABSolver<BVector> solver2(fop, prec0, 1e-3,10,2);
   solver2.apply(x,b, res);
 
@@ -70,8 +162,94 @@ int main(int argc, char** argv)
   mat.mv(x, b);
   x=99;
 
+  Dune::IDRSolver<BVector> solver9(fop, prec0, 1e-3,20,2,4);
+  solver9.apply(x,b, res);
+
+  b=0;
+  x=1;
+  mat.mv(x, b);
+  x=99;
+
+  Dune::BiCGSTABLSolver<BVector> solver10(fop, prec0, 1e-3,10,2,2);
+  solver10.apply(x,b, res);
+
+  b=0;
+  x=1;
+  mat.mv(x, b);
+  x=99;
+
   Dune::RestartedGMResSolver<BVector> solver3(fop, prec0, 1e-3,5,20,2,false);
   solver3.apply(x,b, res);
 
+  b=0;
+  x=1;
+  mat.mv(x, b);
+  x=99;
+
+  Dune::RestartedGMResSolver<BVector> solver7(fop, prec0, 1e-3,5,20,2,
+                                              Dune::GMResOrthogonalization::classicalGramSchmidt2);
+  solver7.apply(x,b, res);
+
+  b=0;
+  x=1;
+  mat.mv(x, b);
+  x=99;
+
+  Dune::RestartedFlexibleGMResSolver<BVector> solver8(fop, prec0, 1e-3,5,20,2);
+  solver8.apply(x,b, res);
+
+  b=0;
+  x=1;
+  mat.mv(x, b);
+  x=99;
+
+  Dune::SStepGMResSolver<BVector> solver6(fop, prec0, 1e-3,5,20,2);
+  solver6.apply(x,b, res);
+
+  // the second solve reuses the recycle space of the first one
+  Dune::GCRODRSolver<BVector> solver13(fop, prec0, 1e-3,10,4,20,2);
+  for (int k=0; k<2; ++k)
+  {
+    b=0;
+    x=1;
+    mat.mv(x, b);
+    x=99;
+    solver13.apply(x,b, res);
+  }
+
+  b=0;
+  x=1;
+  mat.mv(x, b);
+  x=99;
+
+  {
+    // single precision corrections, double precision defects
+    typedef Dune::BCRSMatrix<Dune::FieldMatrix<float,BS,BS> > BCRSMatF;
+    typedef Dune::BlockVector<Dune::FieldVector<float,BS> > BVectorF;
+    BCRSMatF matf;
+    Dune::convertMatrix(matf,mat);
+    Dune::MatrixAdapter<BCRSMatF,BVectorF,BVectorF> fopf(matf);
+    Dune::SeqJac<BCRSMatF,BVectorF,BVectorF> precf(matf, 1,1.0);
+    Dune::CGSolver<BVectorF> inner(fopf, precf, 1e-2,100,0);
+    Dune::IterativeRefinementSolver<BVector,BVectorF> solver14(fop, inner, 1e-8,10,2);
+    solver14.apply(x,b, res);
+  }
+
+  b=0;
+  x=1;
+  mat.mv(x, b);
+  x=99;
+
+  // the observer stops the solver before convergence
+  IterationLimit limit(3);
+  solver1.setObserver(&limit);
+  solver1.apply(x,b, res);
+  solver1.setObserver(0);
+  if (limit.calls != 3 || res.iterations != 3 || res.converged)
+  {
+    std::cerr << "observer did not stop the solver after 3 iterations" << std::endl;
+    return 1;
+  }
+
   return 0;
 }
@@ -13,9 +13,16 @@ AC_DEFUN([DUNE_ISTL_CHECKS],
   AC_REQUIRE([DUNE_BOOST_BASE])
   DUNE_BOOST_BASE(, [ DUNE_BOOST_FUSION ] , [] )
 
+  # OpenMP flags for the threaded kernels, disable with --disable-openmp
+  AC_LANG_PUSH([C++])
+  AC_OPENMP
+  AC_LANG_POP([C++])
+  AM_CONDITIONAL(OPENMP, [test "x$ac_cv_prog_cxx_openmp" != "x" && test "x$ac_cv_prog_cxx_openmp" != "xunsupported"])
+
   # add summary entries for tests not maintained by dune
   DUNE_ADD_SUMMARY_ENTRY([METIS],[$with_metis])
   DUNE_ADD_SUMMARY_ENTRY([BLAS],[$acx_blas_ok])
+  DUNE_ADD_SUMMARY_ENTRY([OpenMP],[$ac_cv_prog_cxx_openmp])
 ])
 
 AC_DEFUN([DUNE_ISTL_CHECK_MODULE],